@@ -0,0 +1,555 @@
+/**********************************************************************************************
+*
+*   raylib-libretro-batch - Run many cores headless in parallel and report how they did.
+*
+*   Each job of the manifest runs a core with its content for a number of frames in a
+*   process of its own, since cores are global-state singletons, and as many jobs run at
+*   once as there are CPUs. The report has the speed, the final frame and SRAM hashes
+*   and the failure of every job.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION
+#include "raylib-libretro-config.h"
+
+#define RAYLIB_LIBRETRO_IMPLEMENTATION
+#include "raylib-libretro.h"
+
+#include <sys/types.h>
+#include <sys/wait.h> // waitpid()
+#include <signal.h>   // kill()
+#include <fcntl.h>    // fcntl()
+#include <poll.h>     // poll()
+#include <unistd.h>   // fork(), pipe(), read(), sysconf(), _exit()
+#include <errno.h>
+
+// Frames a job runs when the manifest doesn't say.
+#define BATCH_DEFAULT_FRAMES 600
+
+// Seconds a job may take before it's killed, unless --timeout says otherwise.
+#define BATCH_DEFAULT_TIMEOUT 300
+
+// Joypad ports an input script can press buttons on.
+#define BATCH_INPUT_PORTS 4
+
+/**
+ * What a job's process sends back through its pipe.
+ */
+typedef struct BatchResult {
+    bool ok;
+    char error[256];
+    char libraryName[200];
+    int frames;             // Frames actually run; fewer when the core asked to shut down.
+    double seconds;         // Time spent running the frames, without loading.
+    unsigned width, height; // Size of the final frame.
+    uint64_t frameHash;
+    uint64_t sramHash;
+    uint64_t sramSize;      // 0 when the core has no SRAM.
+} BatchResult;
+
+typedef struct BatchJob {
+    char name[RLCONFIG_SECTION_MAX];
+    char core[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char content[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char input[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    int frames;
+
+    pid_t pid;              // 0 when not running.
+    int fd;
+    retro_time_t started;
+    size_t received;
+    BatchResult result;
+    bool done;
+} BatchJob;
+
+/**
+ * One line of an input script: the buttons held from frame on.
+ */
+typedef struct BatchInputEvent {
+    int frame;
+    uint16_t buttons[BATCH_INPUT_PORTS];
+} BatchInputEvent;
+
+// Buttons the core sees as held this frame, set from the input script.
+static uint16_t batchButtons[BATCH_INPUT_PORTS];
+
+// Input script button names, indexed by RETRO_DEVICE_ID_JOYPAD_*.
+static const char* batchButtonNames[RETRO_DEVICE_ID_JOYPAD_R3 + 1] = {
+    "b", "y", "select", "start", "up", "down", "left", "right",
+    "a", "x", "l", "r", "l2", "r2", "l3", "r3"
+};
+
+static int16_t BatchInputState(unsigned port, unsigned device, unsigned index, unsigned id) {
+    (void)index;
+    if (port >= BATCH_INPUT_PORTS || (device & RETRO_DEVICE_MASK) != RETRO_DEVICE_JOYPAD) {
+        return 0;
+    }
+    if (id == RETRO_DEVICE_ID_JOYPAD_MASK) {
+        return (int16_t)batchButtons[port];
+    }
+    if (id > RETRO_DEVICE_ID_JOYPAD_R3) {
+        return 0;
+    }
+    return (int16_t)((batchButtons[port] >> id) & 1);
+}
+
+/**
+ * Load an input script. Each line is a frame number followed by the buttons
+ * held from that frame until the next line, e.g. "120 start" or "300 right b".
+ * Buttons are on port 1 unless prefixed with their port, as in "2:a". Lines
+ * starting with # are comments.
+ *
+ * An empty script, or one of only comments, is valid and presses nothing.
+ * Lines needn't be in frame order; lines for the same frame apply in the
+ * order of the file, so the last one wins.
+ *
+ * @param events Set to the events sorted by frame, which is NULL when there are none.
+ * @return True on success, false with error set.
+ */
+static bool LoadBatchInputScript(const char* fileName, cvector(BatchInputEvent)* events, char* error, size_t errorSize) {
+    *events = NULL;
+    if (FileExists(fileName) && GetFileLength(fileName) == 0) {
+        return true;
+    }
+    char* text = LoadFileText(fileName);
+    if (text == NULL) {
+        snprintf(error, errorSize, "Failed to read the input script %s", fileName);
+        return false;
+    }
+
+    int lineNumber = 0;
+    char* line = text;
+    while (line != NULL && *line != '\0') {
+        char* next = strchr(line, '\n');
+        if (next != NULL) *next++ = '\0';
+        lineNumber++;
+
+        BatchInputEvent event = {0};
+        char* token = strtok(line, " \t\r");
+        if (token == NULL || token[0] == '#') {
+            line = next;
+            continue;
+        }
+        char* end = NULL;
+        event.frame = (int)strtol(token, &end, 10);
+        if (end == token || *end != '\0' || event.frame < 0) {
+            snprintf(error, errorSize, "%s:%d: Expected a frame number, got \"%s\"", fileName, lineNumber, token);
+            cvector_free(*events);
+            *events = NULL;
+            UnloadFileText(text);
+            return false;
+        }
+
+        while ((token = strtok(NULL, " \t\r")) != NULL && token[0] != '#') {
+            int port = 0;
+            const char* colon = strchr(token, ':');
+            if (colon != NULL) {
+                port = atoi(token) - 1;
+                token = (char*)colon + 1;
+            }
+            int button = -1;
+            for (int i = 0; i <= RETRO_DEVICE_ID_JOYPAD_R3; i++) {
+                if (TextIsEqual(token, batchButtonNames[i])) {
+                    button = i;
+                    break;
+                }
+            }
+            if (port < 0 || port >= BATCH_INPUT_PORTS || button < 0) {
+                snprintf(error, errorSize, "%s:%d: Unknown button \"%s\"", fileName, lineNumber, token);
+                cvector_free(*events);
+                *events = NULL;
+                UnloadFileText(text);
+                return false;
+            }
+            event.buttons[port] |= (uint16_t)(1 << button);
+        }
+
+        cvector_push_back(*events, event);
+        line = next;
+    }
+    UnloadFileText(text);
+
+    // Insertion sort: stable, and a single pass over the usual sorted script.
+    for (size_t i = 1; i < cvector_size(*events); i++) {
+        BatchInputEvent event = (*events)[i];
+        size_t j = i;
+        while (j > 0 && (*events)[j - 1].frame > event.frame) {
+            (*events)[j] = (*events)[j - 1];
+            j--;
+        }
+        (*events)[j] = event;
+    }
+    return true;
+}
+
+/**
+ * Run a job in this process. Called in the job's child process, which exits
+ * right after, so nothing is torn down.
+ */
+static void RunBatchJob(const BatchJob* job, BatchResult* result) {
+    cvector(BatchInputEvent) script = NULL;
+    if (job->input[0] != '\0') {
+        if (!LoadBatchInputScript(job->input, &script, result->error, sizeof(result->error))) {
+            return;
+        }
+    }
+
+    LibretroInstance* instance = LoadLibretroInstance(true);
+    if (instance == NULL) {
+        snprintf(result->error, sizeof(result->error), "Out of memory");
+        return;
+    }
+    SetLibretroInstance(instance);
+    LIBRETRO.inputState = BatchInputState;
+
+    if (!InitLibretro(job->core)) {
+        snprintf(result->error, sizeof(result->error), "Failed to load the core %s", job->core);
+        return;
+    }
+    snprintf(result->libraryName, sizeof(result->libraryName), "%s", GetLibretroName());
+
+    if (!LoadLibretroGame(job->content[0] != '\0' ? job->content : NULL)) {
+        snprintf(result->error, sizeof(result->error), "Failed to load the content %s", job->content);
+        return;
+    }
+
+    size_t nextEvent = 0;
+    retro_time_t start = cpu_features_get_time_usec();
+    for (int frame = 0; frame < job->frames && !LibretroShouldClose(); frame++) {
+        while (nextEvent < cvector_size(script) && script[nextEvent].frame <= frame) {
+            memcpy(batchButtons, script[nextEvent].buttons, sizeof(batchButtons));
+            nextEvent++;
+        }
+        UpdateLibretroInstance(instance);
+        result->frames++;
+    }
+    result->seconds = (double)(cpu_features_get_time_usec() - start) / 1000000.0;
+
+    size_t frameSize = 0;
+    const void* frameData = GetLibretroFrameData(&frameSize);
+    if (frameData == NULL) {
+        snprintf(result->error, sizeof(result->error), "The core didn't output a frame");
+        return;
+    }
+    result->width = GetLibretroWidth();
+    result->height = GetLibretroHeight();
+    result->frameHash = GetLibretroDataHash(frameData, frameSize);
+
+    size_t sramSize = 0;
+    const void* sram = GetLibretroSRAMData(&sramSize);
+    if (sram != NULL) {
+        result->sramSize = (uint64_t)sramSize;
+        result->sramHash = GetLibretroDataHash(sram, sramSize);
+    }
+
+    result->ok = true;
+}
+
+/**
+ * Fork the job's process, which runs it and pipes back its result.
+ */
+static bool StartBatchJob(BatchJob* job) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    // Don't let the child inherit, and later repeat, buffered log output.
+    fflush(NULL);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(fds[0]);
+        BatchResult result;
+        memset(&result, 0, sizeof(result));
+        RunBatchJob(job, &result);
+
+        const unsigned char* data = (const unsigned char*)&result;
+        size_t written = 0;
+        while (written < sizeof(result)) {
+            ssize_t n = write(fds[1], data + written, sizeof(result) - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            written += (size_t)n;
+        }
+        fflush(NULL);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    job->pid = pid;
+    job->fd = fds[0];
+    job->received = 0;
+    job->started = cpu_features_get_time_usec();
+    return true;
+}
+
+/**
+ * Collect a job's result once it's written, its process exited or it timed out.
+ *
+ * @return true when the job is done.
+ */
+static bool PollBatchJob(BatchJob* job, int timeout) {
+    unsigned char* data = (unsigned char*)&job->result;
+    bool timedOut = false;
+    for (;;) {
+        ssize_t n = read(job->fd, data + job->received, sizeof(job->result) - job->received);
+        if (n > 0) {
+            job->received += (size_t)n;
+            if (job->received < sizeof(job->result)) continue;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (timeout <= 0 || cpu_features_get_time_usec() - job->started < (retro_time_t)timeout * 1000000) return false;
+            kill(job->pid, SIGKILL);
+            timedOut = true;
+        }
+        break;
+    }
+
+    close(job->fd);
+    job->fd = -1;
+    int status = 0;
+    waitpid(job->pid, &status, 0);
+    job->pid = 0;
+    job->done = true;
+
+    if (job->received != sizeof(job->result)) {
+        memset(&job->result, 0, sizeof(job->result));
+        if (timedOut) {
+            snprintf(job->result.error, sizeof(job->result.error), "Timed out after %d seconds", timeout);
+        } else if (WIFSIGNALED(status)) {
+            snprintf(job->result.error, sizeof(job->result.error), "Crashed with signal %d", WTERMSIG(status));
+        } else {
+            snprintf(job->result.error, sizeof(job->result.error), "Exited without a result (status %d)", WEXITSTATUS(status));
+        }
+    }
+    return true;
+}
+
+/**
+ * Copy a manifest path, resolving a relative one against the manifest's
+ * directory so a manifest works from any working directory.
+ */
+static void ResolveBatchPath(char* dest, size_t destSize, const char* baseDir, const char* path) {
+    if (path == NULL || path[0] == '\0' || path[0] == '/') {
+        snprintf(dest, destSize, "%s", path != NULL ? path : "");
+        return;
+    }
+    snprintf(dest, destSize, "%s/%s", baseDir, path);
+}
+
+/**
+ * Read the jobs of a manifest: one section per job, named after it, with the
+ * core, content, frames and input keys. Relative paths are relative to the
+ * manifest.
+ */
+static cvector(BatchJob) LoadBatchManifest(const char* fileName) {
+    RLibretroConfig* cfg = rlconfig_load(fileName);
+    if (cfg == NULL) return NULL;
+
+    // GetDirectoryPath() returns a static buffer.
+    char baseDir[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    snprintf(baseDir, sizeof(baseDir), "%s", GetDirectoryPath(fileName));
+
+    cvector(BatchJob) jobs = NULL;
+    for (size_t i = 0; i < cvector_size(cfg->sections); i++) {
+        BatchJob job;
+        memset(&job, 0, sizeof(job));
+        job.fd = -1;
+        snprintf(job.name, sizeof(job.name), "%.*s", (int)cfg->sections[i].length, cfg->sections[i].name);
+
+        const char* core = rlconfig_get(cfg, job.name, "core");
+        if (core == NULL) {
+            TraceLog(LOG_WARNING, "BATCH: Skipping [%s], it has no core", job.name);
+            continue;
+        }
+        const char* content = rlconfig_get(cfg, job.name, "content");
+        const char* input = rlconfig_get(cfg, job.name, "input");
+        ResolveBatchPath(job.core, sizeof(job.core), baseDir, core);
+        ResolveBatchPath(job.content, sizeof(job.content), baseDir, content);
+        ResolveBatchPath(job.input, sizeof(job.input), baseDir, input);
+        job.frames = rlconfig_get_int(cfg, job.name, "frames", BATCH_DEFAULT_FRAMES);
+        cvector_push_back(jobs, job);
+    }
+
+    rlconfig_free(cfg);
+    return jobs;
+}
+
+static void WriteBatchJSONString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const unsigned char* c = (const unsigned char*)text; *c != '\0'; c++) {
+        switch (*c) {
+            case '"': fputs("\\\"", file); break;
+            case '\\': fputs("\\\\", file); break;
+            case '\n': fputs("\\n", file); break;
+            case '\r': fputs("\\r", file); break;
+            case '\t': fputs("\\t", file); break;
+            default:
+                if (*c < 0x20) fprintf(file, "\\u%04x", *c);
+                else fputc(*c, file);
+                break;
+        }
+    }
+    fputc('"', file);
+}
+
+/**
+ * Write the report. Hashes are hex strings, as JSON numbers can't hold 64 bits.
+ */
+static bool SaveBatchReport(const char* fileName, const char* manifest, cvector(BatchJob) jobs, int workers, double seconds) {
+    FILE* file = (fileName != NULL) ? fopen(fileName, "w") : stdout;
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "BATCH: Failed to write the report to %s", fileName);
+        return false;
+    }
+
+    int failed = 0;
+    for (size_t i = 0; i < cvector_size(jobs); i++) {
+        if (!jobs[i].result.ok) failed++;
+    }
+
+    fprintf(file, "{\n  \"manifest\": ");
+    WriteBatchJSONString(file, manifest);
+    fprintf(file, ",\n  \"workers\": %d,\n  \"seconds\": %.3f,\n  \"passed\": %d,\n  \"failed\": %d,\n  \"jobs\": [",
+        workers, seconds, (int)cvector_size(jobs) - failed, failed);
+    for (size_t i = 0; i < cvector_size(jobs); i++) {
+        const BatchJob* job = &jobs[i];
+        const BatchResult* result = &job->result;
+        fprintf(file, "%s\n    {\"name\": ", i > 0 ? "," : "");
+        WriteBatchJSONString(file, job->name);
+        fprintf(file, ", \"core\": ");
+        WriteBatchJSONString(file, job->core);
+        fprintf(file, ", \"content\": ");
+        WriteBatchJSONString(file, job->content);
+        fprintf(file, ", \"library\": ");
+        WriteBatchJSONString(file, result->libraryName);
+        fprintf(file, ", \"ok\": %s, \"error\": ", result->ok ? "true" : "false");
+        if (result->ok) fprintf(file, "null");
+        else WriteBatchJSONString(file, result->error);
+        fprintf(file, ", \"frames\": %d, \"seconds\": %.3f, \"fps\": %.1f",
+            result->frames, result->seconds, result->seconds > 0.0 ? (double)result->frames / result->seconds : 0.0);
+        if (result->ok) {
+            fprintf(file, ", \"width\": %u, \"height\": %u, \"frameHash\": \"%016llx\"",
+                result->width, result->height, (unsigned long long)result->frameHash);
+            if (result->sramSize > 0) {
+                fprintf(file, ", \"sramSize\": %llu, \"sramHash\": \"%016llx\"",
+                    (unsigned long long)result->sramSize, (unsigned long long)result->sramHash);
+            } else {
+                fprintf(file, ", \"sramSize\": 0, \"sramHash\": null");
+            }
+        }
+        fprintf(file, "}");
+    }
+    fprintf(file, "\n  ]\n}\n");
+
+    if (file != stdout) fclose(file);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const char* manifest = NULL;
+    const char* output = NULL;
+    int workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int timeout = BATCH_DEFAULT_TIMEOUT;
+    int logLevel = LOG_WARNING;
+
+    for (int i = 1; i < argc; i++) {
+        if (TextIsEqual(argv[i], "-h") || TextIsEqual(argv[i], "--help")) {
+            printf("Usage: %s [-j <workers>] [-o <report.json>] [--timeout <seconds>] [-v] <manifest>\n\n", argv[0]);
+            printf("Runs every job of the manifest headless, one process per job, and writes a JSON report.\n\n");
+            printf("Options:\n");
+            printf("  -j, --jobs <workers>     Jobs to run at once (default: number of CPUs)\n");
+            printf("  -o, --output <file>      Write the report to a file instead of stdout\n");
+            printf("  --timeout <seconds>      Kill jobs that take longer, 0 for no limit (default: %d)\n", BATCH_DEFAULT_TIMEOUT);
+            printf("  -v, --verbose            Log everything the cores and frontend log\n\n");
+            printf("Manifest, one section per job:\n");
+            printf("  [smb]\n");
+            printf("  core = cores/fceumm_libretro.so\n");
+            printf("  content = roms/smb.nes\n");
+            printf("  frames = 600\n");
+            printf("  input = scripts/smb.txt\n");
+            return 0;
+        } else if ((TextIsEqual(argv[i], "-j") || TextIsEqual(argv[i], "--jobs")) && i + 1 < argc) {
+            workers = atoi(argv[++i]);
+        } else if ((TextIsEqual(argv[i], "-o") || TextIsEqual(argv[i], "--output")) && i + 1 < argc) {
+            output = argv[++i];
+        } else if (TextIsEqual(argv[i], "--timeout") && i + 1 < argc) {
+            timeout = atoi(argv[++i]);
+        } else if (TextIsEqual(argv[i], "-v") || TextIsEqual(argv[i], "--verbose")) {
+            logLevel = LOG_INFO;
+        } else {
+            manifest = argv[i];
+        }
+    }
+    if (workers < 1) workers = 1;
+    SetTraceLogLevel(logLevel);
+
+    if (manifest == NULL || !FileExists(manifest)) {
+        fprintf(stderr, "Usage: %s [-j <workers>] [-o <report.json>] [--timeout <seconds>] [-v] <manifest>\n", argv[0]);
+        return 2;
+    }
+
+    cvector(BatchJob) jobs = LoadBatchManifest(manifest);
+    int count = (int)cvector_size(jobs);
+    if (count == 0) {
+        fprintf(stderr, "BATCH: No jobs in %s\n", manifest);
+        return 2;
+    }
+    if (workers > count) workers = count;
+
+    retro_time_t start = cpu_features_get_time_usec();
+    struct pollfd* fds = (struct pollfd*)MemAlloc((unsigned int)(sizeof(struct pollfd) * (size_t)workers));
+    int next = 0, running = 0, finished = 0, failed = 0;
+    while (finished < count) {
+        while (running < workers && next < count) {
+            BatchJob* job = &jobs[next++];
+            if (StartBatchJob(job)) {
+                running++;
+            } else {
+                snprintf(job->result.error, sizeof(job->result.error), "Failed to start a process");
+                job->done = true;
+                finished++;
+                failed++;
+            }
+        }
+
+        // Sleep until a job writes its result or exits, waking up for timeouts.
+        int fdCount = 0;
+        for (int i = 0; i < count && fdCount < workers; i++) {
+            if (jobs[i].pid > 0) {
+                fds[fdCount].fd = jobs[i].fd;
+                fds[fdCount].events = POLLIN;
+                fds[fdCount].revents = 0;
+                fdCount++;
+            }
+        }
+        if (fdCount > 0) poll(fds, (nfds_t)fdCount, 100);
+
+        for (int i = 0; i < count; i++) {
+            BatchJob* job = &jobs[i];
+            if (job->pid > 0 && PollBatchJob(job, timeout)) {
+                running--;
+                finished++;
+                if (!job->result.ok) failed++;
+                fprintf(stderr, "[%d/%d] %s: %s\n", finished, count, job->name, job->result.ok ? "ok" : job->result.error);
+            }
+        }
+    }
+    MemFree(fds);
+    double seconds = (double)(cpu_features_get_time_usec() - start) / 1000000.0;
+    fprintf(stderr, "BATCH: %d of %d jobs passed in %.1f s on %d workers\n", count - failed, count, seconds, workers);
+
+    bool saved = SaveBatchReport(output, manifest, jobs, workers, seconds);
+    cvector_free(jobs);
+    return (saved && failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+/**********************************************************************************************
+*
+*   raylib-libretro-coreswitch-bench - Time switching between two cores, with and without the
+*   core pool.
+*
+*   Switches back and forth between two cores: closes the running one and initializes the
+*   other, the way the menu does when the user picks a different core. It does it first with
+*   the core pool off, so every switch dlopen()s the core and looks up its symbols, then with
+*   a pool of two, so only retro_deinit() and retro_init() run. It reports the average time of
+*   a switch for each.
+*
+*   Runs headless and loads no content. Pass two different cores; a dylib is only loaded once
+*   per process, so the same core twice measures nothing.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYLIB_LIBRETRO_IMPLEMENTATION
+#include "raylib-libretro.h"
+
+#include <stdlib.h>
+
+// Switches timed when --switches isn't given.
+#define CORESWITCH_DEFAULT_SWITCHES 100
+
+/**
+ * Switch between the cores, after one untimed round so the dylibs are in
+ * the page cache and, with the pool on, in the pool.
+ *
+ * @return Microseconds for all the timed switches, or -1 if a core failed to initialize.
+ */
+static retro_time_t CoreSwitchRun(const char* cores[2], int switches, int poolSize) {
+    SetLibretroCorePool(poolSize, (poolSize > 0) ? "*" : NULL);
+    for (int i = 0; i < 2; i++) {
+        if (!InitLibretro(cores[i])) return -1;
+        CloseLibretro();
+    }
+
+    if (!InitLibretro(cores[0])) return -1;
+    retro_time_t start = cpu_features_get_time_usec();
+    for (int i = 1; i <= switches; i++) {
+        CloseLibretro();
+        if (!InitLibretro(cores[i % 2])) return -1;
+    }
+    retro_time_t elapsed = cpu_features_get_time_usec() - start;
+    CloseLibretro();
+    UnloadLibretroCorePool();
+    return elapsed;
+}
+
+static void CoreSwitchReport(const char* name, int switches, retro_time_t usec) {
+    printf("%-12s %6d switches %10.3f ms %10.3f ms per switch\n", name, switches,
+        (double)usec / 1000.0, (double)usec / 1000.0 / switches);
+}
+
+int main(int argc, char* argv[]) {
+    const char* cores[2] = { NULL, NULL };
+    int coreCount = 0;
+    int switches = CORESWITCH_DEFAULT_SWITCHES;
+    for (int i = 1; i < argc; i++) {
+        if (TextIsEqual(argv[i], "-h") || TextIsEqual(argv[i], "--help")) {
+            coreCount = 0;
+            break;
+        } else if (TextIsEqual(argv[i], "--switches") && i + 1 < argc) {
+            switches = atoi(argv[++i]);
+        } else if (coreCount < 2) {
+            cores[coreCount++] = argv[i];
+        }
+    }
+    if (coreCount != 2) {
+        printf("Usage: %s [--switches <count>] <core> <other core>\n\n", argv[0]);
+        printf("Switches between two cores with the core pool off and on, and reports the\n");
+        printf("average time of a switch for each.\n\n");
+        printf("Options:\n");
+        printf("  --switches <count>  Switches to time (default: %d)\n", CORESWITCH_DEFAULT_SWITCHES);
+        return 2;
+    }
+    if (switches < 1) switches = 1;
+    SetTraceLogLevel(LOG_WARNING);
+
+    LibretroInstance* instance = LoadLibretroInstance(true);
+    if (instance == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    SetLibretroInstance(instance);
+
+    retro_time_t loaded = CoreSwitchRun(cores, switches, 0);
+    retro_time_t pooled = (loaded >= 0) ? CoreSwitchRun(cores, switches, 2) : -1;
+    SetLibretroInstance(NULL);
+    UnloadLibretroInstance(instance);
+    if (loaded < 0 || pooled < 0) {
+        fprintf(stderr, "Failed to initialize %s or %s\n", cores[0], cores[1]);
+        return 1;
+    }
+
+    CoreSwitchReport("without pool", switches, loaded);
+    CoreSwitchReport("with pool", switches, pooled);
+    return 0;
+}
@@ -0,0 +1,184 @@
+/**********************************************************************************************
+*
+*   raylib-libretro-memcard-bench - Time the libretro VFS on a memory card's write pattern.
+*
+*   Replays what a PlayStation core does when a game saves: it writes the card's 128 byte
+*   frames one at a time, a directory frame and then the 64 frames of a block, and flushes
+*   after every one. It runs the pattern twice against a scratch card file: once the way
+*   write handles used to work, keeping the whole file in memory and rewriting it on every
+*   flush, and once through raylib_libretro_vfs_*, and reports the time and bytes written.
+*
+*   Needs no cores or content. Bytes written are what the process handed the OS, read from
+*   /proc/self/io, so they're only reported on Linux.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYLIB_LIBRETRO_VFS_IMPLEMENTATION
+#include "raylib-libretro-vfs.h"
+
+#include <stdlib.h>
+
+// A PlayStation memory card: 16 blocks of 64 frames of 128 bytes. Block 0 is
+// the directory, with a frame per save block.
+#define MEMCARD_FRAME_SIZE 128
+#define MEMCARD_BLOCK_FRAMES 64
+#define MEMCARD_BLOCKS 16
+#define MEMCARD_SIZE (MEMCARD_FRAME_SIZE * MEMCARD_BLOCK_FRAMES * MEMCARD_BLOCKS)
+
+// Saves replayed when --saves isn't given.
+#define MEMCARD_DEFAULT_SAVES 100
+
+/**
+ * Bytes this process has handed to write() so far, or -1 where the OS
+ * doesn't say.
+ */
+static int64_t MemcardBytesWritten(void) {
+#if defined(__linux__)
+    FILE* file = fopen("/proc/self/io", "r");
+    if (file == NULL) return -1;
+    char line[128];
+    long long bytes = -1;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "wchar: %lld", &bytes) == 1) break;
+    }
+    fclose(file);
+    return (int64_t)bytes;
+#else
+    return -1;
+#endif
+}
+
+// Fill a frame with bytes that differ per save, so no write is a no-op.
+static void MemcardFillFrame(unsigned char* frame, int save, int index) {
+    for (int i = 0; i < MEMCARD_FRAME_SIZE; i++) {
+        frame[i] = (unsigned char)(save * 31 + index * 7 + i);
+    }
+}
+
+// Where frame `index` of a save goes: the save's directory frame first, then its block.
+static int64_t MemcardFrameOffset(int save, int index) {
+    int block = 1 + save % (MEMCARD_BLOCKS - 1);
+    if (index == 0) {
+        return (int64_t)block * MEMCARD_FRAME_SIZE;
+    }
+    return (int64_t)block * MEMCARD_BLOCK_FRAMES * MEMCARD_FRAME_SIZE + (int64_t)(index - 1) * MEMCARD_FRAME_SIZE;
+}
+
+/**
+ * The write handles this replaced: the whole file lives in memory and every
+ * flush saves all of it.
+ */
+static bool MemcardRunRewrite(const char* path, int saves, int* flushes) {
+    unsigned char* card = (unsigned char*)MemAlloc(MEMCARD_SIZE);
+    if (card == NULL) return false;
+    unsigned char frame[MEMCARD_FRAME_SIZE];
+    bool ok = true;
+    for (int save = 0; save < saves && ok; save++) {
+        for (int index = 0; index <= MEMCARD_BLOCK_FRAMES && ok; index++) {
+            MemcardFillFrame(frame, save, index);
+            memcpy(card + MemcardFrameOffset(save, index), frame, MEMCARD_FRAME_SIZE);
+            ok = SaveFileData(path, card, MEMCARD_SIZE);
+            (*flushes)++;
+        }
+    }
+    MemFree(card);
+    return ok;
+}
+
+/**
+ * The same writes through the VFS a core gets from the frontend.
+ */
+static bool MemcardRunVfs(const char* path, int saves, int* flushes) {
+    struct retro_vfs_file_handle* card = raylib_libretro_vfs_open(path,
+        RETRO_VFS_FILE_ACCESS_READ_WRITE | RETRO_VFS_FILE_ACCESS_UPDATE_EXISTING, RETRO_VFS_FILE_ACCESS_HINT_NONE);
+    if (card == NULL) return false;
+    unsigned char frame[MEMCARD_FRAME_SIZE];
+    bool ok = true;
+    for (int save = 0; save < saves && ok; save++) {
+        for (int index = 0; index <= MEMCARD_BLOCK_FRAMES && ok; index++) {
+            MemcardFillFrame(frame, save, index);
+            ok = raylib_libretro_vfs_seek(card, MemcardFrameOffset(save, index), RAYLIB_LIBRETRO_VFS_SEEK_SET) >= 0 &&
+                raylib_libretro_vfs_write(card, frame, MEMCARD_FRAME_SIZE) == MEMCARD_FRAME_SIZE &&
+                raylib_libretro_vfs_flush(card) == 0;
+            (*flushes)++;
+        }
+    }
+    return raylib_libretro_vfs_close(card) == 0 && ok;
+}
+
+// Start each run from the same blank, formatted card.
+static bool MemcardReset(const char* path) {
+    unsigned char* card = (unsigned char*)MemAlloc(MEMCARD_SIZE);
+    if (card == NULL) return false;
+    card[0] = 'M';
+    card[1] = 'C';
+    bool ok = SaveFileData(path, card, MEMCARD_SIZE);
+    MemFree(card);
+    return ok;
+}
+
+static void MemcardReport(const char* name, int flushes, int64_t written, retro_time_t usec) {
+    if (written >= 0) {
+        printf("%-28s %6d flushes %12lld bytes written %10.3f ms\n", name, flushes, (long long)written, (double)usec / 1000.0);
+    } else {
+        printf("%-28s %6d flushes %12s bytes written %10.3f ms\n", name, flushes, "n/a", (double)usec / 1000.0);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = "raylib-libretro-memcard-bench.mcd";
+    int saves = MEMCARD_DEFAULT_SAVES;
+    for (int i = 1; i < argc; i++) {
+        if (TextIsEqual(argv[i], "-h") || TextIsEqual(argv[i], "--help")) {
+            printf("Usage: %s [--saves <count>] [<scratch file>]\n\n", argv[0]);
+            printf("Replays a memory card's write pattern, rewriting the whole file on every flush\n");
+            printf("and then through the VFS, and reports the time and bytes written of each.\n\n");
+            printf("Options:\n");
+            printf("  --saves <count>   Saves to replay, of %d flushed frames each (default: %d)\n", MEMCARD_BLOCK_FRAMES + 1, MEMCARD_DEFAULT_SAVES);
+            printf("  <scratch file>    Card file to write, removed afterwards (default: %s)\n", path);
+            return 0;
+        } else if (TextIsEqual(argv[i], "--saves") && i + 1 < argc) {
+            saves = atoi(argv[++i]);
+        } else {
+            path = argv[i];
+        }
+    }
+    if (saves < 1) saves = 1;
+    SetTraceLogLevel(LOG_WARNING);
+
+    int rewriteFlushes = 0;
+    int vfsFlushes = 0;
+
+    if (!MemcardReset(path)) {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return 1;
+    }
+    int64_t before = MemcardBytesWritten();
+    retro_time_t start = cpu_features_get_time_usec();
+    bool ok = MemcardRunRewrite(path, saves, &rewriteFlushes);
+    retro_time_t rewriteTime = cpu_features_get_time_usec() - start;
+    int64_t rewriteWritten = (before >= 0) ? MemcardBytesWritten() - before : -1;
+
+    ok = ok && MemcardReset(path);
+    before = MemcardBytesWritten();
+    start = cpu_features_get_time_usec();
+    ok = ok && MemcardRunVfs(path, saves, &vfsFlushes);
+    retro_time_t vfsTime = cpu_features_get_time_usec() - start;
+    int64_t vfsWritten = (before >= 0) ? MemcardBytesWritten() - before : -1;
+
+    raylib_libretro_vfs_remove(path);
+    if (!ok) {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return 1;
+    }
+
+    printf("Memory card: %d bytes, %d saves of %d frames of %d bytes, flushed after every frame\n",
+        MEMCARD_SIZE, saves, MEMCARD_BLOCK_FRAMES + 1, MEMCARD_FRAME_SIZE);
+    MemcardReport("before (rewrite on flush)", rewriteFlushes, rewriteWritten, rewriteTime);
+    MemcardReport("after (raylib_libretro_vfs)", vfsFlushes, vfsWritten, vfsTime);
+    return 0;
+}
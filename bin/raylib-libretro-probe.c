@@ -0,0 +1,74 @@
+/**********************************************************************************************
+*
+*   raylib-libretro-probe - Report what a libretro core is, for cores without a .info file.
+*
+*   The menu's core scan runs this rather than opening unknown cores itself, so a core that
+*   hangs or crashes in its static initializers can't take the frontend with it. It's exec'd
+*   fresh, so it never inherits the frontend's threads or their locks.
+*
+*   Writes three lines to file descriptor 3: the core's name, its valid extensions and
+*   whether it needs full paths (0 or 1). Exits with 0 when it wrote them, or with
+*   RAYLIB_LIBRETRO_PROBE_NOT_A_CORE when the file isn't a usable core. Any other
+*   exit means the probe itself failed, and the core should be probed again later.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYLIB_LIBRETRO_IMPLEMENTATION
+#include "raylib-libretro.h"
+
+#include <unistd.h>   // write(), _exit()
+#include <errno.h>
+
+// Exit status for a file that was opened and isn't a usable core. Matches
+// the value the menu's core scan expects.
+#define RAYLIB_LIBRETRO_PROBE_NOT_A_CORE 3
+
+// Where the result goes; the scan maps its pipe here.
+#define RAYLIB_LIBRETRO_PROBE_FD 3
+
+static bool WriteProbeLine(const char* text) {
+    size_t length = strlen(text);
+    size_t written = 0;
+    while (written < length) {
+        ssize_t n = write(RAYLIB_LIBRETRO_PROBE_FD, text + written, length - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        written += (size_t)n;
+    }
+    while (true) {
+        ssize_t n = write(RAYLIB_LIBRETRO_PROBE_FD, "\n", 1);
+        if (n < 0 && errno == EINTR) continue;
+        return n == 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <core>\n", argv[0]);
+        return 2;
+    }
+
+    // Cores log through TraceLog(); keep it to problems.
+    SetTraceLogLevel(LOG_WARNING);
+
+    if (!PeekLibretroCoreInfo(argv[1])) {
+        _exit(RAYLIB_LIBRETRO_PROBE_NOT_A_CORE);
+    }
+    const char* name = GetLibretroName();
+    const char* extensions = GetLibretroValidExtensions();
+    if (name[0] == '\0' || extensions[0] == '\0' || strchr(name, '\n') != NULL || strchr(extensions, '\n') != NULL) {
+        _exit(RAYLIB_LIBRETRO_PROBE_NOT_A_CORE);
+    }
+
+    bool ok = WriteProbeLine(name) && WriteProbeLine(extensions) &&
+        WriteProbeLine(GetLibretroNeedFullpath(NULL, NULL) ? "1" : "0");
+
+    // Skip the core's deinit and any library teardown; they're what a probe
+    // is meant to stay away from.
+    fflush(NULL);
+    _exit(ok ? 0 : 2);
+}
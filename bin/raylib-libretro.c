@@ -61,6 +61,7 @@ bool LoadLibretroGameFromJS(const char* gameFile) {
     if (gameFile == NULL || gameFile[0] == '\0') return false;
     // Save the SRAM, and close the game prior to loading the new one.
     MenuSaveGameSRAM();
+    CancelLoadLibretroGame();
     CloseLibretro();
 
     // Load the game through the menu system.
@@ -85,57 +86,15 @@ void ResizeCanvasFromJS(int width, int height) {
 #define REWIND_CAPTURE_INTERVAL (1.0f / REWIND_CAPTURES_PER_SECOND)  // seconds between snapshots
 #define REWIND_BUFFER_FRAMES 600  // REWIND_BUFFER_FRAMES / REWIND_CAPTURES_PER_SECOND seconds of rewind
 
-typedef struct {
-    void* data;
-    unsigned int size;
-} RewindFrame;
-
-typedef struct {
-    RewindFrame frames[REWIND_BUFFER_FRAMES];
-    int head;   // next write index
-    int count;  // number of valid frames stored
-} RewindBuffer;
-
-static void RewindBufferPush(RewindBuffer* rb, void* data, unsigned int size) {
-    int idx = rb->head;
-    if (rb->frames[idx].data != NULL) {
-        MemFree(rb->frames[idx].data);
-    }
-    rb->frames[idx].data = data;
-    rb->frames[idx].size = size;
-    rb->head = (rb->head + 1) % REWIND_BUFFER_FRAMES;
-    if (rb->count < REWIND_BUFFER_FRAMES) rb->count++;
-}
-
-static bool RewindBufferPop(RewindBuffer* rb, void** outData, unsigned int* outSize) {
-    if (rb->count <= 0) return false;
-    rb->head = (rb->head - 1 + REWIND_BUFFER_FRAMES) % REWIND_BUFFER_FRAMES;
-    rb->count--;
-    *outData = rb->frames[rb->head].data;
-    *outSize = rb->frames[rb->head].size;
-    rb->frames[rb->head].data = NULL;
-    rb->frames[rb->head].size = 0;
-    return true;
-}
-
-static void RewindBufferFree(RewindBuffer* rb) {
-    for (int i = 0; i < REWIND_BUFFER_FRAMES; i++) {
-        if (rb->frames[i].data != NULL) {
-            MemFree(rb->frames[i].data);
-            rb->frames[i].data = NULL;
-        }
-    }
-    rb->head = 0;
-    rb->count = 0;
-}
-
 typedef struct {
     LibretroMenu* menu;
-    RewindBuffer rewind;
+    LibretroStateRing rewind;  // uncompressed same-instance snapshots, newest last
     float rewindTimer;  // seconds accumulated toward the next rewind capture/step
     bool muted;
     bool pendingMenuOpen;
     int appliedOrientation;  // last orientation pushed to Android; -1 = none yet
+    int frames;  // Update() calls so far, to close the startup profile after the first frame
+    const char* profileTrace;  // --profile-trace file for the startup profile, or NULL
 } AppData;
 
 // Breadcrumb logging through startup. On Android these go to logcat (and the
@@ -156,13 +115,19 @@ bool Init(void** userData, int argc, char** argv) {
     AndroidInitCrashLog(GetAndroidApp());
 #endif
 
+    // Main() opened "Startup" and "InitWindow"; the window is up now.
+    EndLibretroProfile();
+    BeginLibretroProfile("Init");
+
     // Display loading screen
+    BeginLibretroProfile("Loading screen");
     MenuDrawLoadingScreen(NULL);
 
     // Window Icon
     Image logo = GetLibretroLogo();
     SetWindowIcon(logo);
     UnloadImage(logo);
+    EndLibretroProfile();
 
     // Window Flags
     SetWindowMinSize(400, 300);
@@ -172,23 +137,35 @@ bool Init(void** userData, int argc, char** argv) {
     AppData* data = (AppData*)MemAlloc(sizeof(AppData));
     memset(data, 0, sizeof(AppData));
     data->appliedOrientation = -1;  // force the first Update() to apply the saved orientation
+    InitLibretroStateRing(&data->rewind, REWIND_BUFFER_FRAMES, 0, false);
     *userData = data;
 
     TraceLog(LOG_INFO, "LIBRETRO: Initializing Audio");
+    BeginLibretroProfile("InitAudioDevice");
     InitAudioDevice();
+    EndLibretroProfile();
     TraceLog(LOG_INFO, "LIBRETRO: Initializing physfs");
+    BeginLibretroProfile("InitLibretroPhysFS");
     InitLibretroPhysFS();
+    EndLibretroProfile();
 
     // Load the shaders and the menu.
     TraceLog(LOG_INFO, "LIBRETRO: Initializing shaders");
+    BeginLibretroProfile("LoadLibretroShaders");
     LoadLibretroShaders();
+    EndLibretroProfile();
     TraceLog(LOG_INFO, "LIBRETRO: Initializing Menu");
+    BeginLibretroProfile("InitLibretroMenu");
     data->menu = InitLibretroMenu();
+    EndLibretroProfile();
     if (!data->menu) {
         TraceLog(LOG_ERROR, "Failed to initialize menu");
         UnloadLibretroShaders();
         CloseLibretroPhysFS();
         CloseAudioDevice();
+        // Startup stops here; close "Init" and "Startup".
+        EndLibretroProfile();
+        EndLibretroProfile();
         return false;
     }
 
@@ -210,22 +187,31 @@ bool Init(void** userData, int argc, char** argv) {
     const char* gameFile = NULL;
     for (int i = 1; i < argc; i++) {
         if (TextIsEqual(argv[i], "-h") || TextIsEqual(argv[i], "--help")) {
-            printf("Usage: %s [-L <core>] [game]\n\n", argv[0]);
+            printf("Usage: %s [-L <core>] [--vfs-trace <file>] [--profile-trace <file>] [game]\n\n", argv[0]);
             printf("Options:\n");
             printf("  -L, --libretro <core>   Path to the libretro core (.so/.dll/.dylib)\n");
+            printf("  --vfs-trace <file>      Log every core file system call to a JSONL file\n");
+            printf("  --profile-trace <file>  Write the startup timings as a Chrome trace JSON file\n");
             printf("  -h, --help              Show this help message\n\n");
             printf("Examples:\n");
             printf("  %s -L fceumm_libretro.so smb.nes\n", argv[0]);
             printf("  %s -L fceumm_libretro.so smb.zip\n", argv[0]);
             printf("  %s smb.nes\n", argv[0]);
+            EndLibretroProfile();
+            EndLibretroProfile();
             return false;
         } else if ((TextIsEqual(argv[i], "-L") || TextIsEqual(argv[i], "--libretro")) && i + 1 < argc) {
             corePath = argv[++i];
+        } else if (TextIsEqual(argv[i], "--vfs-trace") && i + 1 < argc) {
+            raylib_libretro_vfs_set_trace_file(argv[++i]);
+        } else if (TextIsEqual(argv[i], "--profile-trace") && i + 1 < argc) {
+            data->profileTrace = argv[++i];
         } else if (!gameFile) {
             gameFile = argv[i];
         }
     }
 
+    BeginLibretroProfile("Load core and content");
     if (corePath) {
         if (MenuInitCore(corePath)) {
             bool gameLoaded = gameFile
@@ -239,6 +225,11 @@ bool Init(void** userData, int argc, char** argv) {
     } else if (gameFile) {
         if (MenuLoadGame(gameFile)) HideLibretroMenu(); else ShowLibretroMenu();
     }
+    EndLibretroProfile();
+
+    // "Init" ends, and "First frame" runs until the first Update() and Draw() are presented.
+    EndLibretroProfile();
+    BeginLibretroProfile("First frame");
 
     TraceLog(LOG_INFO, "LIBRETRO: Init() complete");
     return true;
@@ -247,6 +238,17 @@ bool Init(void** userData, int argc, char** argv) {
 bool Update(void* userData) {
     AppData* data = (AppData*)userData;
 
+    // The first frame has been presented by the second Update(), so close
+    // "First frame" and "Startup", and report where startup went.
+    if (++data->frames == 2) {
+        EndLibretroProfile();
+        EndLibretroProfile();
+        LogLibretroProfile(LOG_INFO);
+        if (data->profileTrace != NULL) {
+            SaveLibretroProfileTrace(data->profileTrace);
+        }
+    }
+
 #if defined(__ANDROID__)
     // Apply the menu's orientation choice when it changes (and the saved value
     // on the first frame, since appliedOrientation starts at -1).
@@ -300,15 +302,15 @@ bool Update(void* userData) {
                     data->rewindTimer = 0.0f;
                     void* stateData = NULL;
                     unsigned int stateSize = 0;
-                    if (RewindBufferPop(&data->rewind, &stateData, &stateSize)) {
-                        if (stateSize != GetLibretroSerializedSize()) {
+                    if (LibretroStateRingPop(&data->rewind, &stateData, &stateSize, NULL)) {
+                        if (stateSize != GetLibretroSerializedSizeEx(RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE)) {
                             // Snapshots belong to a different game/core (a new
                             // game was loaded). Drop the stale buffer instead of
                             // feeding the core a mismatched state.
                             MemFree(stateData);
-                            RewindBufferFree(&data->rewind);
+                            ClearLibretroStateRing(&data->rewind);
                         } else {
-                            SetLibretroSerializedData(stateData, stateSize);
+                            SetLibretroSerializedDataEx(stateData, stateSize, RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE);
                             MemFree(stateData);
                             SetLibretroMessage("Rewind", 1.0);
                             // Render the restored snapshot. Bypasses the time
@@ -326,16 +328,18 @@ bool Update(void* userData) {
                     if (data->rewindTimer >= REWIND_CAPTURE_INTERVAL) {
                         data->rewindTimer = 0.0f;
                         unsigned int size = 0;
-                        void* state = GetLibretroSerializedData(&size);
+                        // Rewind snapshots never leave this instance, so let
+                        // the core produce its cheaper same-instance state.
+                        void* state = GetLibretroSerializedDataEx(&size, RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE);
                         if (state != NULL) {
-                            RewindBufferPush(&data->rewind, state, size);
+                            LibretroStateRingPush(&data->rewind, state, size, 0);
                         }
                     }
                     if (IsKeyReleased(rewindKey) || LibretroHotkeyGPReleased(data->menu->hotkeys[LIBRETRO_HOTKEY_REWIND].gamepad)) {
                         SetLibretroMessage(NULL, 0.0);
                     }
                 } else if (data->rewind.count > 0) {
-                    RewindBufferFree(&data->rewind);
+                    ClearLibretroStateRing(&data->rewind);
                 }
 
                 // Fast Forward / Slow Motion
@@ -391,9 +395,11 @@ bool Update(void* userData) {
         if (dropped.count > 0) {
             const char* droppedPath = dropped.paths[0];
             SaveLibretroAllSettings();
+            // Stop a load still reading content before its core goes away.
+            CancelLoadLibretroGame();
             CloseLibretro();
             // The previous game's rewind snapshots are now meaningless.
-            RewindBufferFree(&data->rewind);
+            ClearLibretroStateRing(&data->rewind);
             if (IsLibretroCoreFile(droppedPath)) {
                 if (MenuInitCore(droppedPath)) {
                     BuildLibretroMenuOptions(data->menu);
@@ -409,8 +415,9 @@ bool Update(void* userData) {
 
     // Check if the core or menu asks to be shutdown.
     if (LibretroShouldClose()) {
-        RewindBufferFree(&data->rewind);
+        ClearLibretroStateRing(&data->rewind);
         SaveLibretroAllSettings();
+        CancelLoadLibretroGame();
         UnloadLibretroGame();
         CloseLibretro();
         ShowLibretroMenu();
@@ -434,31 +441,14 @@ bool Update(void* userData) {
 
         // Screenshot
         if (IsKeyReleased(LibretroHotkeyToKeyboardKey(menu.hotkeys[LIBRETRO_HOTKEY_SCREENSHOT].key)) || LibretroHotkeyGPReleased(menu.hotkeys[LIBRETRO_HOTKEY_SCREENSHOT].gamepad) && IsLibretroGameReady()) {
-            const char* screenshotsDir = GetLibretroDirectory(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY);
-            const char* contentName = GetLibretroContentName();
-            const char* baseName = (contentName && contentName[0] != '\0') ? contentName : "screenshot";
-            bool foundSlot = false;
-            for (int i = 1; i < 1000; i++) {
-                const char* screenshotName = TextFormat("%s/%s-%i.png", screenshotsDir, baseName, i);
-                if (!FileExists(screenshotName)) {
-                    //Image screenshot = LoadImageFromScreen();
-                    //Image screenshot = LoadImageFromTexture(GetLibretroTexture());
-                    Image screenshot = LoadImageFromLibretro();
-                    foundSlot = true;
-                    if (ExportImage(screenshot, screenshotName)) {
-                        SetLibretroMessage(TextFormat("Screenshot: %s", screenshotName), 2.0);
-                    }
-                    else {
-                        SetLibretroMessage(TextFormat("Screenshot failed: %s", screenshotName), 2.0);
-                    }
-                    if (screenshot.data != NULL) {
-                        UnloadImage(screenshot);
-                    }
-                    break;
-                }
+            // Only the frame copy happens here; scaling and PNG encoding run
+            // on the menu's image worker.
+            const char* screenshotName = LibretroMenuNextScreenshotPath();
+            if (LibretroMenuQueueScreenshot(screenshotName, 0)) {
+                SetLibretroMessage(TextFormat("Screenshot: %s", screenshotName), 2.0);
             }
-            if (!foundSlot) {
-                SetLibretroMessage("Screenshot slots full", 2.0);
+            else {
+                SetLibretroMessage(TextFormat("Screenshot failed: %s", screenshotName), 2.0);
             }
         }
 
@@ -494,6 +484,11 @@ bool Update(void* userData) {
             LibretroMenuLoadStateClicked(menu.console, NULL);
         }
 
+        // Undo State
+        else if (IsKeyReleased(LibretroHotkeyToKeyboardKey(menu.hotkeys[LIBRETRO_HOTKEY_UNDO_STATE].key)) || LibretroHotkeyGPReleased(menu.hotkeys[LIBRETRO_HOTKEY_UNDO_STATE].gamepad)) {
+            LibretroMenuUndoStateClicked(menu.console, NULL);
+        }
+
         // Prev Slot
         else if (IsKeyReleased(LibretroHotkeyToKeyboardKey(menu.hotkeys[LIBRETRO_HOTKEY_PREV_SLOT].key)) || LibretroHotkeyGPReleased(menu.hotkeys[LIBRETRO_HOTKEY_PREV_SLOT].gamepad)) {
             menu.saveSlotIndex = (menu.saveSlotIndex - 1 + 10) % 10;
@@ -585,11 +580,19 @@ void Close(void* userData) {
     SaveLibretroAllSettings();
 
     // Free the rewind buffer.
-    RewindBufferFree(&data->rewind);
+    UnloadLibretroStateRing(&data->rewind);
 
-    // Unload the game and close the core.
+    // Unload the game and close the core, and any cores kept loaded for switching.
+    CancelLoadLibretroGame();
     UnloadLibretroGame();
     CloseLibretro();
+    UnloadLibretroCorePool();
+
+    // Report how hard the core used the file system.
+    if (raylib_libretro_vfs_get_stats()->calls[RAYLIB_LIBRETRO_VFS_CALL_OPEN] > 0) {
+        raylib_libretro_vfs_log_stats(LOG_INFO);
+    }
+    raylib_libretro_vfs_set_trace_file(NULL);
 
     CloseLibretroMenu();
 
@@ -600,6 +603,11 @@ void Close(void* userData) {
 }
 
 App Main() {
+    // Time startup from here, just before the window is created, to the first
+    // presented frame. Init() and Update() close these phases.
+    BeginLibretroProfile("Startup");
+    BeginLibretroProfile("InitWindow");
+
     return (App){
         .title = "raylib-libretro",
 #if defined(__ANDROID__)
@@ -254,6 +254,7 @@ static void SetupAndroidEnvironment(LibretroMenu* menu) {
     if (LIBRETRO.coreDirectory[0]   != '/') TextCopy(LIBRETRO.coreDirectory,   TextFormat("%s/cores", dataDir));
     if (LIBRETRO.saveDirectory[0]   != '/') TextCopy(LIBRETRO.saveDirectory,   TextFormat("%s/saves", dataDir));
     if (LIBRETRO.systemDirectory[0] != '/') TextCopy(LIBRETRO.systemDirectory, TextFormat("%s/system", dataDir));
+    if (LIBRETRO.cacheDirectory[0]  != '/') TextCopy(LIBRETRO.cacheDirectory,  TextFormat("%s/cache", dataDir));
     if (LIBRETRO.fileBrowserStartDirectory[0] == '\0') {
         // Default the file browser to the shared storage root (where ROMs live),
         // falling back to the app-private external dir if JNI is unavailable.
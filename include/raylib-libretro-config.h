@@ -11,13 +11,12 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 
-/* Size limits for individual field strings */
+/* Size limits for individual field strings; longer ones are truncated */
 #define RLCONFIG_SECTION_MAX  64
 #define RLCONFIG_KEY_MAX      256
 #define RLCONFIG_VALUE_MAX    512
-#define RLCONFIG_COMPOUND_MAX (RLCONFIG_SECTION_MAX + 1 + RLCONFIG_KEY_MAX + 1)
-#define RLCONFIG_LINE_MAX     (RLCONFIG_KEY_MAX + RLCONFIG_VALUE_MAX + 4)
 
 // Shared config file used by SaveLibretroCoreOptions / LoadLibretroCoreOptions.
 // Keys are prefixed with the core name: "CoreName.key=value"
@@ -29,13 +28,6 @@
     #define RAYLIB_LIBRETRO_CFG_FILE "raylib-libretro.cfg"
 #endif
 
-#define HASHMAP_REALLOC(p, s) MemRealloc(p, (unsigned int)s)
-#define HASHMAP_FREE(p)       MemFree(p)
-#include "../vendor/hashmap/hashmap.h"
-
-/* Hashmap type: compound key ("section\nkey") → entry index */
-HASHMAP_DECLARE_STRING(RLibretroConfigLookup, rlconfiglookup, int)
-
 /* Redirect cvector allocations through raylib's memory functions. */
 #define cvector_clib_malloc(sz)    MemAlloc((unsigned int)(sz))
 #define cvector_clib_realloc(p,sz) MemRealloc((p), (unsigned int)(sz))
@@ -43,19 +35,42 @@ HASHMAP_DECLARE_STRING(RLibretroConfigLookup, rlconfiglookup, int)
 #define cvector_clib_calloc(n,sz)  memset(MemAlloc((unsigned int)((n)*(sz))), 0, (size_t)((n)*(sz)))
 #include "../vendor/c-vector/cvector.h"
 
-/* One config key-value pair with its section. Heap-allocated individually so that
-   the compound field address (used as a hashmap key) stays stable across vector growth. */
+/* One config key-value pair. key and value are NUL-terminated slices into a
+   parsed file or the string arena, never allocated per entry. */
 typedef struct {
-    char section[RLCONFIG_SECTION_MAX];
-    char key[RLCONFIG_KEY_MAX];
-    char value[RLCONFIG_VALUE_MAX];
-    char compound[RLCONFIG_COMPOUND_MAX]; /* "section\nkey" — used as hashmap key */
+    const char *key;
+    const char *value;
+    uint32_t keyLength;
+    uint32_t valueLength;
+    uint32_t section;   /* index into RLibretroConfig::sections */
+    uint32_t hash;      /* of section and key, see RLibretroConfigHash() */
 } RLibretroConfigEntry;
 
+/* A [section] name, shared by all of its entries. */
+typedef struct {
+    const char *name;
+    uint32_t length;
+} RLibretroConfigSection;
+
+/* Backing memory for the strings: a parsed file, kept whole and terminated in
+   place, or an arena block for strings set after loading. */
+typedef struct RLibretroConfigStorage {
+    struct RLibretroConfigStorage *next;
+    size_t size;
+    size_t used;        /* arena blocks only */
+    bool mapped;        /* data is an mmap() of the file rather than MemAlloc()'ed */
+    char *data;
+} RLibretroConfigStorage;
+
 /* In-memory config — heap allocated via rlconfig_load() */
 typedef struct {
-    cvector(RLibretroConfigEntry*) entries; /* individually heap-allocated entries */
-    RLibretroConfigLookup lookup;           /* compound_key → index into entries */
+    cvector(RLibretroConfigEntry) entries;
+    cvector(RLibretroConfigSection) sections;
+    int *table;                         /* open addressing on hash: entry index + 1, 0 when empty */
+    size_t tableSize;                   /* power of two, or 0 */
+    RLibretroConfigStorage *files;      /* parsed files */
+    RLibretroConfigStorage *arena;      /* newest arena block first */
+    bool dirty;                         /* changed since it was loaded or saved */
 } RLibretroConfig;
 
 /* --- Public API (all static) --- */
@@ -63,16 +78,19 @@ typedef struct {
 /* Load config from filename. Pass NULL to create an empty config. Caller must call rlconfig_free(). */
 static RLibretroConfig* rlconfig_load(const char *filename);
 
-/* Save config to filename. Returns true on success. */
+/* Save config to filename, if it changed. Returns true on success. */
 static bool rlconfig_save(RLibretroConfig *cfg, const char *filename);
 
+/* True when cfg has changes rlconfig_save() hasn't written yet. */
+static bool rlconfig_is_dirty(const RLibretroConfig *cfg);
+
 /* Get string value for section+key. Returns NULL if not found. */
 static const char* rlconfig_get(RLibretroConfig *cfg, const char *section, const char *key);
 
 /* Get integer value for section+key. Returns fallback if not found or non-numeric. */
 static int rlconfig_get_int(RLibretroConfig *cfg, const char *section, const char *key, int fallback);
 
-/* Set string value for section+key. Adds entry if new, updates in-place if existing. */
+/* Set string value for section+key. Adds entry if new, updates it if changed. */
 static void rlconfig_set(RLibretroConfig *cfg, const char *section, const char *key, const char *value);
 
 /* Set integer value (formatted as decimal string). */
@@ -90,6 +108,9 @@ static bool rlconfig_delete(RLibretroConfig *cfg, const char *section, const cha
 /* Remove all keys in a section. */
 static void rlconfig_clear_section(RLibretroConfig *cfg, const char *section);
 
+/* Number of keys in section. */
+static int rlconfig_section_size(const RLibretroConfig *cfg, const char *section);
+
 /* Free config and all associated memory. */
 static void rlconfig_free(RLibretroConfig *cfg);
 
@@ -103,89 +124,233 @@ static void rlconfig_load_info(RLibretroConfig *cfg, const char *section, const
 #ifndef RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION_ONCE
 #define RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION_ONCE
 
-HASHMAP_DEFINE_STRING(RLibretroConfigLookup, rlconfiglookup, int)
+/* Files are parsed from a private, writable mmap() where POSIX has one: pages
+   are only copied where a terminator is written. Elsewhere, or with
+   RLCONFIG_NO_MMAP defined, they're read whole. */
+#if !defined(RLCONFIG_NO_MMAP) && !defined(_WIN32) && !defined(__EMSCRIPTEN__) && !defined(PLATFORM_WEB)
+#define RLCONFIG_MMAP
+#include <sys/mman.h>  /* mmap(), munmap() */
+#include <sys/stat.h>  /* fstat() */
+#include <fcntl.h>     /* open() */
+#include <unistd.h>    /* close() */
+#endif
 
-/* Build compound key "section\nkey" into out (size RLCONFIG_COMPOUND_MAX). */
-static void RLibretroConfigCompound(const char *section, const char *key,
-                                    char *out, size_t outSize) {
-    snprintf(out, outSize, "%s\n%s", section, key);
+/* FNV-1a over section, a '\n' separator, then key. */
+static uint32_t RLibretroConfigHash(const char *section, size_t sectionLength, const char *key, size_t keyLength) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sectionLength; i++) hash = (hash ^ (unsigned char)section[i]) * 16777619u;
+    hash = (hash ^ '\n') * 16777619u;
+    for (size_t i = 0; i < keyLength; i++) hash = (hash ^ (unsigned char)key[i]) * 16777619u;
+    return hash;
 }
 
-static void rlconfig_free(RLibretroConfig *cfg) {
-    if (!cfg) return;
+/* Index of the section, or -1. */
+static int RLibretroConfigFindSection(const RLibretroConfig *cfg, const char *name, size_t length) {
+    for (size_t i = 0; i < cvector_size(cfg->sections); i++) {
+        if (cfg->sections[i].length == length && memcmp(cfg->sections[i].name, name, length) == 0) return (int)i;
+    }
+    return -1;
+}
+
+/* Index of the entry, or -1. */
+static int RLibretroConfigFind(const RLibretroConfig *cfg, const char *section, size_t sectionLength,
+                               const char *key, size_t keyLength, uint32_t hash) {
+    if (cfg->tableSize == 0) return -1;
+    size_t mask = cfg->tableSize - 1;
+    for (size_t slot = hash & mask; cfg->table[slot] != 0; slot = (slot + 1) & mask) {
+        const RLibretroConfigEntry *entry = &cfg->entries[cfg->table[slot] - 1];
+        const RLibretroConfigSection *sec = &cfg->sections[entry->section];
+        if (entry->hash == hash && entry->keyLength == keyLength && sec->length == sectionLength &&
+                memcmp(entry->key, key, keyLength) == 0 && memcmp(sec->name, section, sectionLength) == 0) {
+            return cfg->table[slot] - 1;
+        }
+    }
+    return -1;
+}
+
+/* Rebuild the table for the current entries, sized for at least minEntries. */
+static bool RLibretroConfigRehash(RLibretroConfig *cfg, size_t minEntries) {
+    size_t size = 16;
+    while (size < minEntries * 2) size *= 2;
+    if (size != cfg->tableSize) {
+        int *table = (int*)MemAlloc((unsigned int)(size * sizeof(int)));
+        if (!table) return false;
+        MemFree(cfg->table);
+        cfg->table = table;
+        cfg->tableSize = size;
+    }
+    memset(cfg->table, 0, cfg->tableSize * sizeof(int));
     for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
-        MemFree(cfg->entries[i]);
+        size_t slot = cfg->entries[i].hash & (cfg->tableSize - 1);
+        while (cfg->table[slot] != 0) slot = (slot + 1) & (cfg->tableSize - 1);
+        cfg->table[slot] = (int)i + 1;
     }
-    cvector_free(cfg->entries);
-    rlconfiglookup_free(&cfg->lookup);
-    MemFree(cfg);
+    return true;
 }
 
-static bool rlconfig_delete(RLibretroConfig *cfg, const char *section, const char *key) {
-    char compound[RLCONFIG_COMPOUND_MAX];
-    int idx = -1;
-    if (!cfg || !section || !key) return false;
-    RLibretroConfigCompound(section, key, compound, sizeof(compound));
-    if (!rlconfiglookup_get(&cfg->lookup, compound, &idx) || idx < 0) return false;
+/* Copy length bytes of str into the arena, NUL-terminated. */
+static const char* RLibretroConfigIntern(RLibretroConfig *cfg, const char *str, size_t length) {
+    RLibretroConfigStorage *block = cfg->arena;
+    if (!block || block->size - block->used < length + 1) {
+        size_t size = length + 1 > 4096 ? length + 1 : 4096;
+        block = (RLibretroConfigStorage*)MemAlloc((unsigned int)(sizeof(RLibretroConfigStorage) + size));
+        if (!block) return NULL;
+        block->data = (char*)(block + 1);
+        block->size = size;
+        block->used = 0;
+        block->mapped = false;
+        block->next = cfg->arena;
+        cfg->arena = block;
+    }
+    char *copy = block->data + block->used;
+    memcpy(copy, str, length);
+    copy[length] = '\0';
+    block->used += length + 1;
+    return copy;
+}
 
-    rlconfiglookup_remove(&cfg->lookup, cfg->entries[idx]->compound, NULL);
-    MemFree(cfg->entries[idx]);
-    cvector_erase(cfg->entries, (size_t)idx);
+/* Section index for name, adding it if new. name must stay valid while cfg does
+   unless copy is set. */
+static int RLibretroConfigAddSection(RLibretroConfig *cfg, const char *name, size_t length, bool copy) {
+    int index = RLibretroConfigFindSection(cfg, name, length);
+    if (index >= 0) return index;
+    RLibretroConfigSection section = { copy ? RLibretroConfigIntern(cfg, name, length) : name, (uint32_t)length };
+    if (!section.name) return -1;
+    cvector_push_back(cfg->sections, section);
+    return (int)cvector_size(cfg->sections) - 1;
+}
 
-    /* Fix hashmap indices for entries that shifted left after the erase. */
-    for (size_t i = (size_t)idx; i < cvector_size(cfg->entries); i++) {
-        rlconfiglookup_insert(&cfg->lookup, cfg->entries[i]->compound, (int)i);
+/* Store a value for key in section, replacing any previous one. key and value
+   must stay valid while cfg does. */
+static void RLibretroConfigPut(RLibretroConfig *cfg, int section, const char *key, size_t keyLength,
+                               const char *value, size_t valueLength) {
+    const RLibretroConfigSection *sec = &cfg->sections[section];
+    uint32_t hash = RLibretroConfigHash(sec->name, sec->length, key, keyLength);
+    int idx = RLibretroConfigFind(cfg, sec->name, sec->length, key, keyLength, hash);
+    if (idx >= 0) {
+        cfg->entries[idx].value = value;
+        cfg->entries[idx].valueLength = (uint32_t)valueLength;
+        return;
     }
-    return true;
+
+    if ((cvector_size(cfg->entries) + 1) * 2 > cfg->tableSize &&
+            !RLibretroConfigRehash(cfg, cvector_size(cfg->entries) + 1)) {
+        return;
+    }
+    RLibretroConfigEntry entry = { key, value, (uint32_t)keyLength, (uint32_t)valueLength, (uint32_t)section, hash };
+    cvector_push_back(cfg->entries, entry);
+    size_t slot = hash & (cfg->tableSize - 1);
+    while (cfg->table[slot] != 0) slot = (slot + 1) & (cfg->tableSize - 1);
+    cfg->table[slot] = (int)cvector_size(cfg->entries);
 }
 
-static void rlconfig_clear_section(RLibretroConfig *cfg, const char *section) {
-    if (!cfg || !section) return;
+/* Drop every parsed file and arena block. Only valid once no entry points into them. */
+static void RLibretroConfigReleaseStorage(RLibretroConfig *cfg) {
+    RLibretroConfigStorage *lists[2] = { cfg->files, cfg->arena };
+    for (int l = 0; l < 2; l++) {
+        RLibretroConfigStorage *storage = lists[l];
+        while (storage) {
+            RLibretroConfigStorage *next = storage->next;
+#ifdef RLCONFIG_MMAP
+            if (storage->mapped) munmap(storage->data, storage->size);
+            else
+#endif
+            if (l == 0) MemFree(storage->data);
+            MemFree(storage);
+            storage = next;
+        }
+    }
+    cfg->files = NULL;
+    cfg->arena = NULL;
+    cvector_free(cfg->sections);
+    cfg->sections = NULL;
+}
 
-    /* Stable partition: keep non-matching entries, free matching ones. */
+static void rlconfig_free(RLibretroConfig *cfg) {
+    if (!cfg) return;
+    RLibretroConfigReleaseStorage(cfg);
+    cvector_free(cfg->entries);
+    MemFree(cfg->table);
+    MemFree(cfg);
+}
+
+static bool rlconfig_is_dirty(const RLibretroConfig *cfg) {
+    return cfg && cfg->dirty;
+}
+
+/* Remove the entry at index, or when index is negative every entry of
+   section, then rebuild the table. Returns false if nothing was removed. */
+static bool RLibretroConfigErase(RLibretroConfig *cfg, int section, int index) {
     size_t write = 0;
     for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
-        if (strcmp(cfg->entries[i]->section, section) == 0) {
-            MemFree(cfg->entries[i]);
-        } else {
-            cfg->entries[write++] = cfg->entries[i];
-        }
+        bool erase = index >= 0 ? (int)i == index : (int)cfg->entries[i].section == section;
+        if (!erase) cfg->entries[write++] = cfg->entries[i];
     }
+    if (write == cvector_size(cfg->entries)) return false;
     cvector_set_size(cfg->entries, write);
+    cfg->dirty = true;
 
-    /* Rebuild hashmap from scratch since indices changed. */
-    rlconfiglookup_clear(&cfg->lookup);
-    for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
-        rlconfiglookup_insert(&cfg->lookup, cfg->entries[i]->compound, (int)i);
+    /* With nothing left pointing into them, the parsed files and the arena
+       can go — e.g. each .info parsed into a scratch config and cleared. */
+    if (write == 0) RLibretroConfigReleaseStorage(cfg);
+    RLibretroConfigRehash(cfg, write);
+    return true;
+}
+
+static bool rlconfig_delete(RLibretroConfig *cfg, const char *section, const char *key) {
+    if (!cfg || !section || !key) return false;
+    size_t sectionLength = strlen(section), keyLength = strlen(key);
+    int idx = RLibretroConfigFind(cfg, section, sectionLength, key, keyLength,
+                                  RLibretroConfigHash(section, sectionLength, key, keyLength));
+    return idx >= 0 && RLibretroConfigErase(cfg, -1, idx);
+}
+
+static void rlconfig_clear_section(RLibretroConfig *cfg, const char *section) {
+    if (!cfg || !section) return;
+    int index = RLibretroConfigFindSection(cfg, section, strlen(section));
+    if (index >= 0) RLibretroConfigErase(cfg, index, -1);
+}
+
+static int rlconfig_section_size(const RLibretroConfig *cfg, const char *section) {
+    int count = 0;
+    if (!cfg || !section) return 0;
+    int index = RLibretroConfigFindSection(cfg, section, strlen(section));
+    for (size_t i = 0; index >= 0 && i < cvector_size(cfg->entries); i++) {
+        if ((int)cfg->entries[i].section == index) count++;
     }
+    return count;
 }
 
 static void rlconfig_set(RLibretroConfig *cfg, const char *section,
                           const char *key, const char *value) {
-    char compound[RLCONFIG_COMPOUND_MAX];
-    int idx = -1;
-
     if (!cfg || !section || !key || !value) return;
 
-    RLibretroConfigCompound(section, key, compound, sizeof(compound));
-
-    if (rlconfiglookup_get(&cfg->lookup, compound, &idx) && idx >= 0) {
-        snprintf(cfg->entries[idx]->value, RLCONFIG_VALUE_MAX, "%s", value);
+    size_t sectionLength = strlen(section), keyLength = strlen(key), valueLength = strlen(value);
+    if (sectionLength >= RLCONFIG_SECTION_MAX) sectionLength = RLCONFIG_SECTION_MAX - 1;
+    if (keyLength >= RLCONFIG_KEY_MAX) keyLength = RLCONFIG_KEY_MAX - 1;
+    if (valueLength >= RLCONFIG_VALUE_MAX) valueLength = RLCONFIG_VALUE_MAX - 1;
+
+    int idx = RLibretroConfigFind(cfg, section, sectionLength, key, keyLength,
+                                  RLibretroConfigHash(section, sectionLength, key, keyLength));
+    if (idx >= 0) {
+        /* Compare what would be stored, so an over-long value that's
+           unchanged once truncated doesn't dirty the config either. */
+        RLibretroConfigEntry *entry = &cfg->entries[idx];
+        if (entry->valueLength == valueLength && memcmp(entry->value, value, valueLength) == 0) return;
+        const char *copy = RLibretroConfigIntern(cfg, value, valueLength);
+        if (!copy) return;
+        entry->value = copy;
+        entry->valueLength = (uint32_t)valueLength;
+        cfg->dirty = true;
         return;
     }
 
-    RLibretroConfigEntry *entry = (RLibretroConfigEntry*)MemAlloc(sizeof(RLibretroConfigEntry));
-    if (!entry) return;
-    snprintf(entry->section,  RLCONFIG_SECTION_MAX,  "%s", section);
-    snprintf(entry->key,      RLCONFIG_KEY_MAX,       "%s", key);
-    snprintf(entry->value,    RLCONFIG_VALUE_MAX,     "%s", value);
-    RLibretroConfigCompound(section, key, entry->compound, RLCONFIG_COMPOUND_MAX);
-
-    idx = (int)cvector_size(cfg->entries);
-    cvector_push_back(cfg->entries, entry);
-
-    /* Store pointer into the entry's own compound buffer — stable while the entry is alive. */
-    rlconfiglookup_insert(&cfg->lookup, entry->compound, idx);
+    int sec = RLibretroConfigAddSection(cfg, section, sectionLength, true);
+    const char *keyCopy = RLibretroConfigIntern(cfg, key, keyLength);
+    const char *valueCopy = RLibretroConfigIntern(cfg, value, valueLength);
+    if (sec < 0 || !keyCopy || !valueCopy) return;
+    RLibretroConfigPut(cfg, sec, keyCopy, keyLength, valueCopy, valueLength);
+    cfg->dirty = true;
 }
 
 static void rlconfig_set_int(RLibretroConfig *cfg, const char *section,
@@ -197,13 +362,11 @@ static void rlconfig_set_int(RLibretroConfig *cfg, const char *section,
 
 static const char* rlconfig_get(RLibretroConfig *cfg, const char *section,
                                   const char *key) {
-    char compound[RLCONFIG_COMPOUND_MAX];
-    int idx = -1;
     if (!cfg || !section || !key) return NULL;
-    RLibretroConfigCompound(section, key, compound, sizeof(compound));
-    if (rlconfiglookup_get(&cfg->lookup, compound, &idx) && idx >= 0)
-        return cfg->entries[idx]->value;
-    return NULL;
+    size_t sectionLength = strlen(section), keyLength = strlen(key);
+    int idx = RLibretroConfigFind(cfg, section, sectionLength, key, keyLength,
+                                  RLibretroConfigHash(section, sectionLength, key, keyLength));
+    return idx >= 0 ? cfg->entries[idx].value : NULL;
 }
 
 static int rlconfig_get_int(RLibretroConfig *cfg, const char *section,
@@ -231,75 +394,138 @@ static float rlconfig_get_float(RLibretroConfig *cfg, const char *section,
     return result;
 }
 
-/* Trim leading and trailing ASCII whitespace in-place. */
-static void RLibretroConfigTrim(char *s) {
-    char *start = s;
-    while (*start == ' ' || *start == '\t' || *start == '\r' || *start == '\n')
-        start++;
-    if (start != s) memmove(s, start, strlen(start) + 1);
-    size_t len = strlen(s);
-    while (len > 0 && (s[len-1] == ' ' || s[len-1] == '\t' ||
-                       s[len-1] == '\r' || s[len-1] == '\n')) {
-        s[--len] = '\0';
+/* Map (or read) filename into a new parsed-file storage of cfg. */
+static RLibretroConfigStorage* RLibretroConfigOpen(RLibretroConfig *cfg, const char *filename) {
+    RLibretroConfigStorage *file = (RLibretroConfigStorage*)MemAlloc(sizeof(RLibretroConfigStorage));
+    if (!file) return NULL;
+
+#ifdef RLCONFIG_MMAP
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        MemFree(file);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *data = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            file->data = (char*)data;
+            file->size = (size_t)st.st_size;
+            file->mapped = true;
+        }
+    }
+    close(fd);
+    if (!file->mapped)
+#endif
+    {
+        FILE *f = fopen(filename, "rb");
+        long size = -1;
+        if (f && fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+        if (f && size >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+            /* One spare byte to terminate a last line with no newline. */
+            file->data = (char*)MemAlloc((unsigned int)size + 1);
+            file->size = file->data ? fread(file->data, 1, (size_t)size, f) : 0;
+        }
+        if (f) fclose(f);
+        if (!file->data) {
+            MemFree(file);
+            return NULL;
+        }
     }
+
+    file->next = cfg->files;
+    cfg->files = file;
+    return file;
+}
+
+static bool RLibretroConfigIsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
 }
 
 /* Parse an INI/.info file into cfg. Lines are "key = value"; [section] headers
    switch the active section. defaultSection (may be NULL) is the section keys
    land in before any header — pass the target section for sectionless .info
    files, NULL for .cfg files where keys must follow a header. Surrounding
-   double quotes are stripped from values (.info style; harmless for .cfg). */
+   double quotes are stripped from values (.info style; harmless for .cfg).
+
+   The file stays whole in memory: keys, values and section names are
+   terminated in place and the entries point at them, so nothing is copied or
+   allocated per key. */
 static void RLibretroConfigParse(RLibretroConfig *cfg, const char *defaultSection, const char *filename) {
     if (!cfg || !filename) return;
 
-    FILE *f = fopen(filename, "r");
-    if (!f) return;
+    RLibretroConfigStorage *file = RLibretroConfigOpen(cfg, filename);
+    if (!file) return;
 
-    char line[RLCONFIG_LINE_MAX];
-    char section[RLCONFIG_SECTION_MAX] = {0};
-    if (defaultSection) snprintf(section, sizeof(section), "%s", defaultSection);
-
-    while (fgets(line, sizeof(line), f)) {
-        RLibretroConfigTrim(line);
+    /* Keys outside a section, or in an empty-named one, are skipped. */
+    int section = -1;
+    if (defaultSection && defaultSection[0]) {
+        size_t length = strlen(defaultSection);
+        if (length >= RLCONFIG_SECTION_MAX) length = RLCONFIG_SECTION_MAX - 1;
+        section = RLibretroConfigAddSection(cfg, defaultSection, length, true);
+    }
+    char *data = file->data;
+    size_t size = file->size;
+    size_t pos = 0;
+    while (pos < size) {
+        size_t start = pos;
+        while (pos < size && data[pos] != '\n') pos++;
+        size_t end = pos;   /* one past the line */
+        if (pos < size) pos++;
+
+        while (start < end && RLibretroConfigIsSpace(data[start])) start++;
+        while (end > start && RLibretroConfigIsSpace(data[end - 1])) end--;
 
         /* Skip blank lines and comments */
-        if (line[0] == '\0' || line[0] == '#' || line[0] == ';') continue;
+        if (start == end || data[start] == '#' || data[start] == ';') continue;
 
         /* Section header */
-        if (line[0] == '[') {
-            char *end = strchr(line, ']');
-            if (end) {
-                *end = '\0';
-                size_t secLen = (size_t)(end - (line + 1));
-                if (secLen >= sizeof(section)) secLen = sizeof(section) - 1;
-                memcpy(section, line + 1, secLen);
-                section[secLen] = '\0';
-                RLibretroConfigTrim(section);
+        if (data[start] == '[') {
+            char *close = (char*)memchr(data + start, ']', end - start);
+            if (close) {
+                size_t nameStart = start + 1, nameEnd = (size_t)(close - data);
+                while (nameStart < nameEnd && RLibretroConfigIsSpace(data[nameStart])) nameStart++;
+                while (nameEnd > nameStart && RLibretroConfigIsSpace(data[nameEnd - 1])) nameEnd--;
+                if (nameEnd - nameStart >= RLCONFIG_SECTION_MAX) nameEnd = nameStart + RLCONFIG_SECTION_MAX - 1;
+                data[nameEnd] = '\0';
+                section = (nameEnd > nameStart) ? RLibretroConfigAddSection(cfg, data + nameStart, nameEnd - nameStart, false) : -1;
             }
             continue;
         }
 
         /* Key=value */
-        char *eq = strchr(line, '=');
-        if (!eq || section[0] == '\0') continue;
+        char *eq = (char*)memchr(data + start, '=', end - start);
+        if (!eq || section < 0) continue;
 
-        *eq = '\0';
-        char *k = line;
-        char *v = eq + 1;
-        RLibretroConfigTrim(k);
-        RLibretroConfigTrim(v);
+        size_t keyEnd = (size_t)(eq - data);
+        size_t valueStart = keyEnd + 1, valueEnd = end;
+        while (keyEnd > start && RLibretroConfigIsSpace(data[keyEnd - 1])) keyEnd--;
+        while (valueStart < valueEnd && RLibretroConfigIsSpace(data[valueStart])) valueStart++;
+        if (keyEnd == start) continue;
 
         /* Strip surrounding double quotes from the value */
-        size_t vlen = strlen(v);
-        if (vlen >= 2 && v[0] == '"' && v[vlen - 1] == '"') {
-            v[vlen - 1] = '\0';
-            v++;
+        if (valueEnd - valueStart >= 2 && data[valueStart] == '"' && data[valueEnd - 1] == '"') {
+            valueStart++;
+            valueEnd--;
         }
 
-        if (k[0] != '\0') rlconfig_set(cfg, section, k, v);
-    }
+        if (keyEnd - start >= RLCONFIG_KEY_MAX) keyEnd = start + RLCONFIG_KEY_MAX - 1;
+        if (valueEnd - valueStart >= RLCONFIG_VALUE_MAX) valueEnd = valueStart + RLCONFIG_VALUE_MAX - 1;
+        data[keyEnd] = '\0';
 
-    fclose(f);
+        /* The terminator goes where the line's newline or trailing space was.
+           Only a mapped file's last line can end flush with the data; that
+           value is the one copy. */
+        const char *value = data + valueStart;
+        if (valueEnd < size || !file->mapped) {
+            data[valueEnd] = '\0';
+        } else {
+            value = RLibretroConfigIntern(cfg, data + valueStart, valueEnd - valueStart);
+            if (!value) continue;
+        }
+        RLibretroConfigPut(cfg, section, data + start, keyEnd - start, value, valueEnd - valueStart);
+    }
+    cfg->dirty = true;
 }
 
 static RLibretroConfig* rlconfig_load(const char *filename) {
@@ -308,6 +534,7 @@ static RLibretroConfig* rlconfig_load(const char *filename) {
     memset(cfg, 0, sizeof(RLibretroConfig));
 
     RLibretroConfigParse(cfg, NULL, filename);
+    cfg->dirty = false;
     return cfg;
 }
 
@@ -316,36 +543,72 @@ static void rlconfig_load_info(RLibretroConfig *cfg, const char *section, const
     RLibretroConfigParse(cfg, section, filename);
 }
 
+/* Move the written temp file over filename. rename() replaces it atomically
+   on POSIX; Windows' won't replace an existing file, so it's removed first. */
+static bool RLibretroConfigReplaceFile(const char *tempPath, const char *filename) {
+#if defined(_WIN32)
+    remove(filename);
+#endif
+    return rename(tempPath, filename) == 0;
+}
+
+/* Write cfg to filename, grouped by section in first-seen order. Does nothing
+   when cfg is unchanged since it was loaded or last saved. Writes a temp file
+   and renames it into place, so a crash mid-write leaves the old file intact. */
 static bool rlconfig_save(RLibretroConfig *cfg, const char *filename) {
     if (!cfg || !filename) return false;
-
-    FILE *f = fopen(filename, "w");
-    if (!f) return false;
-
-    /* Collect unique section names in insertion order (pointers into entry data — stable). */
-    cvector(const char*) sections = NULL;
-    for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
-        const char *sec = cfg->entries[i]->section;
-        bool found = false;
-        for (size_t s = 0; s < cvector_size(sections); s++) {
-            if (strcmp(sections[s], sec) == 0) { found = true; break; }
+    if (!cfg->dirty) return true;
+
+    /* Chain each section's entries in one pass: first/last entry per section
+       and a next-entry link per entry. Sections are written in the order
+       their first entry appears. */
+    size_t count = cvector_size(cfg->entries);
+    size_t sectionCount = cvector_size(cfg->sections);
+    int *links = (int*)MemAlloc((unsigned int)((count + 3 * sectionCount + 1) * sizeof(int)));
+    if (!links) return false;
+    int *next = links;
+    int *firsts = next + count;
+    int *lasts = firsts + sectionCount;
+    int *order = lasts + sectionCount;
+    int orderCount = 0;
+    for (size_t s = 0; s < sectionCount; s++) firsts[s] = -1;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t s = cfg->entries[i].section;
+        next[i] = -1;
+        if (firsts[s] >= 0) {
+            next[lasts[s]] = (int)i;
+        } else {
+            firsts[s] = (int)i;
+            order[orderCount++] = (int)s;
         }
-        if (!found) cvector_push_back(sections, sec);
+        lasts[s] = (int)i;
     }
 
-    /* Write each section */
-    for (size_t s = 0; s < cvector_size(sections); s++) {
-        fprintf(f, "[%s]\n", sections[s]);
-        for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
-            if (strcmp(cfg->entries[i]->section, sections[s]) == 0) {
-                fprintf(f, "%s=%s\n", cfg->entries[i]->key, cfg->entries[i]->value);
-            }
+    char tempPath[4096];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", filename);
+    FILE *f = fopen(tempPath, "w");
+    bool ok = f != NULL;
+    for (int o = 0; ok && o < orderCount; o++) {
+        fprintf(f, "[%s]\n", cfg->sections[order[o]].name);
+        for (int i = firsts[order[o]]; i >= 0; i = next[i]) {
+            fprintf(f, "%s=%s\n", cfg->entries[i].key, cfg->entries[i].value);
         }
         fprintf(f, "\n");
     }
+    if (f) {
+        ok = !ferror(f) && ok;
+        ok = fclose(f) == 0 && ok;
+    }
+    MemFree(links);
 
-    cvector_free(sections);
-    fclose(f);
+    if (ok) {
+        ok = RLibretroConfigReplaceFile(tempPath, filename);
+    }
+    if (!ok) {
+        remove(tempPath);
+        return false;
+    }
+    cfg->dirty = false;
     return true;
 }
 
@@ -18,6 +18,10 @@
 #include "raylib-libretro-physfs.h"
 #include "raylib-libretro-config.h"
 
+#define HASHMAP_REALLOC(p, s) MemRealloc(p, (unsigned int)s)
+#define HASHMAP_FREE(p)       MemFree(p)
+#include "../vendor/hashmap/hashmap.h"
+
 #include "raylib-libretro-styles.h"
 
 // Maximum number of cores the "Select Core" picker offers for one game file.
@@ -61,9 +65,45 @@ typedef enum LibretroHotkey {
     LIBRETRO_HOTKEY_FAST_FORWARD,
     LIBRETRO_HOTKEY_SLOW_MOTION,
     LIBRETRO_HOTKEY_DISABLE_HOTKEYS,
+    LIBRETRO_HOTKEY_UNDO_STATE,
     LIBRETRO_HOTKEY_COUNT,
 } LibretroHotkey;
 
+// Number of save/load operations the menu can undo.
+#ifndef LIBRETRO_MENU_UNDO_LEVELS
+#define LIBRETRO_MENU_UNDO_LEVELS 10
+#endif
+
+// Memory cap, in bytes, for the (compressed) undo history.
+#ifndef LIBRETRO_MENU_UNDO_MAX_BYTES
+#define LIBRETRO_MENU_UNDO_MAX_BYTES (64 * 1024 * 1024)
+#endif
+
+/**
+ * One serialized state held by a LibretroStateRing.
+ */
+typedef struct LibretroStateRingEntry {
+    void* data;             // MemAlloc'd state, compressed when compressed is set; may be NULL
+    unsigned int size;      // bytes in data
+    unsigned int rawSize;   // bytes once decompressed
+    bool compressed;
+    int tag;                // caller-defined, e.g. which save slot the state came from
+} LibretroStateRingEntry;
+
+/**
+ * Bounded ring of serialized states, shared by rewind and the save state undo
+ * history. When full, or over maxBytes, the oldest entries are dropped.
+ */
+typedef struct LibretroStateRing {
+    LibretroStateRingEntry* entries;
+    int capacity;           // maximum number of entries
+    int head;               // next write index
+    int count;              // number of valid entries stored
+    size_t bytes;           // bytes held across all entries
+    size_t maxBytes;        // 0 for no cap
+    bool compress;          // CompressData() each pushed state
+} LibretroStateRing;
+
 typedef struct {
     char path[256];
     char displayName[256];
@@ -75,6 +115,29 @@ typedef struct {
     bool needsFullpath;
 } LibretroCoreInfo;
 
+/**
+ * The cores in LibretroMenu::coreInfos that list one extension.
+ */
+typedef struct LibretroCoreExtBucket {
+    char ext[32];                   // lower-case, no dot; the lookup key points here
+    cvector(int) cores;             // indices into coreInfos, ascending
+} LibretroCoreExtBucket;
+
+/* Hashmap type: lower-case extension → index into LibretroCoreExtIndex::buckets */
+HASHMAP_DECLARE_STRING(LibretroCoreExtLookup, libretrocoreextlookup, int)
+
+/**
+ * Extension → core inverted index over LibretroMenu::coreInfos, grown as
+ * cores are added, so matching a file doesn't walk every core's list.
+ */
+typedef struct LibretroCoreExtIndex {
+    cvector(LibretroCoreExtBucket*) buckets; // individually allocated, so lookup keys stay put
+    LibretroCoreExtLookup lookup;
+    char* filter;                   // ".zip;.ext1;.ext2" for the Load Game browser, NULL when empty
+    size_t filterLength;
+    size_t filterCapacity;
+} LibretroCoreExtIndex;
+
 typedef struct LibretroMenu {
     struct nk_context* ctx;
     Font font;
@@ -105,8 +168,9 @@ typedef struct LibretroMenu {
     int saveSlotIndex;
     float fastForwardSpeed;
     float slowMotionSpeed;
-    int optionSelectedIndices[LIBRETRO_MAX_CORE_VARIABLES];    // per-option combobox index
-    nk_bool optionCheckboxValues[LIBRETRO_MAX_CORE_VARIABLES]; // per-option checkbox state for enabled/disabled options
+    int* optionSelectedIndices;           // per-option combobox index, optionStateCapacity entries
+    nk_bool* optionCheckboxValues;        // per-option checkbox state for enabled/disabled options
+    unsigned optionStateCapacity;
     char loadGamePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
     bool touchControls;
     bool touchHapticsEnabled;
@@ -114,6 +178,11 @@ typedef struct LibretroMenu {
     nk_bool disableHotKeysActive; // Disable HotKeys: pass all keys to the core, suspend frontend hotkeys.
     int sramAutoSaveIndex; // combobox index for the SRAM auto-save interval (Off / 15s / 30s / 60s / 2min / 5min / 10min)
     float sramAutoSaveAccumulator; // seconds since the last successful auto-save
+    uint64_t sramPersistedHash;   // GetLibretroDataHash() of the SRAM last written to (or read from) sramPersistedPath
+    char sramPersistedPath[RAYLIB_LIBRETRO_VFS_MAX_PATH]; // .srm the hash belongs to; empty when nothing is known to be on disk
+    unsigned int sramWritesPerformed; // SRAM saves that hit the disk
+    unsigned int sramWritesSkipped;   // SRAM saves skipped because the data matched what was already on disk
+    nk_bool sramMemoryMapped;         // mirror SRAM into a memory-mapped .srm instead of rewriting it (POSIX only)
     int orientationIndex;                 // Android screen orientation: 0 = Landscape, 1 = Portrait, 2 = Auto
     nk_bool hideCursor;
     nk_bool lockCursor;
@@ -133,12 +202,20 @@ typedef struct LibretroMenu {
     char aboutExtensions[256];
     nk_rune keyboardControls[RETRO_DEVICE_ID_JOYPAD_R3 + 1];
     cvector(LibretroCoreInfo*) coreInfos;
+    LibretroCoreExtIndex coreExtIndex;    // extension → coreInfos indices, kept in step with coreInfos
+    nk_console* availableCoresTree;       // About > Available Cores, rebuilt as the core scan fills coreInfos
     nk_console* corePickerMenu;
     char pendingGamePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char loadingGamePath[RAYLIB_LIBRETRO_VFS_MAX_PATH]; // content being read in the background, empty when none
     char pendingCorePaths[LIBRETRO_MAX_GAME_CORES][512];
     char pendingCoreNames[LIBRETRO_MAX_GAME_CORES][128]; // stable picker button labels (GetFileNameWithoutExt reuses a shared static buffer)
     int pendingCoreCount;                 // >0 requests the core picker on the next menu update (deferred past the file browser's navigate_back)
     RLibretroConfig* cfg;                 // persistent config, owned for the lifetime of the menu
+    LibretroStateRing undoHistory;        // states replaced by Save State / Load State, newest last
+    nk_console* undoStateButton;
+    char screenshotPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];  // last path handed out by LibretroMenuNextScreenshotPath()
+    char screenshotPrefix[RAYLIB_LIBRETRO_VFS_MAX_PATH]; // "<dir>/<content>" the cached index below belongs to
+    int screenshotNextIndex;              // next free "<content>-N.png" number, 0 until the directory was scanned
 } LibretroMenu;
 
 #if defined(__cplusplus)
@@ -155,6 +232,13 @@ void ToggleLibretroMenu(void);    // Toggle menu visibility.
 bool IsLibretroMenuShown(void);   // Returns true if the menu is currently visible.
 void BuildLibretroMenuOptions(LibretroMenu* menu); // Populate "Core Options" with comboboxes from the loaded core.
 void BuildLibretroMenuControllers(LibretroMenu* menu); // Populate "Controllers" with per-port device comboboxes.
+static bool InitLibretroStateRing(LibretroStateRing* ring, int capacity, size_t maxBytes, bool compress); // Allocate a ring of capacity states.
+static bool LibretroStateRingPush(LibretroStateRing* ring, void* data, unsigned int size, int tag); // Store a state; takes ownership of data.
+static bool LibretroStateRingPop(LibretroStateRing* ring, void** data, unsigned int* size, int* tag); // Take the newest state; caller MemFree()s data.
+static void ClearLibretroStateRing(LibretroStateRing* ring);   // Drop every stored state.
+static const char* LibretroMenuNextScreenshotPath(void);        // Path for the next "<content>-N.png" screenshot.
+static bool LibretroMenuQueueScreenshot(const char* path, int maxWidth); // Capture the frame and encode it to path in the background.
+static void UnloadLibretroStateRing(LibretroStateRing* ring);  // Drop every stored state and free the ring.
 bool LoadLibretroCoreOptions(void);    // Apply saved core options from config to the loaded core.
 bool SaveLibretroAllSettings(void);    // Save menu settings + core options in a single file write.
 static bool SaveLibretroPortDevices(void); // Persist per-port device selections for the loaded core.
@@ -171,6 +255,8 @@ static Font GetLibretroMenuFont(void);
 #ifndef RAYLIB_LIBRETRO_MENU_IMPLEMENTATION_ONCE
 #define RAYLIB_LIBRETRO_MENU_IMPLEMENTATION_ONCE
 
+HASHMAP_DEFINE_STRING(LibretroCoreExtLookup, libretrocoreextlookup, int)
+
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -288,6 +374,37 @@ static nk_bool nk_console_file_add_files_android(nk_console* console, const char
 #define RAYLIB_LIBRETRO_CFG_FILE "raylib-libretro.cfg"
 #endif
 
+// Memory-mapped .srm files need POSIX mmap(). Emscripten's MEMFS has no real
+// backing file, so it keeps the SaveFileData() path.
+#if !defined(__EMSCRIPTEN__) && !defined(PLATFORM_WEB) && !defined(_WIN32)
+#define RAYLIB_LIBRETRO_MENU_SRAM_MMAP
+#include <sys/mman.h> // mmap(), msync(), munmap()
+#include <sys/stat.h> // fstat()
+#include <fcntl.h>    // open()
+#include <unistd.h>   // ftruncate(), close()
+#endif
+
+// Cores without a .info are probed by the raylib-libretro-probe helper, so
+// their dlopen() and retro_get_system_info() never touch this process. It's
+// spawned rather than forked: a bare fork() of this multi-threaded process
+// could inherit a lock another thread held and hang. Without the helper, and
+// on Android, Windows and the web, cores are probed in-process.
+#if !defined(__EMSCRIPTEN__) && !defined(PLATFORM_WEB) && !defined(_WIN32) && !defined(__ANDROID__) && !defined(PLATFORM_ANDROID)
+#define RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+#include <sys/types.h>
+#include <sys/wait.h> // waitpid()
+#include <signal.h>   // kill()
+#include <fcntl.h>    // fcntl()
+#include <spawn.h>    // posix_spawn()
+#include <unistd.h>   // pipe(), read()
+#include <errno.h>
+extern char** environ;
+#endif
+
+#ifdef HAVE_THREADS
+#include <rthreads/rthreads.h>
+#endif
+
 /**
  * The version is set by a define, defaults to DEV.
  */
@@ -442,6 +559,12 @@ static LibretroMenu menu = {
             .key = NK_CONSOLE_KEY_NONE,
             .gamepad = NK_GAMEPAD_BUTTON_INVALID
         },
+        [LIBRETRO_HOTKEY_UNDO_STATE] = {
+            .name = "Undo State",
+            .defaultKey = NK_CONSOLE_KEY_NONE,
+            .key = NK_CONSOLE_KEY_NONE,
+            .gamepad = NK_GAMEPAD_BUTTON_INVALID
+        },
     },
 };
 
@@ -755,6 +878,547 @@ static void LibretroMenuQuitClicked(nk_console* widget, void* user_data) {
     menu.shouldQuit = true;
 }
 
+/**
+ * Allocate a state ring.
+ *
+ * @param capacity Maximum number of states held at once.
+ * @param maxBytes Cap on the bytes held across all states, or 0 for no cap.
+ * @param compress Whether to CompressData() states as they are pushed. Saves
+ *                 memory for rarely-restored states; leave it off for rewind.
+ * @return true if the ring was allocated.
+ */
+static bool InitLibretroStateRing(LibretroStateRing* ring, int capacity, size_t maxBytes, bool compress) {
+    if (ring == NULL || capacity <= 0) return false;
+    memset(ring, 0, sizeof(LibretroStateRing));
+    ring->entries = (LibretroStateRingEntry*)MemAlloc((unsigned int)(sizeof(LibretroStateRingEntry) * (size_t)capacity));
+    if (ring->entries == NULL) return false;
+    ring->capacity = capacity;
+    ring->maxBytes = maxBytes;
+    ring->compress = compress;
+    return true;
+}
+
+/**
+ * Free the oldest entry in the ring.
+ */
+static void LibretroStateRingDropOldest(LibretroStateRing* ring) {
+    if (ring->count <= 0) return;
+    int oldest = (ring->head - ring->count + ring->capacity) % ring->capacity;
+    LibretroStateRingEntry* entry = &ring->entries[oldest];
+    if (entry->data != NULL) MemFree(entry->data);
+    ring->bytes -= entry->size;
+    memset(entry, 0, sizeof(LibretroStateRingEntry));
+    ring->count--;
+}
+
+/**
+ * Push a state onto the ring, dropping the oldest ones to stay within the
+ * capacity and byte cap.
+ *
+ * @param data A MemAlloc'd state, which the ring takes ownership of. May be
+ *             NULL to record "no state" (e.g. a save slot that was empty).
+ * @param size Bytes in @p data.
+ * @param tag Caller-defined value returned by LibretroStateRingPop().
+ * @return true if the state was stored; false if the ring is not initialized.
+ */
+static bool LibretroStateRingPush(LibretroStateRing* ring, void* data, unsigned int size, int tag) {
+    if (ring == NULL || ring->entries == NULL) {
+        if (data != NULL) MemFree(data);
+        return false;
+    }
+
+    LibretroStateRingEntry entry = { data, size, size, false, tag };
+    if (ring->compress && data != NULL && size > 0) {
+        int compressedSize = 0;
+        unsigned char* compressed = CompressData((const unsigned char*)data, (int)size, &compressedSize);
+        if (compressed != NULL && compressedSize > 0 && (unsigned int)compressedSize < size) {
+            MemFree(data);
+            entry.data = compressed;
+            entry.size = (unsigned int)compressedSize;
+            entry.compressed = true;
+        } else if (compressed != NULL) {
+            MemFree(compressed);
+        }
+    }
+
+    if (ring->count >= ring->capacity) {
+        LibretroStateRingDropOldest(ring);
+    }
+    while (ring->maxBytes > 0 && ring->count > 0 && ring->bytes + entry.size > ring->maxBytes) {
+        LibretroStateRingDropOldest(ring);
+    }
+
+    ring->entries[ring->head] = entry;
+    ring->bytes += entry.size;
+    ring->head = (ring->head + 1) % ring->capacity;
+    ring->count++;
+    return true;
+}
+
+/**
+ * Pop the newest state off the ring.
+ *
+ * @param data Receives the decompressed state, to be freed with MemFree(). May
+ *             be set to NULL when a NULL state was pushed.
+ * @param size Receives the byte size of @p data.
+ * @param tag Optionally receives the tag the state was pushed with.
+ * @return false if the ring is empty or the state failed to decompress.
+ */
+static bool LibretroStateRingPop(LibretroStateRing* ring, void** data, unsigned int* size, int* tag) {
+    if (ring == NULL || ring->count <= 0 || data == NULL || size == NULL) return false;
+    ring->head = (ring->head - 1 + ring->capacity) % ring->capacity;
+    ring->count--;
+
+    LibretroStateRingEntry entry = ring->entries[ring->head];
+    memset(&ring->entries[ring->head], 0, sizeof(LibretroStateRingEntry));
+    ring->bytes -= entry.size;
+    if (tag != NULL) *tag = entry.tag;
+
+    if (entry.compressed) {
+        int rawSize = 0;
+        unsigned char* raw = DecompressData((const unsigned char*)entry.data, (int)entry.size, &rawSize);
+        MemFree(entry.data);
+        if (raw == NULL || (unsigned int)rawSize != entry.rawSize) {
+            if (raw != NULL) MemFree(raw);
+            TraceLog(LOG_WARNING, "MENU: Failed to decompress stored state");
+            return false;
+        }
+        *data = raw;
+        *size = (unsigned int)rawSize;
+        return true;
+    }
+
+    *data = entry.data;
+    *size = entry.size;
+    return true;
+}
+
+static void ClearLibretroStateRing(LibretroStateRing* ring) {
+    if (ring == NULL || ring->entries == NULL) return;
+    while (ring->count > 0) {
+        LibretroStateRingDropOldest(ring);
+    }
+    ring->head = 0;
+    ring->bytes = 0;
+}
+
+static void UnloadLibretroStateRing(LibretroStateRing* ring) {
+    if (ring == NULL) return;
+    ClearLibretroStateRing(ring);
+    if (ring->entries != NULL) MemFree(ring->entries);
+    memset(ring, 0, sizeof(LibretroStateRing));
+}
+
+// Screenshots and save state thumbnails waiting to be encoded at once; further
+// requests are dropped rather than stalling the main thread.
+#ifndef LIBRETRO_MENU_IMAGE_QUEUE_SIZE
+#define LIBRETRO_MENU_IMAGE_QUEUE_SIZE 8
+#endif
+
+// Hardware frames whose GPU readback is still in flight; further captures
+// read back synchronously.
+#ifndef LIBRETRO_MENU_READBACK_QUEUE_SIZE
+#define LIBRETRO_MENU_READBACK_QUEUE_SIZE 4
+#endif
+
+// Width save state thumbnails are downscaled to.
+#ifndef LIBRETRO_MENU_THUMBNAIL_WIDTH
+#define LIBRETRO_MENU_THUMBNAIL_WIDTH 320
+#endif
+
+/**
+ * A captured frame waiting to be scaled, encoded and written.
+ */
+typedef struct LibretroMenuImageJob {
+    Image image;            // raw frame from LoadImageFromLibretroEx()
+    int displayWidth;
+    int rotation;
+    int maxWidth;           // downscale to this width, or 0 to keep the full size
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+} LibretroMenuImageJob;
+
+/**
+ * Queue of frames handed from the main thread to the image encoding worker.
+ * The worker only reports failures back; the main thread picks them up in
+ * UpdateLibretroMenu(), since it owns the OSD message.
+ */
+typedef struct LibretroMenuImageWriter {
+    LibretroMenuImageJob jobs[LIBRETRO_MENU_IMAGE_QUEUE_SIZE];
+    int head;               // next job to encode
+    int count;              // jobs waiting
+    char failedPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];  // last path that failed to write, empty if none
+#ifdef HAVE_THREADS
+    sthread_t* thread;
+    slock_t* lock;
+    scond_t* cond;          // signalled when a job is queued, broadcast when one is written
+    bool busy;              // a job is being encoded
+    bool quit;
+#endif
+} LibretroMenuImageWriter;
+
+static LibretroMenuImageWriter menuImageWriter;
+
+/**
+ * A hardware frame being read back from the GPU, to queue for encoding once it arrives.
+ */
+typedef struct LibretroMenuPendingReadback {
+    LibretroFrameReadback readback;
+    int maxWidth;
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+} LibretroMenuPendingReadback;
+
+static LibretroMenuPendingReadback menuPendingReadbacks[LIBRETRO_MENU_READBACK_QUEUE_SIZE];
+
+/**
+ * Scale, encode and write one captured frame.
+ *
+ * Runs on the worker thread, so it sticks to raylib functions that don't touch
+ * the GPU or the shared TextFormat()/TextToLower() buffers: ExportImage() is
+ * avoided because of its IsFileExtension() check.
+ */
+static bool MenuEncodeImageJob(LibretroMenuImageJob* job) {
+    FinishLibretroImage(&job->image, job->displayWidth, job->rotation);
+    if (job->maxWidth > 0 && job->image.width > job->maxWidth) {
+        int height = (int)((float)job->image.height * (float)job->maxWidth / (float)job->image.width + 0.5f);
+        ImageResize(&job->image, job->maxWidth, height > 0 ? height : 1);
+    }
+
+    int fileSize = 0;
+    unsigned char* fileData = ExportImageToMemory(job->image, ".png", &fileSize);
+    bool ok = fileData != NULL && SaveFileData(job->path, fileData, fileSize);
+    if (fileData != NULL) MemFree(fileData);
+    UnloadImage(job->image);
+    job->image.data = NULL;
+    return ok;
+}
+
+#ifdef HAVE_THREADS
+/**
+ * Worker that drains menuImageWriter. On quit it finishes the queued jobs
+ * first, so nothing the user asked for is lost at shutdown.
+ */
+static void MenuImageWriterThread(void* userData) {
+    LibretroMenuImageWriter* writer = (LibretroMenuImageWriter*)userData;
+    slock_lock(writer->lock);
+    for (;;) {
+        while (writer->count == 0 && !writer->quit) {
+            scond_wait(writer->cond, writer->lock);
+        }
+        if (writer->count == 0) break;
+
+        LibretroMenuImageJob job = writer->jobs[writer->head];
+        writer->head = (writer->head + 1) % LIBRETRO_MENU_IMAGE_QUEUE_SIZE;
+        writer->count--;
+        writer->busy = true;
+        slock_unlock(writer->lock);
+
+        bool ok = MenuEncodeImageJob(&job);
+
+        slock_lock(writer->lock);
+        if (!ok) TextCopy(writer->failedPath, job.path);
+        writer->busy = false;
+        scond_broadcast(writer->cond);
+    }
+    slock_unlock(writer->lock);
+}
+#endif
+
+/**
+ * Hand a captured frame to the image worker. Takes ownership of @p image.
+ * Without thread support the frame is encoded right away.
+ *
+ * @return false if the queue is full and the frame was dropped.
+ */
+static bool MenuQueueImageWrite(Image image, int displayWidth, int rotation, int maxWidth, const char* path) {
+    LibretroMenuImageJob job = { image, displayWidth, rotation, maxWidth, {0} };
+    TextCopy(job.path, path);
+
+#ifdef HAVE_THREADS
+    if (menuImageWriter.thread == NULL && menuImageWriter.lock == NULL) {
+        menuImageWriter.lock = slock_new();
+        menuImageWriter.cond = scond_new();
+        if (menuImageWriter.lock != NULL && menuImageWriter.cond != NULL) {
+            menuImageWriter.thread = sthread_create(MenuImageWriterThread, &menuImageWriter);
+        }
+        if (menuImageWriter.thread == NULL) {
+            TraceLog(LOG_WARNING, "MENU: Image writer thread unavailable, encoding on the main thread");
+        }
+    }
+
+    if (menuImageWriter.thread != NULL) {
+        slock_lock(menuImageWriter.lock);
+        bool queued = menuImageWriter.count < LIBRETRO_MENU_IMAGE_QUEUE_SIZE;
+        if (queued) {
+            int tail = (menuImageWriter.head + menuImageWriter.count) % LIBRETRO_MENU_IMAGE_QUEUE_SIZE;
+            menuImageWriter.jobs[tail] = job;
+            menuImageWriter.count++;
+            scond_signal(menuImageWriter.cond);
+        }
+        slock_unlock(menuImageWriter.lock);
+        if (!queued) {
+            TraceLog(LOG_WARNING, "MENU: Image queue full, dropping %s", path);
+            UnloadImage(image);
+        }
+        return queued;
+    }
+#endif
+
+    bool ok = MenuEncodeImageJob(&job);
+    LibretroFlushPersistentStorage();
+    if (!ok) TextCopy(menuImageWriter.failedPath, path);
+    return true;
+}
+
+/**
+ * Hand frames whose GPU readback has arrived to the image worker.
+ *
+ * @param wait Block until every readback arrives, e.g. at shutdown.
+ */
+static void MenuPollFrameReadbacks(bool wait) {
+    for (int i = 0; i < LIBRETRO_MENU_READBACK_QUEUE_SIZE; i++) {
+        LibretroMenuPendingReadback* pending = &menuPendingReadbacks[i];
+        if (pending->readback.buffer == 0) continue;
+
+        Image image = {0};
+        int displayWidth = 0;
+        int rotation = 0;
+        if (!PollLibretroFrameReadback(&pending->readback, wait, &image, &displayWidth, &rotation)) continue;
+        if (image.data == NULL) {
+            TraceLog(LOG_WARNING, "MENU: Failed to read back image %s", pending->path);
+            SetLibretroMessage(TextFormat("Screenshot failed: %s", pending->path), 2.0);
+            continue;
+        }
+        MenuQueueImageWrite(image, displayWidth, rotation, pending->maxWidth, pending->path);
+    }
+}
+
+/**
+ * Queue arrived readbacks, and report image writes that failed on the worker.
+ * Called every menu update.
+ */
+static void MenuPollImageWriter(void) {
+    MenuPollFrameReadbacks(false);
+    if (menuImageWriter.failedPath[0] == '\0') return;
+
+    char failedPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+#ifdef HAVE_THREADS
+    if (menuImageWriter.lock != NULL) slock_lock(menuImageWriter.lock);
+#endif
+    TextCopy(failedPath, menuImageWriter.failedPath);
+    menuImageWriter.failedPath[0] = '\0';
+#ifdef HAVE_THREADS
+    if (menuImageWriter.lock != NULL) slock_unlock(menuImageWriter.lock);
+#endif
+
+    TraceLog(LOG_WARNING, "MENU: Failed to write image %s", failedPath);
+    SetLibretroMessage(TextFormat("Screenshot failed: %s", failedPath), 2.0);
+}
+
+/**
+ * Block until every captured frame is written, e.g. before touching a file
+ * one of them may still be headed for.
+ */
+static void MenuFlushImageWriter(void) {
+    MenuPollFrameReadbacks(true);
+#ifdef HAVE_THREADS
+    if (menuImageWriter.thread == NULL) return;
+    slock_lock(menuImageWriter.lock);
+    while (menuImageWriter.count > 0 || menuImageWriter.busy) {
+        scond_wait(menuImageWriter.cond, menuImageWriter.lock);
+    }
+    slock_unlock(menuImageWriter.lock);
+#endif
+}
+
+/**
+ * Finish any queued image writes and stop the worker.
+ */
+static void MenuCloseImageWriter(void) {
+    MenuPollFrameReadbacks(true);
+#ifdef HAVE_THREADS
+    if (menuImageWriter.thread != NULL) {
+        slock_lock(menuImageWriter.lock);
+        menuImageWriter.quit = true;
+        scond_signal(menuImageWriter.cond);
+        slock_unlock(menuImageWriter.lock);
+        sthread_join(menuImageWriter.thread);
+    }
+    if (menuImageWriter.cond != NULL) scond_free(menuImageWriter.cond);
+    if (menuImageWriter.lock != NULL) slock_free(menuImageWriter.lock);
+#endif
+    memset(&menuImageWriter, 0, sizeof(menuImageWriter));
+}
+
+/**
+ * Capture the current frame and write it to @p path as a PNG in the
+ * background. Only the framebuffer copy happens on the calling thread.
+ * Hardware frames are read back from the GPU asynchronously where GL allows,
+ * and queued once MenuPollImageWriter() sees them arrive.
+ *
+ * @param path Destination file. When it came from LibretroMenuNextScreenshotPath(),
+ * the next screenshot gets the next index.
+ * @param maxWidth Downscale to this width, or 0 to keep the full size.
+ *
+ * @return true if the frame was captured and queued.
+ */
+static bool LibretroMenuQueueScreenshot(const char* path, int maxWidth) {
+    bool queued = false;
+    for (int i = 0; i < LIBRETRO_MENU_READBACK_QUEUE_SIZE; i++) {
+        LibretroMenuPendingReadback* pending = &menuPendingReadbacks[i];
+        if (pending->readback.buffer != 0) continue;
+        if (BeginLibretroFrameReadback(&pending->readback)) {
+            pending->maxWidth = maxWidth;
+            TextCopy(pending->path, path);
+            queued = true;
+        }
+        break;
+    }
+
+    if (!queued) {
+        int displayWidth = 0;
+        int rotation = 0;
+        Image image = LoadImageFromLibretroEx(&displayWidth, &rotation);
+        if (image.data == NULL) return false;
+        queued = MenuQueueImageWrite(image, displayWidth, rotation, maxWidth, path);
+    }
+
+    // Only use up the index once the screenshot is on its way.
+    if (queued && TextIsEqual(path, menu.screenshotPath)) {
+        menu.screenshotNextIndex++;
+    }
+    return queued;
+}
+
+/**
+ * Path for the next screenshot, "<saves>/<content>-N.png".
+ *
+ * The directory is scanned once per content to find the highest N in use;
+ * after that the index is just incremented, instead of probing FileExists()
+ * for every candidate on each press. It's incremented by
+ * LibretroMenuQueueScreenshot() once the screenshot is queued, so a failed
+ * capture doesn't leave a gap.
+ */
+static const char* LibretroMenuNextScreenshotPath(void) {
+    const char* screenshotsDir = GetLibretroDirectory(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY);
+    const char* contentName = GetLibretroContentName();
+    const char* baseName = (contentName && contentName[0] != '\0') ? contentName : "screenshot";
+
+    const char* prefix = TextFormat("%s/%s", screenshotsDir, baseName);
+    if (menu.screenshotNextIndex <= 0 || !TextIsEqual(menu.screenshotPrefix, prefix)) {
+        TextCopy(menu.screenshotPrefix, prefix);
+        menu.screenshotNextIndex = 1;
+
+        size_t baseLength = TextLength(baseName);
+        FilePathList files = LoadDirectoryFilesEx(screenshotsDir, ".png", false);
+        for (unsigned int i = 0; i < files.count; i++) {
+            const char* name = GetFileNameWithoutExt(files.paths[i]);
+            if (strncmp(name, baseName, baseLength) != 0 || name[baseLength] != '-') continue;
+            const char* digits = name + baseLength + 1;
+            if (*digits == '\0') continue;
+            int index = 0;
+            while (*digits >= '0' && *digits <= '9') {
+                index = index * 10 + (*digits - '0');
+                digits++;
+            }
+            if (*digits == '\0' && index >= menu.screenshotNextIndex) {
+                menu.screenshotNextIndex = index + 1;
+            }
+        }
+        UnloadDirectoryFiles(files);
+    }
+
+    TextCopy(menu.screenshotPath, TextFormat("%s-%i.png", menu.screenshotPrefix, menu.screenshotNextIndex));
+    return menu.screenshotPath;
+}
+
+// Undo history tags. Non-negative tags are save slot indices whose previous
+// state file and thumbnail are stored (see LibretroMenuUndoSlot);
+// LIBRETRO_MENU_UNDO_LOAD stores the state that was running before a Load State.
+#define LIBRETRO_MENU_UNDO_LOAD -1
+
+/**
+ * Path of the save state file for the given zero-based slot.
+ */
+static const char* LibretroMenuStatePath(int slot) {
+    const char* savesDir = GetLibretroDirectory(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY);
+    return TextFormat("%s/%s_%02d.sav", savesDir, GetLibretroContentName(), slot + 1);
+}
+
+/**
+ * Thumbnail path for a save state file, e.g. "Game_01.png" for "Game_01.sav".
+ */
+static const char* LibretroMenuThumbnailPath(const char* statePath) {
+    return TextFormat("%s.png", TextSubtext(statePath, 0, TextLength(statePath) - 4));
+}
+
+/**
+ * What a Save State undo entry holds: the slot's previous state file and its
+ * thumbnail, stored back to back after this header. A size of 0 means the
+ * file wasn't there. An entry with neither is stored as a NULL state.
+ */
+typedef struct LibretroMenuUndoSlot {
+    unsigned int stateSize;
+    unsigned int thumbnailSize;
+} LibretroMenuUndoSlot;
+
+/**
+ * Pack a slot's previous state and the thumbnail at @p thumbnailPath into an
+ * undo entry. *data is NULL when there's neither.
+ *
+ * @return false if the entry couldn't be allocated.
+ */
+static bool LibretroMenuPackUndoSlot(const void* state, unsigned int stateSize, const char* thumbnailPath, void** data, unsigned int* size) {
+    *data = NULL;
+    *size = 0;
+    int thumbnailSize = 0;
+    unsigned char* thumbnail = NULL;
+    if (FileExists(thumbnailPath) && GetFileLength(thumbnailPath) > 0) {
+        thumbnail = LoadFileData(thumbnailPath, &thumbnailSize);
+        if (thumbnail == NULL) {
+            TraceLog(LOG_WARNING, "LIBRETRO: Failed to read %s, undo will remove it", thumbnailPath);
+            thumbnailSize = 0;
+        }
+    }
+    if (state == NULL) stateSize = 0;
+    if (stateSize == 0 && thumbnailSize == 0) return true;
+
+    LibretroMenuUndoSlot header = { stateSize, (unsigned int)thumbnailSize };
+    unsigned char* packed = (unsigned char*)MemAlloc((unsigned int)sizeof(header) + stateSize + (unsigned int)thumbnailSize);
+    if (packed != NULL) {
+        memcpy(packed, &header, sizeof(header));
+        if (stateSize > 0) memcpy(packed + sizeof(header), state, stateSize);
+        if (thumbnailSize > 0) memcpy(packed + sizeof(header) + stateSize, thumbnail, (size_t)thumbnailSize);
+        *data = packed;
+        *size = (unsigned int)sizeof(header) + stateSize + (unsigned int)thumbnailSize;
+    }
+    if (thumbnail != NULL) UnloadFileData(thumbnail);
+    return packed != NULL;
+}
+
+// Write a file back, or remove it when it wasn't there (size 0).
+static bool LibretroMenuRestoreFile(const char* path, const unsigned char* data, unsigned int size) {
+    if (size > 0) return SaveFileData(path, (void*)data, (int)size);
+    return !FileExists(path) || remove(path) == 0;
+}
+
+/**
+ * Put a slot's state file and thumbnail back from an undo entry.
+ */
+static bool LibretroMenuRestoreUndoSlot(int slot, const void* data, unsigned int size) {
+    LibretroMenuUndoSlot header = { 0, 0 };
+    if (data != NULL) {
+        if (size < sizeof(header)) return false;
+        memcpy(&header, data, sizeof(header));
+        if ((size_t)header.stateSize + header.thumbnailSize != size - sizeof(header)) return false;
+    }
+    const unsigned char* state = (data != NULL) ? (const unsigned char*)data + sizeof(header) : NULL;
+    const unsigned char* thumbnail = (data != NULL) ? state + header.stateSize : NULL;
+    char statePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    TextCopy(statePath, LibretroMenuStatePath(slot));
+    bool ok = LibretroMenuRestoreFile(statePath, state, header.stateSize);
+    return LibretroMenuRestoreFile(LibretroMenuThumbnailPath(statePath), thumbnail, header.thumbnailSize) && ok;
+}
+
 static void LibretroMenuSaveStateClicked(nk_console* widget, void* user_data) {
     (void)widget;
     (void)user_data;
@@ -762,9 +1426,50 @@ static void LibretroMenuSaveStateClicked(nk_console* widget, void* user_data) {
     unsigned int size;
     void* saveData = GetLibretroSerializedData(&size);
     if (saveData != NULL) {
-        const char* savesDir = GetLibretroDirectory(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY);
-        SaveFileData(TextFormat("%s/%s_%02d.sav", savesDir, GetLibretroContentName(), menu.saveSlotIndex + 1), saveData, (int)size);
+        char statePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+        TextCopy(statePath, LibretroMenuStatePath(menu.saveSlotIndex));
+
+        // Keep what the slot held so the save can be undone. An empty slot is
+        // recorded as a NULL state, which undo turns back into no file. A slot
+        // that can't be read isn't overwritten, since undo couldn't restore it.
+        // LoadFileData() fails on empty files, which have nothing to lose.
+        int previousSize = 0;
+        unsigned char* previous = NULL;
+        if (FileExists(statePath) && GetFileLength(statePath) > 0) {
+            previous = LoadFileData(statePath, &previousSize);
+            if (previous == NULL) {
+                TraceLog(LOG_WARNING, "LIBRETRO: Failed to read %s, not overwriting it", statePath);
+                MemFree(saveData);
+                SetLibretroMessage("State Saved Failed", 2.0);
+                return;
+            }
+        }
+        // Its thumbnail goes with it, once an earlier save's is written.
+        char thumbnailPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+        TextCopy(thumbnailPath, LibretroMenuThumbnailPath(statePath));
+        MenuFlushImageWriter();
+        void* undo = NULL;
+        unsigned int undoSize = 0;
+        bool packed = LibretroMenuPackUndoSlot(previous, (unsigned int)previousSize, thumbnailPath, &undo, &undoSize);
+        if (previous != NULL) UnloadFileData(previous);
+        if (!packed) {
+            MemFree(saveData);
+            SetLibretroMessage("State Saved Failed", 2.0);
+            return;
+        }
+
+        bool saved = SaveFileData(statePath, saveData, (int)size);
         MemFree(saveData);
+        if (!saved) {
+            if (undo != NULL) MemFree(undo);
+            SetLibretroMessage("State Saved Failed", 2.0);
+            return;
+        }
+        LibretroStateRingPush(&menu.undoHistory, undo, undoSize, menu.saveSlotIndex);
+
+        // Thumbnail alongside the state, e.g. "Game_01.png" for "Game_01.sav".
+        LibretroMenuQueueScreenshot(thumbnailPath, LIBRETRO_MENU_THUMBNAIL_WIDTH);
+
         LibretroFlushPersistentStorage();
         SetLibretroMessage(TextFormat("Slot %d Saved", menu.saveSlotIndex + 1), 2.0);
         HideLibretroMenu();
@@ -843,31 +1548,775 @@ static void MenuDirChanged(nk_console* widget, void* user_data) {
     LibretroMenuEnsureSaveDir();
 }
 
-static void MenuCoreDirChanged(nk_console* widget, void* user_data) {
-    MenuDirChanged(widget, user_data);
-    ScanLibretroCoreDirectory();
-}
+static void MenuCoreDirChanged(nk_console* widget, void* user_data) {
+    MenuDirChanged(widget, user_data);
+    ScanLibretroCoreDirectory();
+}
+
+static void MenuContentDirChanged(nk_console* widget, void* user_data) {
+    MenuDirChanged(widget, user_data);
+#ifndef __EMSCRIPTEN__
+    if (menu.loadGameWidget && LIBRETRO.fileBrowserStartDirectory[0] != '\0') {
+        nk_console_file_set_directory(menu.loadGameWidget, LIBRETRO.fileBrowserStartDirectory);
+    }
+#endif
+}
+
+static bool IsLibretroCoreFile(const char* path) {
+    const char* ext = GetFileExtension(path);
+    return TextIsEqual(ext, ".so") || TextIsEqual(ext, ".dll") || TextIsEqual(ext, ".dylib") || TextIsEqual(ext, ".wasm");
+}
+
+static void FreeLibretroCoreExtIndex(LibretroCoreExtIndex* index) {
+    for (size_t i = 0; i < cvector_size(index->buckets); i++) {
+        cvector_free(index->buckets[i]->cores);
+        MemFree(index->buckets[i]);
+    }
+    cvector_free(index->buckets);
+    libretrocoreextlookup_free(&index->lookup);
+    MemFree(index->filter);
+    memset(index, 0, sizeof(*index));
+}
+
+/**
+ * @return The cores that list @p extLower (lower-case, no dot), or NULL if none does.
+ */
+static LibretroCoreExtBucket* LibretroCoreExtIndexFind(LibretroCoreExtIndex* index, const char* extLower) {
+    int bucket = -1;
+    if (!extLower || !extLower[0]) return NULL;
+    if (!libretrocoreextlookup_get(&index->lookup, extLower, &bucket) || bucket < 0) return NULL;
+    return index->buckets[bucket];
+}
+
+// Append ".ext" to the browser filter, separated by ';'.
+static void LibretroCoreExtIndexAppendFilter(LibretroCoreExtIndex* index, const char* ext) {
+    size_t extLength = strlen(ext);
+    size_t needed = index->filterLength + extLength + 3; // ';', '.' and the terminator
+    if (needed > index->filterCapacity) {
+        size_t capacity = index->filterCapacity > 0 ? index->filterCapacity * 2 : 256;
+        while (capacity < needed) capacity *= 2;
+        char* filter = (char*)MemRealloc(index->filter, (unsigned int)capacity);
+        if (filter == NULL) return;
+        index->filter = filter;
+        index->filterCapacity = capacity;
+    }
+    if (index->filterLength > 0) index->filter[index->filterLength++] = ';';
+    index->filter[index->filterLength++] = '.';
+    memcpy(index->filter + index->filterLength, ext, extLength + 1);
+    index->filterLength += extLength;
+}
+
+/**
+ * Index the extensions of coreInfos[@p core]. Cores must be added in
+ * coreInfos order, which keeps every bucket's list ascending.
+ */
+static void LibretroCoreExtIndexAdd(LibretroCoreExtIndex* index, int core, const char* exts) {
+    // Archives are browsable regardless of core.
+    if (index->filterLength == 0) LibretroCoreExtIndexAppendFilter(index, "zip");
+
+    for (const char* tok = exts; *tok != '\0'; ) {
+        const char* start = tok;
+        while (*tok != '\0' && *tok != '|') tok++;
+        size_t length = (size_t)(tok - start);
+        if (*tok == '|') tok++;
+
+        char ext[32];
+        if (length == 0 || length >= sizeof(ext)) continue;
+        for (size_t i = 0; i < length; i++) {
+            ext[i] = (start[i] >= 'A' && start[i] <= 'Z') ? (char)(start[i] - 'A' + 'a') : start[i];
+        }
+        ext[length] = '\0';
+
+        LibretroCoreExtBucket* bucket = LibretroCoreExtIndexFind(index, ext);
+        if (bucket == NULL) {
+            bucket = (LibretroCoreExtBucket*)MemAlloc(sizeof(LibretroCoreExtBucket));
+            if (bucket == NULL) continue;
+            memcpy(bucket->ext, ext, length + 1);
+            libretrocoreextlookup_insert(&index->lookup, bucket->ext, (int)cvector_size(index->buckets));
+            cvector_push_back(index->buckets, bucket);
+            if (!TextIsEqual(ext, "zip")) LibretroCoreExtIndexAppendFilter(index, ext);
+        }
+        // A core listing the same extension twice is only added once.
+        if (cvector_size(bucket->cores) == 0 || bucket->cores[cvector_size(bucket->cores) - 1] != core) {
+            cvector_push_back(bucket->cores, core);
+        }
+    }
+}
+
+static void FreeLibretroCoreInfos(void) {
+    for (size_t i = 0; i < cvector_size(menu.coreInfos); i++) {
+        MemFree(menu.coreInfos[i]);
+    }
+    cvector_free(menu.coreInfos);
+    menu.coreInfos = NULL;
+    FreeLibretroCoreExtIndex(&menu.coreExtIndex);
+}
+
+#ifndef RAYLIB_LIBRETRO_CORE_INFO_CACHE
+/**
+ * File name of the core info cache, inside GetLibretroCacheDirectory().
+ */
+#define RAYLIB_LIBRETRO_CORE_INFO_CACHE "coreinfo"
+#endif
+
+/**
+ * A cached scan result for one core binary. It stays valid while the core
+ * and its .info keep the same modification time and size.
+ */
+typedef struct LibretroCoreInfoCacheEntry {
+    char coreFile[256];     // core binary, relative to the core directory
+    int64_t coreModTime;
+    int64_t coreSize;
+    int64_t infoModTime;    // -1 when the core has no .info
+    int64_t infoSize;
+    bool valid;             // false when neither the .info nor a probe described the core
+    bool probed;            // info came from PeekLibretroCoreInfo() rather than the .info
+    LibretroCoreInfo info;
+} LibretroCoreInfoCacheEntry;
+
+// Cache file layout, as written by this machine:
+//   "RLCI" | u32 version | u32 sizeof(entry) | u32 dirLength | dir | u32 count | count x entry
+#define LIBRETRO_CORE_INFO_CACHE_MAGIC 0x49434c52  // "RLCI"
+#define LIBRETRO_CORE_INFO_CACHE_VERSION 1
+
+/**
+ * Read the cached scan of a core directory.
+ *
+ * @return MemAlloc()'ed entries, or NULL if there's no cache for @p dir.
+ */
+static LibretroCoreInfoCacheEntry* LibretroCoreInfoCacheLoad(const char* cachePath, const char* dir, unsigned* count) {
+    *count = 0;
+    if (!FileExists(cachePath)) return NULL;
+    int size = 0;
+    unsigned char* data = LoadFileData(cachePath, &size);
+    if (data == NULL) return NULL;
+
+    const unsigned char* p = data;
+    const unsigned char* end = data + size;
+    uint32_t magic = 0, version = 0, entrySize = 0, dirLength = 0, entryCount = 0;
+    bool ok = size >= 16;
+    if (ok) {
+        memcpy(&magic, p, 4); p += 4;
+        memcpy(&version, p, 4); p += 4;
+        memcpy(&entrySize, p, 4); p += 4;
+        memcpy(&dirLength, p, 4); p += 4;
+        ok = magic == LIBRETRO_CORE_INFO_CACHE_MAGIC && version == LIBRETRO_CORE_INFO_CACHE_VERSION &&
+            entrySize == sizeof(LibretroCoreInfoCacheEntry) && dirLength == strlen(dir) &&
+            (size_t)(end - p) >= (size_t)dirLength + 4 && memcmp(p, dir, dirLength) == 0;
+    }
+    if (ok) {
+        p += dirLength;
+        memcpy(&entryCount, p, 4); p += 4;
+        ok = entryCount > 0 && (uint64_t)(end - p) == (uint64_t)entryCount * sizeof(LibretroCoreInfoCacheEntry);
+    }
+
+    LibretroCoreInfoCacheEntry* entries = NULL;
+    if (ok) {
+        entries = (LibretroCoreInfoCacheEntry*)MemAlloc(entryCount * sizeof(LibretroCoreInfoCacheEntry));
+        if (entries != NULL) {
+            memcpy(entries, p, entryCount * sizeof(LibretroCoreInfoCacheEntry));
+            *count = entryCount;
+        }
+    }
+    UnloadFileData(data);
+    return entries;
+}
+
+/**
+ * Write the scan of a core directory. Goes through a temp file and a rename,
+ * so a reader never sees a half-written cache.
+ */
+static bool LibretroCoreInfoCacheSave(const char* cachePath, const char* dir, const LibretroCoreInfoCacheEntry* entries, unsigned count) {
+    uint32_t dirLength = (uint32_t)strlen(dir);
+    size_t size = 4 + 4 + 4 + 4 + dirLength + 4 + (size_t)count * sizeof(LibretroCoreInfoCacheEntry);
+    if (size > INT_MAX) return false;
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)size);
+    if (data == NULL) return false;
+
+    unsigned char* p = data;
+    uint32_t magic = LIBRETRO_CORE_INFO_CACHE_MAGIC, version = LIBRETRO_CORE_INFO_CACHE_VERSION;
+    uint32_t entrySize = sizeof(LibretroCoreInfoCacheEntry), entryCount = count;
+    memcpy(p, &magic, 4); p += 4;
+    memcpy(p, &version, 4); p += 4;
+    memcpy(p, &entrySize, 4); p += 4;
+    memcpy(p, &dirLength, 4); p += 4;
+    memcpy(p, dir, dirLength); p += dirLength;
+    memcpy(p, &entryCount, 4); p += 4;
+    memcpy(p, entries, (size_t)count * sizeof(LibretroCoreInfoCacheEntry));
+
+    char tempPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", cachePath);
+    bool ok = SaveFileData(tempPath, data, (int)size);
+    MemFree(data);
+    if (ok) {
+        ok = raylib_libretro_vfs_replace_file(tempPath, cachePath);
+    }
+    if (!ok) remove(tempPath);
+    return ok;
+}
+
+/**
+ * Find the cached entry for a core, if the core and its .info are unchanged.
+ *
+ * @param hint Position to try first; scans list cores in the same order each
+ *             time, so it's usually where the entry is.
+ */
+static const LibretroCoreInfoCacheEntry* LibretroCoreInfoCacheFind(const LibretroCoreInfoCacheEntry* entries, unsigned count,
+        unsigned hint, const LibretroCoreInfoCacheEntry* key) {
+    for (unsigned n = 0; n < count; n++) {
+        const LibretroCoreInfoCacheEntry* entry = &entries[(hint + n) % count];
+        if (TextIsEqual(entry->coreFile, key->coreFile)) {
+            bool fresh = entry->coreModTime == key->coreModTime && entry->coreSize == key->coreSize &&
+                entry->infoModTime == key->infoModTime && entry->infoSize == key->infoSize;
+            return fresh ? entry : NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Fill a core's menu info from its .info file. Safe to call from a worker
+ * thread with its own @p infoCfg: it avoids raylib's shared text buffers.
+ *
+ * @return false if the .info doesn't name the core or its extensions.
+ */
+static bool LibretroCoreInfoFromInfoFile(RLibretroConfig* infoCfg, const char* infoPath, const char* coreFile, LibretroCoreInfo* info) {
+    // .info files have no sections; any name works, since it's cleared below.
+    const char* section = "core";
+    rlconfig_load_info(infoCfg, section, infoPath);
+    const char* coreName = rlconfig_get(infoCfg, section, "corename");
+    const char* exts = rlconfig_get(infoCfg, section, "supported_extensions");
+    bool ok = coreName && coreName[0] && exts && exts[0];
+    if (ok) {
+        TextCopy(info->path, coreFile);
+        TextCopy(info->supportedExtensions, exts);
+        TextCopy(info->coreName, coreName);
+        const char* displayName = rlconfig_get(infoCfg, section, "display_name");
+        TextCopy(info->displayName, (displayName && displayName[0]) ? displayName : coreName);
+        const char* systemName = rlconfig_get(infoCfg, section, "systemname");
+        TextCopy(info->systemName, (systemName && systemName[0]) ? systemName : "");
+        const char* license = rlconfig_get(infoCfg, section, "license");
+        TextCopy(info->license, (license && license[0]) ? license : "");
+        const char* noGame = rlconfig_get(infoCfg, section, "supports_no_game");
+        info->supportsNoGame = noGame && TextIsEqual(noGame, "true");
+        const char* fullpath = rlconfig_get(infoCfg, section, "needs_fullpath");
+        info->needsFullpath = fullpath && TextIsEqual(fullpath, "true");
+        TraceLog(LOG_INFO, "LIBRETRO: Found %s (%s)", info->displayName, exts);
+    }
+    rlconfig_clear_section(infoCfg, section);
+    return ok;
+}
+
+/**
+ * Fill a core's menu info from what a probe of the core reported.
+ * supports_no_game can't be known without a full init, so it defaults to false.
+ */
+static bool LibretroCoreInfoFromProbeResult(const char* coreFile, const char* name, const char* exts, bool needsFullpath, LibretroCoreInfo* info) {
+    if (!name[0] || !exts[0]) return false;
+    TextCopy(info->path, coreFile);
+    snprintf(info->supportedExtensions, sizeof(info->supportedExtensions), "%s", exts);
+    snprintf(info->coreName, sizeof(info->coreName), "%s", name);
+    snprintf(info->displayName, sizeof(info->displayName), "%s", name);
+    info->systemName[0] = '\0';
+    info->license[0] = '\0';
+    info->needsFullpath = needsFullpath;
+    info->supportsNoGame = false;
+    TraceLog(LOG_INFO, "LIBRETRO: Probed %s (%s) [no .info]", name, exts);
+    return true;
+}
+
+/**
+ * Fill a core's menu info from the core PeekLibretroCoreInfo() just opened.
+ */
+static bool LibretroCoreInfoFromPeek(const char* coreFile, LibretroCoreInfo* info) {
+    return LibretroCoreInfoFromProbeResult(coreFile, GetLibretroName(), GetLibretroValidExtensions(), GetLibretroNeedFullpath(NULL, NULL), info);
+}
+
+/**
+ * Fill a core's menu info by opening it in this process.
+ */
+static bool LibretroCoreInfoFromProbe(const char* corePath, const char* coreFile, LibretroCoreInfo* info) {
+    bool ok = PeekLibretroCoreInfo(corePath) && LibretroCoreInfoFromPeek(coreFile, info);
+    // Always tear down: PeekLibretroCoreInfo leaves the dylib open on
+    // success, and may leave it open on a mid-way symbol-load failure.
+    CloseLibretro();
+    return ok;
+}
+
+#ifndef LIBRETRO_MENU_CORE_SCAN_THREADS
+/**
+ * Most worker threads parsing .info files during a core scan.
+ */
+#define LIBRETRO_MENU_CORE_SCAN_THREADS 4
+#endif
+
+#ifndef LIBRETRO_MENU_CORE_PROBE_PROCESSES
+/**
+ * Most child processes probing cores without a .info at the same time.
+ */
+#define LIBRETRO_MENU_CORE_PROBE_PROCESSES 2
+#endif
+
+#ifndef LIBRETRO_MENU_CORE_PROBE_TIMEOUT
+/**
+ * Seconds a probe process gets before it's killed. The core is left out of
+ * this scan, and probed again on the next one.
+ */
+#define LIBRETRO_MENU_CORE_PROBE_TIMEOUT 5.0
+#endif
+
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+// The probe helper, next to the executable, and its exit status for a file
+// that isn't a usable core (see bin/raylib-libretro-probe.c).
+#define RAYLIB_LIBRETRO_MENU_PROBE_HELPER "raylib-libretro-probe"
+#define RAYLIB_LIBRETRO_MENU_PROBE_NOT_A_CORE 3
+#endif
+
+typedef enum LibretroCoreScanJobState {
+    LIBRETRO_CORE_SCAN_QUEUED = 0,
+    LIBRETRO_CORE_SCAN_RUNNING,
+    LIBRETRO_CORE_SCAN_DONE,    // entry filled in, waiting for MenuPollCoreScan()
+    LIBRETRO_CORE_SCAN_MERGED,  // handed to menu.coreInfos (or dropped)
+} LibretroCoreScanJobState;
+
+/**
+ * A core the scan couldn't take from the cache.
+ */
+typedef struct LibretroCoreScanJob {
+    unsigned entry;                                 // index into menuCoreScan.entries
+    int state;                                      // LibretroCoreScanJobState
+    bool probe;                                     // no usable .info: open the core instead
+    bool skipped;                                   // probe deferred to a later scan, keep it out of the cache
+    char corePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char infoPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];    // empty when the core has no .info
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+    pid_t pid;
+    int fd;                                         // read end of the helper's result pipe
+    double started;
+    size_t received;
+    char output[256 + RLCONFIG_VALUE_MAX + 8];      // name, extensions and needs_fullpath lines
+#endif
+} LibretroCoreScanJob;
+
+/**
+ * A core directory scan in progress. Cached cores are listed right away;
+ * the rest arrive through MenuPollCoreScan() as they're parsed or probed.
+ */
+typedef struct LibretroCoreScan {
+    bool active;
+    char dir[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char cachePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];   // empty without a cache directory
+    LibretroCoreInfoCacheEntry* entries;            // every core in the directory, in listing order
+    unsigned entryCount;
+    unsigned cachedCount;                           // entries in the cache file the scan started from
+    LibretroCoreScanJob* jobs;
+    unsigned jobCount;
+    unsigned mergedCount;
+    int reused;
+    retro_time_t start;
+#ifdef HAVE_THREADS
+    slock_t* lock;                                  // guards job states and nextInfoJob
+    sthread_t* threads[LIBRETRO_MENU_CORE_SCAN_THREADS];
+    unsigned nextInfoJob;
+    bool cancel;                                    // set under lock
+#endif
+} LibretroCoreScan;
+
+static LibretroCoreScan menuCoreScan;
+
+static void LibretroMenuUpdateLoadGameFilter(LibretroMenu* m);
+static const char* LibretroCoreDisplayName(int index);
+
+static int MenuCoreScanJobState(const LibretroCoreScanJob* job) {
+#ifdef HAVE_THREADS
+    if (menuCoreScan.lock != NULL) {
+        slock_lock(menuCoreScan.lock);
+        int state = job->state;
+        slock_unlock(menuCoreScan.lock);
+        return state;
+    }
+#endif
+    return job->state;
+}
+
+/**
+ * Parse one queued .info. Runs on a scan worker, or on the main thread
+ * without thread support.
+ */
+static void MenuCoreScanParseInfo(RLibretroConfig* infoCfg, LibretroCoreScanJob* job) {
+    LibretroCoreInfoCacheEntry* entry = &menuCoreScan.entries[job->entry];
+    entry->valid = LibretroCoreInfoFromInfoFile(infoCfg, job->infoPath, entry->coreFile, &entry->info);
+}
+
+#ifdef HAVE_THREADS
+/**
+ * Scan worker: takes queued .info jobs until none are left. Each worker has
+ * its own config, and writes only to the entry of the job it took.
+ */
+static void MenuCoreScanThread(void* userData) {
+    (void)userData;
+    RLibretroConfig* infoCfg = rlconfig_load(NULL);
+    slock_lock(menuCoreScan.lock);
+    while (!menuCoreScan.cancel && menuCoreScan.nextInfoJob < menuCoreScan.jobCount) {
+        LibretroCoreScanJob* job = &menuCoreScan.jobs[menuCoreScan.nextInfoJob++];
+        if (job->probe || job->state != LIBRETRO_CORE_SCAN_QUEUED) continue;
+        job->state = LIBRETRO_CORE_SCAN_RUNNING;
+        slock_unlock(menuCoreScan.lock);
+
+        MenuCoreScanParseInfo(infoCfg, job);
+
+        slock_lock(menuCoreScan.lock);
+        job->state = LIBRETRO_CORE_SCAN_DONE;
+    }
+    slock_unlock(menuCoreScan.lock);
+    rlconfig_free(infoCfg);
+}
+#endif
+
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+/**
+ * The probe helper's path, or NULL when it isn't installed.
+ */
+static const char* MenuCoreProbeHelperPath(void) {
+    static char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    snprintf(path, sizeof(path), "%s%s", GetApplicationDirectory(), RAYLIB_LIBRETRO_MENU_PROBE_HELPER);
+    return FileExists(path) ? path : NULL;
+}
+
+/**
+ * Spawn the probe helper on a core, with its result pipe on descriptor 3.
+ */
+static bool MenuCoreScanStartProbe(LibretroCoreScanJob* job, const char* helper) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    // Keep every other probe's pipe out of the helper; descriptor 3 is
+    // dup2()'d fresh, so it stays open across the exec. dup2() onto itself
+    // wouldn't clear close-on-exec, so never hand it 3 to begin with.
+    if (fds[1] == 3) {
+        fds[1] = fcntl(3, F_DUPFD, 4);
+        close(3);
+        if (fds[1] < 0) {
+            close(fds[0]);
+            return false;
+        }
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], 3);
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+    // Our own files are close-on-exec, but PhysFS opens archives without it.
+    posix_spawn_file_actions_addclosefrom_np(&actions, 4);
+#endif
+    char* argv[] = { (char*)helper, job->corePath, NULL };
+    pid_t pid = 0;
+    // Don't let the helper inherit, and later repeat, buffered log output.
+    fflush(NULL);
+    int error = posix_spawn(&pid, helper, &actions, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (error != 0) {
+        close(fds[0]);
+        return false;
+    }
+
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    job->pid = pid;
+    job->fd = fds[0];
+    job->received = 0;
+    job->started = GetTime();
+    return true;
+}
+
+/**
+ * Fill the job's entry from the helper's output lines.
+ */
+static bool MenuCoreScanParseProbe(LibretroCoreScanJob* job) {
+    char* name = job->output;
+    char* exts = strchr(name, '\n');
+    char* fullpath = (exts != NULL) ? strchr(exts + 1, '\n') : NULL;
+    if (fullpath == NULL || strchr(fullpath + 1, '\n') == NULL) return false;
+    *exts++ = '\0';
+    *fullpath++ = '\0';
+    LibretroCoreInfoCacheEntry* entry = &menuCoreScan.entries[job->entry];
+    return LibretroCoreInfoFromProbeResult(entry->coreFile, name, exts, fullpath[0] == '1', &entry->info);
+}
+
+/**
+ * Collect a probe's result once the helper exited or timed out. Only a
+ * helper that ran to the end and said the file isn't a core makes a
+ * negative cache entry; a timeout, a crash or cut-off output leaves the
+ * core to be probed again by the next scan.
+ */
+static void MenuCoreScanPollProbe(LibretroCoreScanJob* job) {
+    bool eof = false;
+    bool timedOut = false;
+    while (job->received < sizeof(job->output) - 1) {
+        ssize_t n = read(job->fd, job->output + job->received, sizeof(job->output) - 1 - job->received);
+        if (n > 0) {
+            job->received += (size_t)n;
+            continue;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (GetTime() - job->started < LIBRETRO_MENU_CORE_PROBE_TIMEOUT) return;
+            timedOut = true;
+        }
+        eof = (n == 0);
+        break;
+    }
+
+    // The pipe closes when the helper exits. Anything else, a timeout, a read
+    // error or more output than a probe writes, means it's stuck or misbehaving.
+    if (!eof) kill(job->pid, SIGKILL);
+    close(job->fd);
+    job->fd = -1;
+    int status = 0;
+    while (waitpid(job->pid, &status, 0) < 0 && errno == EINTR) {}
+    job->pid = 0;
+    job->output[job->received] = '\0';
+
+    LibretroCoreInfoCacheEntry* entry = &menuCoreScan.entries[job->entry];
+    entry->valid = false;
+    bool exited = !timedOut && WIFEXITED(status);
+    if (exited && WEXITSTATUS(status) == 0 && MenuCoreScanParseProbe(job)) {
+        entry->valid = true;
+    } else if (exited && WEXITSTATUS(status) == RAYLIB_LIBRETRO_MENU_PROBE_NOT_A_CORE) {
+        TraceLog(LOG_INFO, "LIBRETRO: %s is not a libretro core", job->corePath);
+    } else {
+        TraceLog(LOG_WARNING, "LIBRETRO: Probing %s %s; retrying on the next scan", job->corePath, timedOut ? "timed out" : "failed");
+        job->skipped = true;
+    }
+    job->state = LIBRETRO_CORE_SCAN_DONE;
+}
+#endif
+
+/**
+ * Rebuild About > Available Cores from menu.coreInfos.
+ */
+static void LibretroMenuUpdateAvailableCores(void) {
+    if (menu.availableCoresTree == NULL) return;
+    nk_console_free_children(menu.availableCoresTree);
+    if (cvector_size(menu.coreInfos) == 0) {
+        nk_console_label(menu.availableCoresTree, menuCoreScan.active ? "(scanning...)" : "(none found)");
+    }
+    for (int i = 0; i < (int)cvector_size(menu.coreInfos); i++) {
+        nk_console_label(menu.availableCoresTree, LibretroCoreDisplayName(i));
+    }
+}
+
+static void MenuCoreScanAddInfo(const LibretroCoreInfo* source) {
+    LibretroCoreInfo* info = (LibretroCoreInfo*)MemAlloc(sizeof(LibretroCoreInfo));
+    if (info == NULL) return;
+    *info = *source;
+    cvector_push_back(menu.coreInfos, info);
+    LibretroCoreExtIndexAdd(&menu.coreExtIndex, (int)cvector_size(menu.coreInfos) - 1, info->supportedExtensions);
+}
+
+/**
+ * Add the scan's cores to menu.coreInfos in one fixed order, whatever order
+ * they were parsed or probed in: those described by their .info first, then
+ * probed ones, each in directory listing order. Entries with a job still
+ * pending are left out when @p skipPending is set.
+ */
+static void MenuCoreScanListEntries(bool skipPending) {
+    for (int probed = 0; probed < 2; probed++) {
+        for (unsigned i = 0; i < menuCoreScan.entryCount; i++) {
+            const LibretroCoreInfoCacheEntry* entry = &menuCoreScan.entries[i];
+            bool pending = false;
+            for (unsigned j = 0; j < menuCoreScan.jobCount && skipPending && !pending; j++) pending = menuCoreScan.jobs[j].entry == i;
+            if (pending || !entry->valid || entry->probed != (probed == 1)) continue;
+            MenuCoreScanAddInfo(&entry->info);
+        }
+    }
+}
+
+/**
+ * Stop the scan workers and any probe children, and free the scan.
+ */
+static void MenuCoreScanRelease(void) {
+#ifdef HAVE_THREADS
+    if (menuCoreScan.lock != NULL) {
+        slock_lock(menuCoreScan.lock);
+        menuCoreScan.cancel = true;
+        slock_unlock(menuCoreScan.lock);
+    }
+    for (int i = 0; i < LIBRETRO_MENU_CORE_SCAN_THREADS; i++) {
+        if (menuCoreScan.threads[i] != NULL) sthread_join(menuCoreScan.threads[i]);
+    }
+    if (menuCoreScan.lock != NULL) slock_free(menuCoreScan.lock);
+#endif
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+    for (unsigned i = 0; i < menuCoreScan.jobCount; i++) {
+        LibretroCoreScanJob* job = &menuCoreScan.jobs[i];
+        if (job->pid <= 0) continue;
+        kill(job->pid, SIGKILL);
+        close(job->fd);
+        waitpid(job->pid, NULL, 0);
+    }
+#endif
+    MemFree(menuCoreScan.entries);
+    MemFree(menuCoreScan.jobs);
+    memset(&menuCoreScan, 0, sizeof(menuCoreScan));
+}
+
+/**
+ * Abandon a scan in progress, e.g. when the core directory changes again.
+ * Whatever it found so far stays in menu.coreInfos, but isn't cached.
+ */
+static void MenuCancelCoreScan(void) {
+    if (!menuCoreScan.active) return;
+    TraceLog(LOG_INFO, "LIBRETRO: Cancelled core scan of %s", menuCoreScan.dir);
+    MenuCoreScanRelease();
+}
+
+/**
+ * Write the cache once every core is accounted for, and end the scan.
+ */
+static void MenuFinishCoreScan(void) {
+    // Cores joined the list as they finished; put them in the order a warm
+    // or single-threaded scan lists them, so picking a core for a game
+    // doesn't depend on which job finished first.
+    if (menuCoreScan.jobCount > 0) {
+        FreeLibretroCoreInfos();
+        MenuCoreScanListEntries(false);
+        LibretroMenuUpdateLoadGameFilter(&menu);
+    }
+
+    // Probes that were deferred stay out, so the next scan retries them.
+    unsigned count = 0;
+    for (unsigned i = 0; i < menuCoreScan.jobCount; i++) {
+        if (menuCoreScan.jobs[i].skipped) menuCoreScan.entries[menuCoreScan.jobs[i].entry].coreFile[0] = '\0';
+    }
+    for (unsigned i = 0; i < menuCoreScan.entryCount; i++) {
+        if (menuCoreScan.entries[i].coreFile[0] != '\0') menuCoreScan.entries[count++] = menuCoreScan.entries[i];
+    }
+
+    if (menuCoreScan.cachePath[0] != '\0' && (menuCoreScan.jobCount > 0 || count != menuCoreScan.cachedCount)) {
+        if (count > 0) {
+            LibretroCoreInfoCacheSave(menuCoreScan.cachePath, menuCoreScan.dir, menuCoreScan.entries, count);
+        } else {
+            remove(menuCoreScan.cachePath);
+        }
+    }
+
+    TraceLog(LOG_INFO, "LIBRETRO: Found %d cores in %s in %.1f ms (%d of %d from cache)", (int)cvector_size(menu.coreInfos), menuCoreScan.dir,
+        (cpu_features_get_time_usec() - menuCoreScan.start) / 1000.0, menuCoreScan.reused, (int)count);
+    MenuCoreScanRelease();
+    LibretroMenuUpdateAvailableCores();
+}
+
+/**
+ * Advance the core scan: start probes, pick up parsed and probed cores, and
+ * add them to the menu as they arrive. Called every menu update.
+ */
+static void MenuPollCoreScan(void) {
+    if (!menuCoreScan.active) return;
+
+    bool added = false;
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+    int probing = 0;
+    const char* helper = MenuCoreProbeHelperPath();
+#endif
+    bool probed = false;
+    int parsed = 0;
+    RLibretroConfig* infoCfg = NULL;
+
+    for (unsigned i = 0; i < menuCoreScan.jobCount; i++) {
+        LibretroCoreScanJob* job = &menuCoreScan.jobs[i];
+        int state = MenuCoreScanJobState(job);
+
+        if (state == LIBRETRO_CORE_SCAN_QUEUED && !job->probe) {
+            // Without workers, parse a few per update so the menu stays responsive.
+#ifdef HAVE_THREADS
+            if (menuCoreScan.lock != NULL) continue;
+#endif
+            if (parsed++ >= 8) continue;
+            if (infoCfg == NULL) infoCfg = rlconfig_load(NULL);
+            MenuCoreScanParseInfo(infoCfg, job);
+            state = job->state = LIBRETRO_CORE_SCAN_DONE;
+        }
+
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+        if (state == LIBRETRO_CORE_SCAN_QUEUED && job->probe && helper != NULL) {
+            if (probing >= LIBRETRO_MENU_CORE_PROBE_PROCESSES) continue;
+            if (MenuCoreScanStartProbe(job, helper)) {
+                job->state = LIBRETRO_CORE_SCAN_RUNNING;
+                probing++;
+                continue;
+            }
+            TraceLog(LOG_WARNING, "LIBRETRO: Failed to start a probe for %s; retrying on the next scan", job->corePath);
+            job->skipped = true;
+            menuCoreScan.entries[job->entry].valid = false;
+            state = job->state = LIBRETRO_CORE_SCAN_DONE;
+        }
+#endif
+
+        if (state == LIBRETRO_CORE_SCAN_QUEUED && job->probe) {
+            // The in-process probe's CloseLibretro() wipes LIBRETRO.core, which
+            // would tear down a game in progress. Leave the core for a later scan.
+            if (IsLibretroReady()) {
+                job->skipped = true;
+                menuCoreScan.entries[job->entry].valid = false;
+            } else {
+                // One core per update: each is a dlopen() on the main thread.
+                if (probed) continue;
+                probed = true;
+                LibretroCoreInfoCacheEntry* entry = &menuCoreScan.entries[job->entry];
+                entry->valid = LibretroCoreInfoFromProbe(job->corePath, entry->coreFile, &entry->info);
+            }
+            state = job->state = LIBRETRO_CORE_SCAN_DONE;
+        }
 
-static void MenuContentDirChanged(nk_console* widget, void* user_data) {
-    MenuDirChanged(widget, user_data);
-#ifndef __EMSCRIPTEN__
-    if (menu.loadGameWidget && LIBRETRO.fileBrowserStartDirectory[0] != '\0') {
-        nk_console_file_set_directory(menu.loadGameWidget, LIBRETRO.fileBrowserStartDirectory);
-    }
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+        if (state == LIBRETRO_CORE_SCAN_RUNNING && job->probe) {
+            MenuCoreScanPollProbe(job);
+            state = job->state;
+            if (state == LIBRETRO_CORE_SCAN_RUNNING) probing++;
+        }
 #endif
-}
 
-static bool IsLibretroCoreFile(const char* path) {
-    const char* ext = GetFileExtension(path);
-    return TextIsEqual(ext, ".so") || TextIsEqual(ext, ".dll") || TextIsEqual(ext, ".dylib") || TextIsEqual(ext, ".wasm");
+        if (state != LIBRETRO_CORE_SCAN_DONE) continue;
+        LibretroCoreInfoCacheEntry* entry = &menuCoreScan.entries[job->entry];
+        if (!entry->valid && !job->probe) {
+            // A .info that doesn't describe the core; probe it instead, so it
+            // still appears rather than vanishing silently.
+            job->probe = true;
+            entry->probed = true;
+            job->state = LIBRETRO_CORE_SCAN_QUEUED;
+            i--;
+            continue;
+        }
+        if (entry->valid) {
+            MenuCoreScanAddInfo(&entry->info);
+            added = true;
+        }
+        job->state = LIBRETRO_CORE_SCAN_MERGED;
+        menuCoreScan.mergedCount++;
+    }
+    rlconfig_free(infoCfg);
+
+    if (added) {
+        LibretroMenuUpdateLoadGameFilter(&menu);
+    }
+    if (menuCoreScan.mergedCount == menuCoreScan.jobCount) {
+        MenuFinishCoreScan();
+    } else if (added) {
+        LibretroMenuUpdateAvailableCores();
+    }
 }
 
-static void FreeLibretroCoreInfos(void) {
-    for (size_t i = 0; i < cvector_size(menu.coreInfos); i++) {
-        MemFree(menu.coreInfos[i]);
+/**
+ * Block until the core scan is complete, for callers that need every core,
+ * like picking one for a game.
+ */
+static void MenuWaitCoreScan(void) {
+    while (menuCoreScan.active) {
+        MenuPollCoreScan();
+        if (menuCoreScan.active) WaitTime(0.002);
     }
-    cvector_free(menu.coreInfos);
-    menu.coreInfos = NULL;
 }
 
 /**
@@ -878,6 +2327,12 @@ static void FreeLibretroCoreInfos(void) {
  * dlopen. A core binary with no matching `.info` is probed directly via
  * PeekLibretroCoreInfo() so it still appears rather than vanishing silently.
  *
+ * Results are cached in RAYLIB_LIBRETRO_CORE_INFO_CACHE. Cached cores are
+ * listed before this returns; the rest are parsed on worker threads and
+ * probed by a helper process (see RAYLIB_LIBRETRO_MENU_PROBE_PROCESS), and
+ * join menu.coreInfos through MenuPollCoreScan() as they finish. Use
+ * MenuWaitCoreScan() when the full list is needed.
+ *
  * IMPORTANT: the `.info` values are PRE-LOAD HINTS for menu filtering only,
  * never a hard gate. The authoritative values come from the core's runtime
  * retro_get_system_info() / CONTENT_INFO_OVERRIDE once it is loaded, and the
@@ -888,100 +2343,102 @@ static void FreeLibretroCoreInfos(void) {
  */
 static void ScanLibretroCoreDirectory(void) {
     const char* dir = LIBRETRO.coreDirectory;
+    MenuCancelCoreScan();
     FreeLibretroCoreInfos();
-    if (!dir || !dir[0] || !DirectoryExists(dir)) return;
+    if (!dir || !dir[0] || !DirectoryExists(dir)) {
+        LibretroMenuUpdateAvailableCores();
+        return;
+    }
+
+    LibretroCoreScan* scan = &menuCoreScan;
+    scan->start = cpu_features_get_time_usec();
+    TextCopy(scan->dir, dir);
+    const char* cacheDir = GetLibretroCacheDirectory();
+    if (cacheDir != NULL) TextCopy(scan->cachePath, TextFormat("%s/%s", cacheDir, RAYLIB_LIBRETRO_CORE_INFO_CACHE));
+    LibretroCoreInfoCacheEntry* cached = LibretroCoreInfoCacheLoad(scan->cachePath, dir, &scan->cachedCount);
 
-    RLibretroConfig* infoCfg = rlconfig_load(NULL);
     FilePathList files = LoadDirectoryFiles(dir);
-    for (unsigned int i = 0; i < files.count; i++) {
-        if (!TextIsEqual(GetFileExtension(files.paths[i]), ".info")) continue;
-
-        char infoBase[RAYLIB_LIBRETRO_VFS_MAX_PATH];
-        TextCopy(infoBase, GetFileNameWithoutExt(files.paths[i]));
-        const char* coreFile = NULL;
-        for (unsigned int j = 0; j < files.count; j++) {
-            if (!IsLibretroCoreFile(files.paths[j])) continue;
-            char coreBase[RAYLIB_LIBRETRO_VFS_MAX_PATH];
-            TextCopy(coreBase, GetFileNameWithoutExt(files.paths[j]));
-            if (TextIsEqual(coreBase, infoBase) ||
-                TextIsEqual(coreBase, TextFormat("%s_android", infoBase))) {
-                coreFile = GetFileName(files.paths[j]);
-                break;
-            }
+    if (files.count > 0) {
+        scan->entries = (LibretroCoreInfoCacheEntry*)MemAlloc(files.count * sizeof(LibretroCoreInfoCacheEntry));
+        scan->jobs = (LibretroCoreScanJob*)MemAlloc(files.count * sizeof(LibretroCoreScanJob));
+    }
+    for (unsigned int i = 0; i < files.count && scan->entries != NULL && scan->jobs != NULL; i++) {
+        if (!IsLibretroCoreFile(files.paths[i])) continue;
+
+        LibretroCoreInfoCacheEntry* entry = &scan->entries[scan->entryCount];
+        memset(entry, 0, sizeof(*entry));
+        TextCopy(entry->coreFile, GetFileName(files.paths[i]));
+        entry->coreModTime = (int64_t)GetFileModTime(files.paths[i]);
+        entry->coreSize = raylib_libretro_vfs_file_size_64(files.paths[i]);
+
+        // The .info shares the core's name, without any "_android" suffix.
+        char infoPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+        TextCopy(infoPath, TextFormat("%s/%s.info", dir, GetFileNameWithoutExt(files.paths[i])));
+        size_t infoLength = strlen(infoPath);
+        if (!FileExists(infoPath) && infoLength > 13 && TextIsEqual(infoPath + infoLength - 13, "_android.info")) {
+            TextCopy(infoPath + infoLength - 13, ".info");
         }
-        if (!coreFile) continue;
-
-        rlconfig_load_info(infoCfg, infoBase, files.paths[i]);
-        const char* coreName = rlconfig_get(infoCfg, infoBase, "corename");
-        const char* exts = rlconfig_get(infoCfg, infoBase, "supported_extensions");
-        if (!coreName || !coreName[0] || !exts || !exts[0]) {
-            rlconfig_clear_section(infoCfg, infoBase);
-            continue;
+        bool hasInfo = FileExists(infoPath);
+        entry->infoModTime = hasInfo ? (int64_t)GetFileModTime(infoPath) : -1;
+        entry->infoSize = hasInfo ? raylib_libretro_vfs_file_size_64(infoPath) : -1;
+
+        const LibretroCoreInfoCacheEntry* hit = LibretroCoreInfoCacheFind(cached, scan->cachedCount, scan->entryCount, entry);
+        if (hit != NULL) {
+            *entry = *hit;
+            scan->reused++;
+        } else {
+            LibretroCoreScanJob* job = &scan->jobs[scan->jobCount++];
+            memset(job, 0, sizeof(*job));
+            job->entry = scan->entryCount;
+            job->probe = !hasInfo;
+            entry->probed = !hasInfo;
+            TextCopy(job->corePath, files.paths[i]);
+            if (hasInfo) TextCopy(job->infoPath, infoPath);
+#ifdef RAYLIB_LIBRETRO_MENU_PROBE_PROCESS
+            job->fd = -1;
+#endif
         }
-
-        LibretroCoreInfo* info = (LibretroCoreInfo*)MemAlloc(sizeof(LibretroCoreInfo));
-        TextCopy(info->path, coreFile);
-        TextCopy(info->supportedExtensions, exts);
-        TextCopy(info->coreName, coreName);
-        const char* displayName = rlconfig_get(infoCfg, infoBase, "display_name");
-        TextCopy(info->displayName, (displayName && displayName[0]) ? displayName : coreName);
-        const char* systemName = rlconfig_get(infoCfg, infoBase, "systemname");
-        TextCopy(info->systemName, (systemName && systemName[0]) ? systemName : "");
-        const char* license = rlconfig_get(infoCfg, infoBase, "license");
-        TextCopy(info->license, (license && license[0]) ? license : "");
-        const char* noGame = rlconfig_get(infoCfg, infoBase, "supports_no_game");
-        info->supportsNoGame = noGame && TextIsEqual(noGame, "true");
-        const char* fullpath = rlconfig_get(infoCfg, infoBase, "needs_fullpath");
-        info->needsFullpath = fullpath && TextIsEqual(fullpath, "true");
-
-        TraceLog(LOG_INFO, "LIBRETRO: Found %s (%s)", info->displayName, exts);
-        cvector_push_back(menu.coreInfos, info);
-        rlconfig_clear_section(infoCfg, infoBase);
+        scan->entryCount++;
     }
+    UnloadDirectoryFiles(files);
+    MemFree(cached);
 
-    // Fallback: a core binary with no sibling .info would otherwise be invisible
-    // (the loop above is .info-driven). Probe such cores directly so they still
-    // appear. Guarded on IsLibretroReady(): the probe's CloseLibretro() wipes
-    // LIBRETRO.core, which would tear down a game in progress — and this scan
-    // also runs from MenuCoreDirChanged while in-game. supports_no_game can't be
-    // known without a full init, so it defaults to false for probed cores.
-    if (!IsLibretroReady()) {
-        for (unsigned int i = 0; i < files.count; i++) {
-            if (!IsLibretroCoreFile(files.paths[i])) continue;
-            const char* coreFile = GetFileName(files.paths[i]);
+    // Cached cores are listed straight away.
+    MenuCoreScanListEntries(true);
 
-            bool hasInfo = false;
-            for (int k = 0; k < (int)cvector_size(menu.coreInfos); k++) {
-                if (TextIsEqual(menu.coreInfos[k]->path, coreFile)) { hasInfo = true; break; }
-            }
-            if (hasInfo) continue;
-
-            if (PeekLibretroCoreInfo(files.paths[i])) {
-                const char* name = GetLibretroName();
-                const char* exts = GetLibretroValidExtensions();
-                if (name[0] && exts[0]) {
-                    LibretroCoreInfo* info = (LibretroCoreInfo*)MemAlloc(sizeof(LibretroCoreInfo));
-                    TextCopy(info->path, coreFile);
-                    TextCopy(info->supportedExtensions, exts);
-                    TextCopy(info->coreName, name);
-                    TextCopy(info->displayName, name);
-                    info->systemName[0] = '\0';
-                    info->license[0] = '\0';
-                    info->needsFullpath = GetLibretroNeedFullpath(NULL, NULL);
-                    info->supportsNoGame = false;
-                    TraceLog(LOG_INFO, "LIBRETRO: Probed %s (%s) [no .info]", name, exts);
-                    cvector_push_back(menu.coreInfos, info);
-                }
+    scan->active = true;
+#ifdef HAVE_THREADS
+    unsigned infoJobs = 0;
+    for (unsigned i = 0; i < scan->jobCount; i++) {
+        if (!scan->jobs[i].probe) infoJobs++;
+    }
+    if (infoJobs > 1) {
+        unsigned threadCount = cpu_features_get_core_amount();
+        if (threadCount > LIBRETRO_MENU_CORE_SCAN_THREADS) threadCount = LIBRETRO_MENU_CORE_SCAN_THREADS;
+        if (threadCount > infoJobs) threadCount = infoJobs;
+        scan->lock = slock_new();
+        for (unsigned i = 0; i < threadCount && scan->lock != NULL; i++) {
+            scan->threads[i] = sthread_create(MenuCoreScanThread, NULL);
+            if (scan->threads[i] == NULL) break;
+        }
+        if (scan->lock == NULL || scan->threads[0] == NULL) {
+            // Workers that did start still drain the queue; with none, the
+            // main thread parses everything in MenuPollCoreScan().
+            TraceLog(LOG_WARNING, "LIBRETRO: Core scan threads unavailable, scanning on the main thread");
+            if (scan->lock != NULL && scan->threads[0] == NULL) {
+                slock_free(scan->lock);
+                scan->lock = NULL;
             }
-            // Always tear down: PeekLibretroCoreInfo leaves the dylib open on
-            // success, and may leave it open on a mid-way symbol-load failure.
-            CloseLibretro();
         }
     }
+#endif
 
-    UnloadDirectoryFiles(files);
-    rlconfig_free(infoCfg);
-    TraceLog(LOG_INFO, "LIBRETRO: Found %d cores in %s", (int)cvector_size(menu.coreInfos), dir);
+    LibretroMenuUpdateLoadGameFilter(&menu);
+    MenuPollCoreScan();
+    if (menuCoreScan.active) {
+        TraceLog(LOG_INFO, "LIBRETRO: Listed %d cached cores, scanning %u more in the background", (int)cvector_size(menu.coreInfos), menuCoreScan.jobCount);
+        LibretroMenuUpdateAvailableCores();
+    }
 }
 
 /**
@@ -996,22 +2453,6 @@ static bool LibretroExtLower(const char* path, char* out) {
     return true;
 }
 
-/**
- * @return true when cached core @p index lists extension @p extLower
- *         (lower-case, no dot) in its valid_extensions.
- */
-static bool LibretroCoreSupportsExt(int index, const char* extLower) {
-    if (index < 0 || index >= (int)cvector_size(menu.coreInfos)) return false;
-    const char* exts = menu.coreInfos[index]->supportedExtensions;
-    if (!exts[0]) return false;
-    int extCount = 0;
-    char** extList = TextSplit(exts, '|', &extCount);
-    for (int j = 0; j < extCount; j++) {
-        if (TextIsEqual(extList[j], extLower)) return true;
-    }
-    return false;
-}
-
 /**
  * Display name for cached core @p index: its cached human-readable name, or the
  * de-suffixed file name as a fallback. The returned pointer is only valid until
@@ -1045,10 +2486,17 @@ static const char* LibretroCoreDisplayName(int index) {
  */
 static bool FindZipInnerExtensionForCore(const char* zipPath, char* outExt) {
     if (!IsPhysFSReady() && !InitLibretroPhysFS()) return false;
-    // Mount at a scratch point to avoid clobbering any /game mount in flight.
-    if (!MountPhysFS(zipPath, "/peek")) return false;
-
-    FilePathList entries = LoadDirectoryFilesFromPhysFSEx("/peek", NULL, true);
+    // The zip index lists the archive without mounting it. Only fall back to
+    // a scratch mount (so any /game mount in flight isn't clobbered) when the
+    // archive can't be indexed.
+    FilePathList entries = LoadLibretroZipEntryPaths(zipPath, "/peek");
+    bool mounted = false;
+    if (entries.count == 0) {
+        UnloadDirectoryFiles(entries);
+        if (!MountPhysFS(zipPath, "/peek")) return false;
+        mounted = true;
+        entries = LoadDirectoryFilesFromPhysFSEx("/peek", NULL, true);
+    }
     bool found = false;
 
     // Prefer disc metadata (.m3u, .cue) so the core list matches what the
@@ -1057,29 +2505,23 @@ static bool FindZipInnerExtensionForCore(const char* zipPath, char* outExt) {
         if (!IsFileExtension(entries.paths[e], ".m3u;.cue")) continue;
         char innerLower[32];
         if (!LibretroExtLower(entries.paths[e], innerLower)) continue;
-        for (int i = 0; i < (int)cvector_size(menu.coreInfos); i++) {
-            if (LibretroCoreSupportsExt(i, innerLower)) {
-                TextCopy(outExt, innerLower);
-                found = true;
-                break;
-            }
+        if (LibretroCoreExtIndexFind(&menu.coreExtIndex, innerLower) != NULL) {
+            TextCopy(outExt, innerLower);
+            found = true;
         }
     }
 
     for (unsigned int e = 0; e < entries.count && !found; e++) {
         char innerLower[32];
         if (!LibretroExtLower(entries.paths[e], innerLower)) continue;
-        for (int i = 0; i < (int)cvector_size(menu.coreInfos); i++) {
-            if (LibretroCoreSupportsExt(i, innerLower)) {
-                TextCopy(outExt, innerLower);
-                found = true;
-                break;
-            }
+        if (LibretroCoreExtIndexFind(&menu.coreExtIndex, innerLower) != NULL) {
+            TextCopy(outExt, innerLower);
+            found = true;
         }
     }
 
     UnloadDirectoryFiles(entries);
-    UnmountPhysFS(zipPath);
+    if (mounted) UnmountPhysFS(zipPath);
     return found;
 }
 
@@ -1101,15 +2543,16 @@ static int FindCoresForGame(const char* gamePath, char paths[][512], char names[
         }
     }
 
+    // Content goes to the cores listing its extension; no content can go to
+    // any core that supports it. Some cores require "needs_fullpath", like for
+    // CD. We allow attempting to load directly from the .zip for now.
+    LibretroCoreExtBucket* bucket = noGame ? NULL : LibretroCoreExtIndexFind(&menu.coreExtIndex, gameExtLower);
+    int candidates = noGame ? (int)cvector_size(menu.coreInfos) : (bucket != NULL ? (int)cvector_size(bucket->cores) : 0);
     int found = 0;
-    for (int i = 0; i < (int)cvector_size(menu.coreInfos) && found < maxCount; i++) {
+    for (int n = 0; n < candidates && found < maxCount; n++) {
+        int i = noGame ? n : bucket->cores[n];
         LibretroCoreInfo* ci = menu.coreInfos[i];
-        if (noGame) {
-            if (!ci->supportsNoGame) continue;
-        } else {
-            if (!LibretroCoreSupportsExt(i, gameExtLower)) continue;
-            // Some cores require "needs_fullpath", like for CD. We allow attempting to load directly from the .zip for now.
-        }
+        if (noGame && !ci->supportsNoGame) continue;
 
         TextCopy(names[found], LibretroCoreDisplayName(i));
         if (!ci->path[0]) continue;
@@ -1119,7 +2562,19 @@ static int FindCoresForGame(const char* gamePath, char paths[][512], char names[
     return found;
 }
 
-static bool MenuInitCore(const char* corePath) {
+// Look up the scanned .info for a core, by its full path.
+static LibretroCoreInfo* MenuFindCoreInfo(const char* corePath) {
+    for (int i = 0; i < (int)cvector_size(menu.coreInfos); i++) {
+        LibretroCoreInfo* ci = menu.coreInfos[i];
+        if (ci->path[0] && TextIsEqual(corePath, TextFormat("%s/%s", LIBRETRO.coreDirectory, ci->path))) {
+            return ci;
+        }
+    }
+    return NULL;
+}
+
+// dlopen the core and run retro_init(), keeping any content prefetch going.
+static bool MenuStartCore(const char* corePath) {
     if (!InitLibretro(corePath)) return false;
     LoadLibretroCoreOptions();
     SetLibretroVolume(LIBRETRO.volume);
@@ -1129,6 +2584,12 @@ static bool MenuInitCore(const char* corePath) {
     return true;
 }
 
+static bool MenuInitCore(const char* corePath) {
+    // Content still being read was meant for the previous core.
+    CancelLoadLibretroGame();
+    return MenuStartCore(corePath);
+}
+
 /**
  * Load the battery save (SRAM) for the currently loaded game from disk.
  *
@@ -1153,10 +2614,182 @@ static bool MenuLoadGameSRAM(void) {
     }
     bool ok = SetLibretroSRAMData(fileData, (size_t)fileSize);
     UnloadFileData(fileData);
-    if (ok) TraceLog(LOG_INFO, "MENU: SRAM loaded from %s", sramPath);
+    if (ok) {
+        TraceLog(LOG_INFO, "MENU: SRAM loaded from %s", sramPath);
+
+        // The file on disk now mirrors SRAM, so the first auto-save can be
+        // skipped until the game actually writes to it. Only when the file
+        // covered the whole region; a short file still needs a full rewrite.
+        size_t sramSize = 0;
+        void* sramData = GetLibretroSRAMData(&sramSize);
+        if (sramData != NULL && sramSize == (size_t)fileSize) {
+            menu.sramPersistedHash = GetLibretroDataHash(sramData, sramSize);
+            TextCopy(menu.sramPersistedPath, sramPath);
+        }
+    }
     return ok;
 }
 
+#ifdef RAYLIB_LIBRETRO_MENU_SRAM_MMAP
+/**
+ * A .srm file mapped into memory, so persisting SRAM is a memcpy into the
+ * mapping rather than a full-file rewrite. Dirty pages belong to the kernel
+ * once copied, so they still reach the disk if the process dies mid-game; the
+ * worker thread only msync()s to bound how long that takes.
+ */
+typedef struct LibretroMenuSRAMMap {
+    unsigned char* mapping;
+    size_t size;
+    int fd;
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+#ifdef HAVE_THREADS
+    sthread_t* thread;
+    slock_t* lock;
+    scond_t* cond;
+    bool syncPending;
+    bool quit;
+#endif
+} LibretroMenuSRAMMap;
+
+static LibretroMenuSRAMMap menuSRAMMap = { .fd = -1 };
+
+#ifdef HAVE_THREADS
+/**
+ * Worker that flushes the mapping to disk whenever MenuSaveGameSRAM() signals
+ * it, keeping the blocking msync(MS_SYNC) off the main thread.
+ */
+static void MenuSRAMMapSyncThread(void* userData) {
+    LibretroMenuSRAMMap* map = (LibretroMenuSRAMMap*)userData;
+    slock_lock(map->lock);
+    while (!map->quit) {
+        while (!map->syncPending && !map->quit) {
+            scond_wait(map->cond, map->lock);
+        }
+        if (map->syncPending) {
+            map->syncPending = false;
+            slock_unlock(map->lock);
+            msync(map->mapping, map->size, MS_SYNC);
+            slock_lock(map->lock);
+        }
+    }
+    slock_unlock(map->lock);
+}
+#endif
+
+/**
+ * Flush and release the SRAM mapping, if one is open.
+ */
+static void MenuCloseSRAMMap(void) {
+    if (menuSRAMMap.mapping == NULL) return;
+
+#ifdef HAVE_THREADS
+    if (menuSRAMMap.thread != NULL) {
+        slock_lock(menuSRAMMap.lock);
+        menuSRAMMap.quit = true;
+        scond_signal(menuSRAMMap.cond);
+        slock_unlock(menuSRAMMap.lock);
+        sthread_join(menuSRAMMap.thread);
+    }
+    if (menuSRAMMap.cond != NULL) scond_free(menuSRAMMap.cond);
+    if (menuSRAMMap.lock != NULL) slock_free(menuSRAMMap.lock);
+    menuSRAMMap.thread = NULL;
+    menuSRAMMap.cond = NULL;
+    menuSRAMMap.lock = NULL;
+    menuSRAMMap.syncPending = false;
+    menuSRAMMap.quit = false;
+#endif
+
+    msync(menuSRAMMap.mapping, menuSRAMMap.size, MS_SYNC);
+    munmap(menuSRAMMap.mapping, menuSRAMMap.size);
+    close(menuSRAMMap.fd);
+    menuSRAMMap.mapping = NULL;
+    menuSRAMMap.size = 0;
+    menuSRAMMap.fd = -1;
+    menuSRAMMap.path[0] = '\0';
+}
+
+/**
+ * Map the first @p size bytes of @p path read/write and shared, creating the
+ * file or growing it as needed. A longer file keeps its tail. Reuses the current mapping when it
+ * already matches, so this is cheap to call on every save.
+ *
+ * @return true if menuSRAMMap is ready to receive @p size bytes.
+ */
+static bool MenuOpenSRAMMap(const char* path, size_t size) {
+    if (menuSRAMMap.mapping != NULL && menuSRAMMap.size == size && TextIsEqual(menuSRAMMap.path, path)) {
+        return true;
+    }
+
+    // A different game, or a core whose SRAM size isn't stable; start over.
+    MenuCloseSRAMMap();
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        TraceLog(LOG_WARNING, "MENU: Failed to open %s for SRAM mapping", path);
+        return false;
+    }
+    // Only ever grow the file; a core that saves less than an existing .srm
+    // holds, or one whose SRAM size changed, mustn't cut off the rest.
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (st.st_size < (off_t)size && ftruncate(fd, (off_t)size) != 0)) {
+        TraceLog(LOG_WARNING, "MENU: Failed to size %s for SRAM mapping", path);
+        close(fd);
+        return false;
+    }
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        TraceLog(LOG_WARNING, "MENU: Failed to map %s", path);
+        close(fd);
+        return false;
+    }
+
+    menuSRAMMap.mapping = (unsigned char*)mapping;
+    menuSRAMMap.size = size;
+    menuSRAMMap.fd = fd;
+    TextCopy(menuSRAMMap.path, path);
+
+#ifdef HAVE_THREADS
+    menuSRAMMap.lock = slock_new();
+    menuSRAMMap.cond = scond_new();
+    if (menuSRAMMap.lock != NULL && menuSRAMMap.cond != NULL) {
+        menuSRAMMap.thread = sthread_create(MenuSRAMMapSyncThread, &menuSRAMMap);
+    }
+    if (menuSRAMMap.thread == NULL) {
+        // Without the worker, MenuSaveGameSRAM() syncs inline instead.
+        TraceLog(LOG_WARNING, "MENU: SRAM sync thread unavailable, syncing on the main thread");
+    }
+#endif
+
+    TraceLog(LOG_INFO, "MENU: SRAM mapped to %s (%u bytes)", path, (unsigned int)size);
+    return true;
+}
+
+/**
+ * Copy SRAM into the mapped .srm and schedule it to be synced to disk.
+ *
+ * @return true if the data was handed to the mapping.
+ */
+static bool MenuWriteSRAMMap(const char* path, const void* data, size_t size) {
+    if (!MenuOpenSRAMMap(path, size)) return false;
+    memcpy(menuSRAMMap.mapping, data, size);
+
+#ifdef HAVE_THREADS
+    if (menuSRAMMap.thread != NULL) {
+        slock_lock(menuSRAMMap.lock);
+        menuSRAMMap.syncPending = true;
+        scond_signal(menuSRAMMap.cond);
+        slock_unlock(menuSRAMMap.lock);
+        return true;
+    }
+#endif
+
+    msync(menuSRAMMap.mapping, menuSRAMMap.size, MS_ASYNC);
+    return true;
+}
+#else
+#define MenuCloseSRAMMap() ((void)0)
+#endif // RAYLIB_LIBRETRO_MENU_SRAM_MMAP
+
 /**
  * Save the battery save (SRAM) for the currently loaded game to disk.
  *
@@ -1164,7 +2797,16 @@ static bool MenuLoadGameSRAM(void) {
  * core's SRAM region (obtained via @ref GetLibretroSRAMData) to that file.
  * Does nothing when no game is ready or the core has no SRAM region.
  *
- * @return true  if SRAM data exists and was written to disk successfully.
+ * The region is hashed first, and the write is skipped when it matches what was
+ * last persisted to the same file, so periodic auto-saves don't rewrite an
+ * unchanged .srm (and wear flash storage) every interval. The outcome is tallied
+ * in menu.sramWritesPerformed and menu.sramWritesSkipped.
+ *
+ * With menu.sramMemoryMapped on (POSIX only), the data is copied into a
+ * memory-mapped .srm and synced on a background thread rather than rewritten
+ * with SaveFileData(). Falls back to SaveFileData() if the mapping fails.
+ *
+ * @return true  if SRAM data exists and is on disk, either written now or unchanged.
  * @return false if no game is ready, no SRAM region exists, or the write failed.
  */
 static bool MenuSaveGameSRAM(void) {
@@ -1175,9 +2817,32 @@ static bool MenuSaveGameSRAM(void) {
     const char* sramPath = TextFormat("%s/%s.srm",
         GetLibretroDirectory(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY),
         GetLibretroContentName());
-    bool ok = SaveFileData(sramPath, sramData, (unsigned int)sramSize);
+
+    uint64_t hash = GetLibretroDataHash(sramData, sramSize);
+    if (hash == menu.sramPersistedHash && TextIsEqual(sramPath, menu.sramPersistedPath) && FileExists(sramPath)) {
+        menu.sramWritesSkipped++;
+        TraceLog(LOG_DEBUG, "MENU: SRAM unchanged, skipped write (%u written, %u skipped)",
+            menu.sramWritesPerformed, menu.sramWritesSkipped);
+        return true;
+    }
+
+    bool ok = false;
+#ifdef RAYLIB_LIBRETRO_MENU_SRAM_MMAP
+    if (menu.sramMemoryMapped) {
+        ok = MenuWriteSRAMMap(sramPath, sramData, sramSize);
+    } else {
+        MenuCloseSRAMMap();
+    }
+#endif
+    if (!ok) {
+        ok = SaveFileData(sramPath, sramData, (unsigned int)sramSize);
+    }
     if (ok) {
-        TraceLog(LOG_INFO, "MENU: SRAM saved to %s", sramPath);
+        menu.sramPersistedHash = hash;
+        TextCopy(menu.sramPersistedPath, sramPath);
+        menu.sramWritesPerformed++;
+        TraceLog(LOG_INFO, "MENU: SRAM saved to %s (%u written, %u skipped)", sramPath,
+            menu.sramWritesPerformed, menu.sramWritesSkipped);
         LibretroFlushPersistentStorage();
     }
     return ok;
@@ -1214,25 +2879,119 @@ static void MenuTickSRAMAutoSave(void) {
     }
 }
 
-static bool MenuDoLoadGame(const char* gamePath) {
-    if (!LoadLibretroGameFromPhysFS(gamePath)) {
-        if (IsLibretroGameRequired()) {
-            nk_console_show_message(menu.console, "Failed to load game");
-            return false;
-        }
-        if (!LoadLibretroGame(NULL)) {
-            nk_console_show_message(menu.console, "Failed to load core");
-            return false;
-        }
+#ifndef LIBRETRO_MENU_TIMELINE_PHASES
+/**
+ * The most phases recorded by the load timeline.
+ */
+#define LIBRETRO_MENU_TIMELINE_PHASES 12
+#endif
+
+/**
+ * When each phase of loading a game finished, from picking the file to the
+ * first frame, logged once the first frame has run.
+ */
+typedef struct LibretroMenuTimeline {
+    int64_t start;          // cpu_features_get_time_usec() when the file was picked, 0 when not timing
+    const char* phases[LIBRETRO_MENU_TIMELINE_PHASES];
+    int64_t ends[LIBRETRO_MENU_TIMELINE_PHASES];
+    int count;
+    bool awaitingFirstFrame;
+} LibretroMenuTimeline;
+
+static LibretroMenuTimeline menuTimeline;
+
+static void MenuTimelineBegin(void) {
+    menuTimeline.start = (int64_t)cpu_features_get_time_usec();
+    menuTimeline.count = 0;
+    menuTimeline.awaitingFirstFrame = false;
+}
+
+static void MenuTimelineMark(const char* phase) {
+    if (menuTimeline.start == 0 || menuTimeline.count >= LIBRETRO_MENU_TIMELINE_PHASES) return;
+    menuTimeline.phases[menuTimeline.count] = phase;
+    menuTimeline.ends[menuTimeline.count] = (int64_t)cpu_features_get_time_usec();
+    menuTimeline.count++;
+}
+
+// Log each phase's end and duration, and when the content was read on the
+// worker, which overlaps the phases around it.
+static void MenuTimelineLog(void) {
+    if (menuTimeline.start == 0) return;
+    TraceLog(LOG_INFO, "MENU: Load timeline (ms since the game was picked):");
+    int64_t previous = menuTimeline.start;
+    for (int i = 0; i < menuTimeline.count; i++) {
+        TraceLog(LOG_INFO, "MENU:   %8.1f  %-20s +%.1f", (menuTimeline.ends[i] - menuTimeline.start) / 1000.0,
+            menuTimeline.phases[i], (menuTimeline.ends[i] - previous) / 1000.0);
+        previous = menuTimeline.ends[i];
+    }
+    int64_t readStart, readEnd;
+    if (GetLibretroGameLoadReadTime(&readStart, &readEnd) && readStart >= menuTimeline.start) {
+        TraceLog(LOG_INFO, "MENU:   content read on a worker from %.1f to %.1f (%.1f)",
+            (readStart - menuTimeline.start) / 1000.0, (readEnd - menuTimeline.start) / 1000.0, (readEnd - readStart) / 1000.0);
+    }
+    menuTimeline.start = 0;
+    menuTimeline.awaitingFirstFrame = false;
+}
+
+// Called before the menu's per-frame work, so the frame run since the game
+// loaded has been presented.
+static void MenuTimelineTickFirstFrame(void) {
+    if (!menuTimeline.awaitingFirstFrame || menu.active || !IsLibretroGameReady()) return;
+    MenuTimelineMark("first frame");
+    MenuTimelineLog();
+}
+
+// The content could not be loaded; cores that run without content are started
+// without it instead.
+static bool MenuLoadGameFailed(void) {
+    menuTimeline.start = 0;
+    if (IsLibretroGameRequired()) {
+        nk_console_show_message(menu.console, "Failed to load game");
+        return false;
     }
+    if (!LoadLibretroGame(NULL)) {
+        nk_console_show_message(menu.console, "Failed to load core");
+        return false;
+    }
+    return true;
+}
+
+// Everything after the core accepted the content.
+static bool MenuFinishLoadGame(const char* gamePath) {
     BuildLibretroMenuOptions(&menu);
     LoadLibretroPortDevices();
     BuildLibretroMenuControllers(&menu);
     HideLibretroMenu();
     MenuLoadGameSRAM();
+    // States from the previous game can't be undone into this one.
+    ClearLibretroStateRing(&menu.undoHistory);
+    // The next game likely comes from the same directory; index its archives.
+    if (gamePath != NULL) WarmLibretroZipIndex(GetDirectoryPath(gamePath));
+    MenuTimelineMark("game set up");
+    menuTimeline.awaitingFirstFrame = true;
     return true;
 }
 
+/**
+ * Start loading a game into the initialized core.
+ *
+ * Content is read on a worker so the window keeps drawing; MenuPollGameLoad()
+ * finishes the load once it has been read. Returns true while that is pending.
+ */
+static bool MenuDoLoadGame(const char* gamePath) {
+    menu.loadingGamePath[0] = '\0';
+    if (!BeginLoadLibretroGameFromPhysFS(gamePath)) {
+        if (!MenuLoadGameFailed()) return false;
+    } else if (IsLibretroGameLoading()) {
+        MenuTimelineMark("content opened");
+        TextCopy(menu.loadingGamePath, gamePath);
+        HideLibretroMenu();
+        return true;
+    }
+    MenuTimelineMark("retro_load_game");
+    return MenuFinishLoadGame(gamePath);
+}
+
 // Draw a one-frame "Loading <game>" splash, shown right before a (potentially
 // slow) core init + game load so there is feedback during the stall.
 /** */
@@ -1267,13 +3026,29 @@ static void MenuDrawLoadingScreen(const char* gamePath) {
 
 /**
  * Initialize the given core, and load the associated game.
+ *
+ * Content the core takes as data starts reading on a worker first, so it
+ * overlaps the core's dlopen and retro_init().
  */
 static bool MenuLoadCoreAndGame(const char* corePath, const char* gamePath) {
+    // Time from here when the core came from the picker, not from the pick.
+    if (menuTimeline.start == 0) MenuTimelineBegin();
+
+    CancelLoadLibretroGame();
+    LibretroCoreInfo* coreInfo = MenuFindCoreInfo(corePath);
+    if (gamePath != NULL && coreInfo != NULL && !coreInfo->needsFullpath &&
+            PrefetchLibretroGameFromPhysFS(gamePath, coreInfo->supportedExtensions)) {
+        MenuTimelineMark("prefetch started");
+    }
+
     MenuDrawLoadingScreen(gamePath);
-    if (!MenuInitCore(corePath)) {
+    if (!MenuStartCore(corePath)) {
+        CancelLoadLibretroGame();
+        menuTimeline.start = 0;
         nk_console_show_message(menu.console, "Failed to load core");
         return false;
     }
+    MenuTimelineMark("core initialized");
     return MenuDoLoadGame(gamePath);
 }
 
@@ -1341,14 +3116,19 @@ static void MenuShowCorePicker(nk_console* widget, void* user_data) {
 }
 
 static bool MenuLoadGame(const char* gamePath) {
+    MenuTimelineBegin();
+
     // Unload the current game if it's a thing.
     if (IsLibretroGameReady()) {
         UnloadLibretroGame();
     }
 
-    // Find all cores that support this file type.
+    // Find all cores that support this file type, once the scan has seen them all.
+    MenuWaitCoreScan();
     int coreCount = FindCoresForGame(gamePath, menu.pendingCorePaths, menu.pendingCoreNames, LIBRETRO_MAX_GAME_CORES);
+    MenuTimelineMark("find core");
     if (coreCount == 0) {
+        menuTimeline.start = 0;
         nk_console_show_message(menu.console, TextFormat("No core found for %s", GetFileName(gamePath)));
         return false;
     }
@@ -1357,6 +3137,7 @@ static bool MenuLoadGame(const char* gamePath) {
         // Defer opening the picker to a post-render event.
         TextCopy(menu.pendingGamePath, gamePath);
         menu.pendingCoreCount = coreCount;
+        menuTimeline.start = 0;
         ShowLibretroMenu();
         nk_console_add_event(menu.console, NK_CONSOLE_EVENT_POST_RENDER_ONCE, &MenuShowCorePicker);
         return false;
@@ -1382,11 +3163,22 @@ static void LibretroMenuLoadStateClicked(nk_console* widget, void* user_data) {
     (void)user_data;
     if (!IsLibretroGameReady()) return;
     int dataSize;
-    const char* savesDir = GetLibretroDirectory(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY);
-    void* saveData = LoadFileData(TextFormat("%s/%s_%02d.sav", savesDir, GetLibretroContentName(), menu.saveSlotIndex + 1), &dataSize);
+    void* saveData = LoadFileData(LibretroMenuStatePath(menu.saveSlotIndex), &dataSize);
     if (saveData != NULL) {
-        SetLibretroSerializedData(saveData, (unsigned int)dataSize);
-        MemFree(saveData);
+        // Snapshot the running game first so the load can be undone, and
+        // keep it once the load went through.
+        unsigned int currentSize = 0;
+        void* current = GetLibretroSerializedData(&currentSize);
+        bool loaded = SetLibretroSerializedData(saveData, (unsigned int)dataSize);
+        UnloadFileData(saveData);
+        if (!loaded) {
+            if (current != NULL) MemFree(current);
+            SetLibretroMessage("Load State failed", 2.0);
+            return;
+        }
+        if (current != NULL) {
+            LibretroStateRingPush(&menu.undoHistory, current, currentSize, LIBRETRO_MENU_UNDO_LOAD);
+        }
         // A save-state load is a one-shot wall-clock discontinuity; drop the
         // accumulator backlog so the next frame doesn't burst to catch up.
         ResetLibretroTiming();
@@ -1398,7 +3190,39 @@ static void LibretroMenuLoadStateClicked(nk_console* widget, void* user_data) {
     }
 }
 
-static void LibretroMenuUpdateLoadGameFilter(LibretroMenu* m);
+/**
+ * Revert the most recent Save State or Load State from the in-memory undo
+ * history: a save puts the slot's previous file and thumbnail back (or
+ * removes them if the slot was empty), and a load restores the state that
+ * was running before it.
+ */
+static void LibretroMenuUndoStateClicked(nk_console* widget, void* user_data) {
+    (void)widget;
+    (void)user_data;
+    if (!IsLibretroGameReady()) return;
+
+    void* data = NULL;
+    unsigned int size = 0;
+    int tag = 0;
+    if (!LibretroStateRingPop(&menu.undoHistory, &data, &size, &tag)) {
+        SetLibretroMessage("Nothing to undo", 2.0);
+        return;
+    }
+
+    if (tag == LIBRETRO_MENU_UNDO_LOAD) {
+        // Only restore if the core would still accept a state of this size.
+        bool ok = data != NULL && size == GetLibretroSerializedSize() && SetLibretroSerializedData(data, size);
+        if (ok) ResetLibretroTiming();
+        SetLibretroMessage(ok ? "Load State undone" : "Undo failed", 2.0);
+    } else {
+        // The save's own thumbnail may still be on its way to the slot.
+        MenuFlushImageWriter();
+        bool ok = LibretroMenuRestoreUndoSlot(tag, data, size);
+        LibretroFlushPersistentStorage();
+        SetLibretroMessage(ok ? TextFormat("Slot %d Save undone", tag + 1) : "Undo failed", 2.0);
+    }
+    if (data != NULL) MemFree(data);
+}
 
 /**
  * Event that's triggered when a menu hot key was changed.
@@ -1471,6 +3295,7 @@ LibretroMenu* InitLibretroMenu(void) {
     // When trying to go back from the main menu, exit the menu.
     nk_console_add_event(menu.console, NK_CONSOLE_EVENT_BACK, &MenuResumeClicked);
 
+    BeginLibretroProfile("Load settings");
     menu.cfg = rlconfig_load(RAYLIB_LIBRETRO_CFG_FILE);
 
     // Directories
@@ -1485,16 +3310,23 @@ LibretroMenu* InitLibretroMenu(void) {
     TextCopy(LIBRETRO.systemDirectory, "/userdata/system");
 #endif
 
+    // Save state undo history
+    InitLibretroStateRing(&menu.undoHistory, LIBRETRO_MENU_UNDO_LEVELS, LIBRETRO_MENU_UNDO_MAX_BYTES, true);
+
     // Menu Settings
     LoadLibretroMenuSettings();
     LibretroMenuEnsureSaveDir();
+    EndLibretroProfile();
+    BeginLibretroProfile("Scan cores");
     ScanLibretroCoreDirectory();
+    EndLibretroProfile();
 
     // Apply VSYNC/FPS even when no config was loaded, so the frame cap is always
     // in place (defends against a vsync hint the driver/compositor ignores).
     LibretroMenuApplyVideoSettings();
 
     // Build the Menu
+    BeginLibretroProfile("Build menu");
     menu.resumeButton = nk_console_button_onclick(menu.console, "Resume", &MenuResumeClicked);
     nk_console_button_set_symbol(menu.resumeButton, NK_SYMBOL_TRIANGLE_RIGHT);
 
@@ -1510,6 +3342,10 @@ LibretroMenu* InitLibretroMenu(void) {
         menu.loadStateButton = nk_console_button(saveStateRow, "Load State");
         nk_console_add_event(menu.loadStateButton, NK_CONSOLE_EVENT_CLICKED, &LibretroMenuLoadStateClicked);
         nk_console_button_set_symbol(menu.loadStateButton, NK_SYMBOL_RECT_OUTLINE);
+
+        // Undo the last Save State / Load State
+        menu.undoStateButton = nk_console_button(saveStateRow, "Undo");
+        nk_console_add_event(menu.undoStateButton, NK_CONSOLE_EVENT_CLICKED, &LibretroMenuUndoStateClicked);
         nk_console_row_end(saveStateRow);
     }
 
@@ -1550,6 +3386,8 @@ LibretroMenu* InitLibretroMenu(void) {
     nk_console_add_event_handler(menu.loadGameWidget, NK_CONSOLE_EVENT_CHANGED, &MenuGameFileChanged, menu.loadGamePath, NULL);
     if (LIBRETRO.fileBrowserStartDirectory[0] != '\0') {
         nk_console_file_set_directory(menu.loadGameWidget, LIBRETRO.fileBrowserStartDirectory);
+        // Index the archives the browser opens on before they're selected.
+        WarmLibretroZipIndex(LIBRETRO.fileBrowserStartDirectory);
     }
 #endif
     LibretroMenuUpdateLoadGameFilter(&menu);
@@ -1688,6 +3526,12 @@ LibretroMenu* InitLibretroMenu(void) {
                 "Off|15s|30s|1m|2m|5m|10m", '|', &menu.sramAutoSaveIndex)
                 ->tooltip = "Periodically save battery data to disk";
 
+            // Memory-Mapped SRAM
+            #ifdef RAYLIB_LIBRETRO_MENU_SRAM_MMAP
+            nk_console_checkbox(gameplayMenu, "Memory-Mapped SRAM", &menu.sramMemoryMapped)
+                ->tooltip = "Mirror battery data into a mapped .srm file, synced in the background";
+            #endif
+
             // Username
             nk_console_textedit(gameplayMenu, "Username", LIBRETRO.username, 128);
         }
@@ -1828,15 +3672,9 @@ LibretroMenu* InitLibretroMenu(void) {
             nk_console_label(coreTree, menu.aboutContent);
             nk_console_label(coreTree, menu.aboutExtensions);
 
-            // Available Cores
-            nk_console* coresTree = nk_console_tree(aboutMenu, "Available Cores", nk_true);
-            if (cvector_size(menu.coreInfos) == 0) {
-                nk_console_label(coresTree, "(none found)");
-            }
-            for (int i = 0; i < (int)cvector_size(menu.coreInfos); i++) {
-                LibretroCoreInfo* ci = menu.coreInfos[i];
-                nk_console_label(coresTree, LibretroCoreDisplayName(i));
-            }
+            // Available Cores, filled in as the core scan finds them
+            menu.availableCoresTree = nk_console_tree(aboutMenu, "Available Cores", nk_true);
+            LibretroMenuUpdateAvailableCores();
 
             nk_console_rule_horizontal(aboutMenu, nk_rgba(0,0,0,0), nk_false);
             nk_console_button_set_symbol(
@@ -1856,6 +3694,8 @@ LibretroMenu* InitLibretroMenu(void) {
     menu.corePickerMenu = nk_console_button(menu.console, "Select Core");
     menu.corePickerMenu->visible = nk_false;
 
+    EndLibretroProfile();
+
     ShowLibretroMenu();
     return &menu;
 }
@@ -1903,12 +3743,13 @@ static bool LibretroMenuTokenIsFalsy(const char* tok) {
 static void LibretroMenuOptionChanged(nk_console* widget, void* user_data) {
     (void)widget;
     unsigned i = (unsigned)(uintptr_t)user_data;
+    if (i >= LIBRETRO.core.variableCount) return;
     char value[LIBRETRO_CORE_VARIABLE_VALUE_LEN] = {0};
-    LibretroMenuGetNthToken(LIBRETRO.core.variableValuesList[i],
+    LibretroMenuGetNthToken(LIBRETRO.core.variables[i].valuesList,
                             menu.optionSelectedIndices[i],
                             value, LIBRETRO_CORE_VARIABLE_VALUE_LEN);
     if (TextLength(value) > 0) {
-        SetLibretroCoreOption(LIBRETRO.core.variableKeys[i], value);
+        SetLibretroCoreOption(LIBRETRO.core.variables[i].key, value);
     }
 }
 
@@ -1920,15 +3761,16 @@ static void LibretroMenuOptionChanged(nk_console* widget, void* user_data) {
 static void LibretroMenuOptionCheckboxChanged(nk_console* widget, void* user_data) {
     (void)widget;
     unsigned i = (unsigned)(uintptr_t)user_data;
+    if (i >= LIBRETRO.core.variableCount) return;
     char tok0[LIBRETRO_CORE_VARIABLE_VALUE_LEN] = {0};
     char tok1[LIBRETRO_CORE_VARIABLE_VALUE_LEN] = {0};
-    LibretroMenuGetNthToken(LIBRETRO.core.variableValuesList[i], 0, tok0, sizeof(tok0));
-    LibretroMenuGetNthToken(LIBRETRO.core.variableValuesList[i], 1, tok1, sizeof(tok1));
+    LibretroMenuGetNthToken(LIBRETRO.core.variables[i].valuesList, 0, tok0, sizeof(tok0));
+    LibretroMenuGetNthToken(LIBRETRO.core.variables[i].valuesList, 1, tok1, sizeof(tok1));
     // Map checked->truthy token, unchecked->falsy token, regardless of order.
     bool tok0Truthy = LibretroMenuTokenIsTruthy(tok0);
     const char* truthy = tok0Truthy ? tok0 : tok1;
     const char* falsy  = tok0Truthy ? tok1 : tok0;
-    SetLibretroCoreOption(LIBRETRO.core.variableKeys[i],
+    SetLibretroCoreOption(LIBRETRO.core.variables[i].key,
                           menu.optionCheckboxValues[i] ? truthy : falsy);
 }
 
@@ -1991,9 +3833,9 @@ static bool LibretroMenuIsBooleanOption(const char* valuesList) {
  * Returns the registered category index for option i, or -1 if it has no category (or references a category the core never declared — treated flat).
  */
 static int LibretroMenuOptionCategory(unsigned i) {
-    if (LIBRETRO.core.variableCategoryKeys[i][0] == '\0') return -1;
+    if (LIBRETRO.core.variables[i].categoryKey[0] == '\0') return -1;
     for (unsigned c = 0; c < LIBRETRO.core.categoryCount; c++) {
-        if (TextIsEqual(LIBRETRO.core.variableCategoryKeys[i], LIBRETRO.core.categoryKeys[c])) {
+        if (TextIsEqual(LIBRETRO.core.variables[i].categoryKey, LIBRETRO.core.categoryKeys[c])) {
             return (int)c;
         }
     }
@@ -2004,25 +3846,25 @@ static int LibretroMenuOptionCategory(unsigned i) {
  * Build the checkbox/combobox widget for option i under the given parent node.
  */
 static void LibretroMenuBuildOptionWidget(LibretroMenu* m, nk_console* parent, unsigned i) {
-    const char* label = TextLength(LIBRETRO.core.variableLabels[i]) > 0
-        ? LIBRETRO.core.variableLabels[i]
-        : LIBRETRO.core.variableKeys[i];
+    const char* label = TextLength(LIBRETRO.core.variables[i].label) > 0
+        ? LIBRETRO.core.variables[i].label
+        : LIBRETRO.core.variables[i].key;
 
     nk_console* widget;
 
-    if (LibretroMenuIsBooleanOption(LIBRETRO.core.variableValuesList[i])) {
-        m->optionCheckboxValues[i] = (nk_bool)LibretroMenuTokenIsTruthy(LIBRETRO.core.variableValues[i]);
+    if (LibretroMenuIsBooleanOption(LIBRETRO.core.variables[i].valuesList)) {
+        m->optionCheckboxValues[i] = (nk_bool)LibretroMenuTokenIsTruthy(LIBRETRO.core.variables[i].value);
         widget = nk_console_checkbox(parent, label, &m->optionCheckboxValues[i]);
         nk_console_add_event_handler(widget, NK_CONSOLE_EVENT_CHANGED,
                                      LibretroMenuOptionCheckboxChanged,
                                      (void*)(uintptr_t)i, NULL);
     } else {
         m->optionSelectedIndices[i] = LibretroMenuFindTokenIndex(
-            LIBRETRO.core.variableValuesList[i], LIBRETRO.core.variableValues[i]);
+            LIBRETRO.core.variables[i].valuesList, LIBRETRO.core.variables[i].value);
 
-        const char* displayStr = TextLength(LIBRETRO.core.variableDisplayList[i]) > 0
-            ? LIBRETRO.core.variableDisplayList[i]
-            : LIBRETRO.core.variableValuesList[i];
+        const char* displayStr = TextLength(LIBRETRO.core.variables[i].displayList) > 0
+            ? LIBRETRO.core.variables[i].displayList
+            : LIBRETRO.core.variables[i].valuesList;
 
         widget = nk_console_combobox(parent, label,
                                      displayStr, '|',
@@ -2032,8 +3874,8 @@ static void LibretroMenuBuildOptionWidget(LibretroMenu* m, nk_console* parent, u
                                      (void*)(uintptr_t)i, NULL);
     }
 
-    if (TextLength(LIBRETRO.core.variableTooltips[i]) > 0) {
-        widget->tooltip = LIBRETRO.core.variableTooltips[i];
+    if (TextLength(LIBRETRO.core.variables[i].tooltip) > 0) {
+        widget->tooltip = LIBRETRO.core.variables[i].tooltip;
     }
 }
 
@@ -2045,33 +3887,6 @@ static void LibretroMenuResetCoreOptionsClicked(nk_console* widget, void* user_d
     nk_console_navigate_back(widget->parent);
 }
 
-/**
- * Append an extension token to the pipe-separated list if it is not already present and there is room. Returns the updated list length.
- */
-static unsigned int LibretroMenuAddExtension(char* list, unsigned int len, size_t cap,
-                                             const char* tok, unsigned int tokLen) {
-    if (tokLen == 0) return len;
-
-    // Skip if the token already exists as a whole entry in the list.
-    for (const char* p = list; *p != '\0'; ) {
-        const char* end = p;
-        while (*end != '\0' && *end != '|') end++;
-        if ((unsigned int)(end - p) == tokLen) {
-            unsigned int k = 0;
-            while (k < tokLen && p[k] == tok[k]) k++;
-            if (k == tokLen) return len;
-        }
-        p = (*end == '|') ? end + 1 : end;
-    }
-
-    // +2 reserves the '|' separator and the null terminator.
-    if (len + tokLen + 2 >= cap) return len;
-    if (len > 0) list[len++] = '|';
-    TextCopy(list + len, TextSubtext(tok, 0, (int)tokLen));
-    len += tokLen;
-    return len;
-}
-
 static void LibretroMenuUpdateLoadGameFilter(LibretroMenu* m) {
 #if defined(__EMSCRIPTEN__) || defined(PLATFORM_WEB) || defined(__ANDROID__) || defined(PLATFORM_ANDROID)
     (void)m;
@@ -2079,37 +3894,9 @@ static void LibretroMenuUpdateLoadGameFilter(LibretroMenu* m) {
 #endif
     if (!m || !m->loadGameWidget) return;
 
-    // Collect the unique set of extensions from every cached core. Cores
-    // commonly share extensions (zip, bin, cue, ...), so dedup the tokens —
-    // otherwise duplicates eat into the buffer and distinct extensions from
-    // later cores get dropped once it fills.
-    char allExts[1024] = {0};
-    unsigned int allLen = 0;
-    for (int i = 0; i < (int)cvector_size(m->coreInfos); i++) {
-        const char* exts = m->coreInfos[i]->supportedExtensions;
-        if (exts[0] == '\0') continue;
-        // Split this core's "ext1|ext2|..." list and add each token once.
-        for (const char* tok = exts; *tok != '\0'; ) {
-            const char* end = tok;
-            while (*end != '\0' && *end != '|') end++;
-            allLen = LibretroMenuAddExtension(allExts, allLen, sizeof(allExts), tok, (unsigned int)(end - tok));
-            tok = (*end == '|') ? end + 1 : end;
-        }
-    }
-
-    // Archives are browsable regardless of core; add "zip" to the set (deduped,
-    // in case a core already declared it).
-    allLen = LibretroMenuAddExtension(allExts, allLen, sizeof(allExts), "zip", 3);
-
-    if (allLen == 0) {
-        nk_console_file_set_filter(m->loadGameWidget, NULL);
-        return;
-    }
-
-    // "a|b" expands to ".a;.b" (under 2x), so this can never truncate.
-    char filter[sizeof(allExts) * 2];
-    GetLibretroFileExtensionPattern(allExts, filter, sizeof(filter));
-    nk_console_file_set_filter(m->loadGameWidget, filter);
+    // Every extension of every scanned core, prebuilt by the extension index
+    // as the cores were added. Archives are browsable regardless of core.
+    nk_console_file_set_filter(m->loadGameWidget, m->coreExtIndex.filter != NULL ? m->coreExtIndex.filter : ".zip");
 }
 
 void BuildLibretroMenuOptions(LibretroMenu* m) {
@@ -2130,12 +3917,30 @@ void BuildLibretroMenuOptions(LibretroMenu* m) {
         return;
     }
 
+    // The widgets point into these, so only grow them once the old widgets are gone.
+    if (LIBRETRO.core.variableCount > m->optionStateCapacity) {
+        MemFree(m->optionSelectedIndices);
+        MemFree(m->optionCheckboxValues);
+        m->optionSelectedIndices = (int*)MemAlloc(LIBRETRO.core.variableCount * sizeof(int));
+        m->optionCheckboxValues = (nk_bool*)MemAlloc(LIBRETRO.core.variableCount * sizeof(nk_bool));
+        if (m->optionSelectedIndices == NULL || m->optionCheckboxValues == NULL) {
+            MemFree(m->optionSelectedIndices);
+            MemFree(m->optionCheckboxValues);
+            m->optionSelectedIndices = NULL;
+            m->optionCheckboxValues = NULL;
+            m->optionStateCapacity = 0;
+            m->optionsMenu->visible = nk_false;
+            return;
+        }
+        m->optionStateCapacity = LIBRETRO.core.variableCount;
+    }
+
     // Count how many options will actually be shown. If none are visible
     // (e.g. all hidden by options_update_display_callback), hide the button
     // rather than showing an empty submenu.
     int shownCount = 0;
     for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        if (TextLength(LIBRETRO.core.variableValuesList[i]) > 0 && LIBRETRO.core.variableVisible[i]) {
+        if (TextLength(LIBRETRO.core.variables[i].valuesList) > 0 && LIBRETRO.core.variables[i].visible) {
             shownCount++;
         }
     }
@@ -2153,8 +3958,8 @@ void BuildLibretroMenuOptions(LibretroMenu* m) {
     // Uncategorized options first, directly under Core Options, so they appear
     // above the per-category submenus rather than below them.
     for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        if (TextLength(LIBRETRO.core.variableValuesList[i]) == 0) continue;
-        if (!LIBRETRO.core.variableVisible[i]) continue;
+        if (TextLength(LIBRETRO.core.variables[i].valuesList) == 0) continue;
+        if (!LIBRETRO.core.variables[i].visible) continue;
         if (LibretroMenuOptionCategory(i) >= 0) continue; // belongs to a category submenu
         LibretroMenuBuildOptionWidget(m, m->optionsMenu, i);
     }
@@ -2164,8 +3969,8 @@ void BuildLibretroMenuOptions(LibretroMenu* m) {
         // Skip categories with no visible options.
         bool hasVisible = false;
         for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-            if (!LIBRETRO.core.variableVisible[i]) continue;
-            if (TextLength(LIBRETRO.core.variableValuesList[i]) == 0) continue;
+            if (!LIBRETRO.core.variables[i].visible) continue;
+            if (TextLength(LIBRETRO.core.variables[i].valuesList) == 0) continue;
             if (LibretroMenuOptionCategory(i) == (int)c) { hasVisible = true; break; }
         }
         if (!hasVisible) continue;
@@ -2178,8 +3983,8 @@ void BuildLibretroMenuOptions(LibretroMenu* m) {
             NK_SYMBOL_TRIANGLE_UP);
 
         for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-            if (TextLength(LIBRETRO.core.variableValuesList[i]) == 0) continue;
-            if (!LIBRETRO.core.variableVisible[i]) continue;
+            if (TextLength(LIBRETRO.core.variables[i].valuesList) == 0) continue;
+            if (!LIBRETRO.core.variables[i].visible) continue;
             if (LibretroMenuOptionCategory(i) != (int)c) continue;
             LibretroMenuBuildOptionWidget(m, categoryButton, i);
         }
@@ -2260,16 +4065,32 @@ static void LibretroMenuLoadString(const char* key, char* dest) {
 }
 
 // Write the loaded core's options into its [libraryName] section (no disk flush).
-// No-op when no core is loaded or it exposed no variables.
+// No-op when no core is loaded, it exposed no variables, or the section
+// already holds exactly these values.
 static void LibretroMenuWriteCoreOptions(void) {
     const char* coreName = LIBRETRO.core.libraryName;
     if (!menu.cfg || !coreName || !coreName[0] || LIBRETRO.core.variableCount == 0) return;
+    bool unchanged = rlconfig_section_size(menu.cfg, coreName) == (int)LIBRETRO.core.variableCount;
+    for (unsigned i = 0; i < LIBRETRO.core.variableCount && unchanged; i++) {
+        const char* saved = rlconfig_get(menu.cfg, coreName, LIBRETRO.core.variables[i].key);
+        unchanged = saved != NULL && TextIsEqual(saved, LIBRETRO.core.variables[i].value);
+    }
+    if (unchanged) return;
     rlconfig_clear_section(menu.cfg, coreName);
     for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        rlconfig_set(menu.cfg, coreName, LIBRETRO.core.variableKeys[i], LIBRETRO.core.variableValues[i]);
+        rlconfig_set(menu.cfg, coreName, LIBRETRO.core.variables[i].key, LIBRETRO.core.variables[i].value);
     }
 }
 
+// Config key for a hotkey: prefix followed by its name without spaces, e.g. "keyFastForward".
+static void LibretroMenuHotkeyConfigKey(char* out, size_t outSize, const char* prefix, const char* name) {
+    size_t len = (size_t)snprintf(out, outSize, "%s", prefix);
+    for (const char* c = name; *c != '\0' && len + 1 < outSize; c++) {
+        if (*c != ' ') out[len++] = *c;
+    }
+    out[len < outSize ? len : outSize - 1] = '\0';
+}
+
 static void LibretroMenuUpdateConfig(void) {
     if (!menu.cfg) return;
     if (!IsWindowFullscreen()) {
@@ -2297,15 +4118,20 @@ static void LibretroMenuUpdateConfig(void) {
 
     rlconfig_set_int(menu.cfg, "raylib-libretro", "saveSlot", menu.saveSlotIndex);
     rlconfig_set_int(menu.cfg, "raylib-libretro", "sramAutoSave", menu.sramAutoSaveIndex);
+    rlconfig_set_int(menu.cfg, "raylib-libretro", "sramMemoryMapped", menu.sramMemoryMapped ? 1 : 0);
     rlconfig_set(menu.cfg, "raylib-libretro", "username", LIBRETRO.username);
+    rlconfig_set_int(menu.cfg, "raylib-libretro", "corePoolSize", LIBRETRO.corePoolSize);
+    rlconfig_set(menu.cfg, "raylib-libretro", "corePoolWhitelist", LIBRETRO.corePoolWhitelist);
     rlconfig_set_float(menu.cfg, "raylib-libretro", "fastForwardSpeed", menu.fastForwardSpeed);
     rlconfig_set_float(menu.cfg, "raylib-libretro", "slowMotionSpeed", menu.slowMotionSpeed);
 
     // Hotkey bindings (keyboard + gamepad), keyed by name as "key<Name>"/"gamepad<Name>".
     for (int i = 0; i < LIBRETRO_HOTKEY_COUNT; i++) {
-        const char* shortName = TextReplace(menu.hotkeys[i].name, " ", "");
-        rlconfig_set_int(menu.cfg, "raylib-libretro", TextFormat("key%s", shortName), (int)menu.hotkeys[i].key);
-        rlconfig_set_int(menu.cfg, "raylib-libretro", TextFormat("gamepad%s", shortName), (int)menu.hotkeys[i].gamepad);
+        char key[64];
+        LibretroMenuHotkeyConfigKey(key, sizeof(key), "key", menu.hotkeys[i].name);
+        rlconfig_set_int(menu.cfg, "raylib-libretro", key, (int)menu.hotkeys[i].key);
+        LibretroMenuHotkeyConfigKey(key, sizeof(key), "gamepad", menu.hotkeys[i].name);
+        rlconfig_set_int(menu.cfg, "raylib-libretro", key, (int)menu.hotkeys[i].gamepad);
     }
 
     rlconfig_set(menu.cfg, "raylib-libretro", "coreDirectory", LibretroResolveAbsoluteDirectory(LIBRETRO.coreDirectory));
@@ -2314,6 +4140,7 @@ static void LibretroMenuUpdateConfig(void) {
     rlconfig_set(menu.cfg, "raylib-libretro", "systemDirectory", LibretroResolveAbsoluteDirectory(LIBRETRO.systemDirectory));
     rlconfig_set(menu.cfg, "raylib-libretro", "playlistsDirectory", LibretroResolveAbsoluteDirectory(LIBRETRO.playlistsDirectory));
     rlconfig_set(menu.cfg, "raylib-libretro", "fileBrowserStartDirectory", LibretroResolveAbsoluteDirectory(LIBRETRO.fileBrowserStartDirectory));
+    rlconfig_set(menu.cfg, "raylib-libretro", "cacheDirectory", LIBRETRO.cacheDirectory);  // empty for the platform default
 
     for (int i = 0; i <= RETRO_DEVICE_ID_JOYPAD_R3; i++) {
         rlconfig_set_int(menu.cfg, "raylib-libretro", TextFormat("keyboard%d", i), LIBRETRO.keyboardPlayer1[i]);
@@ -2323,8 +4150,9 @@ static void LibretroMenuUpdateConfig(void) {
 static bool SaveLibretroMenuSettings(void) {
     if (!menu.cfg) return false;
     LibretroMenuUpdateConfig();
+    bool dirty = rlconfig_is_dirty(menu.cfg);
     bool ok = rlconfig_save(menu.cfg, RAYLIB_LIBRETRO_CFG_FILE);
-    TraceLog(LOG_INFO, "MENU: Saved menu settings to %s", RAYLIB_LIBRETRO_CFG_FILE);
+    if (dirty) TraceLog(ok ? LOG_INFO : LOG_WARNING, "MENU: %s menu settings to %s", ok ? "Saved" : "Failed to save", RAYLIB_LIBRETRO_CFG_FILE);
     return ok;
 }
 
@@ -2332,8 +4160,9 @@ static bool SaveLibretroCoreOptions(void) {
     const char *coreName = LIBRETRO.core.libraryName;
     if (!menu.cfg || LIBRETRO.core.variableCount == 0 || !coreName || !coreName[0]) return false;
     LibretroMenuWriteCoreOptions();
+    bool dirty = rlconfig_is_dirty(menu.cfg);
     bool ok = rlconfig_save(menu.cfg, RAYLIB_LIBRETRO_CFG_FILE);
-    TraceLog(LOG_INFO, "LIBRETRO: Saved core options to %s", RAYLIB_LIBRETRO_CFG_FILE);
+    if (dirty) TraceLog(ok ? LOG_INFO : LOG_WARNING, "LIBRETRO: %s core options to %s", ok ? "Saved" : "Failed to save", RAYLIB_LIBRETRO_CFG_FILE);
     return ok;
 }
 
@@ -2343,20 +4172,20 @@ bool LoadLibretroCoreOptions(void) {
     if (!coreName || !coreName[0]) return false;
     int loaded = 0;
     for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        const char *val = rlconfig_get(menu.cfg, coreName, LIBRETRO.core.variableKeys[i]);
+        const char *val = rlconfig_get(menu.cfg, coreName, LIBRETRO.core.variables[i].key);
         if (!val) continue;
         // Reject a saved value the core no longer offers (e.g. a value renamed
         // or removed by a core update) rather than feeding the core an invalid
         // option string. The value already holds its default from registration,
         // so skipping leaves it correct. An empty values list means the core
         // declared no choices to validate against, so apply the saved value as-is.
-        const char *valuesList = LIBRETRO.core.variableValuesList[i];
+        const char *valuesList = LIBRETRO.core.variables[i].valuesList;
         if (valuesList && valuesList[0] && !LibretroMenuValueInList(valuesList, val)) {
             TraceLog(LOG_WARNING, "LIBRETRO: Ignoring saved value '%s' for '%s'; not offered by core, using default '%s'",
-                val, LIBRETRO.core.variableKeys[i], LIBRETRO.core.variableDefaults[i]);
+                val, LIBRETRO.core.variables[i].key, LIBRETRO.core.variables[i].defaultValue);
             continue;
         }
-        if (SetLibretroCoreOption(LIBRETRO.core.variableKeys[i], val)) loaded++;
+        if (SetLibretroCoreOption(LIBRETRO.core.variables[i].key, val)) loaded++;
     }
     TraceLog(LOG_INFO, "LIBRETRO: Loaded %d core option(s) from %s", loaded, RAYLIB_LIBRETRO_CFG_FILE);
     return loaded > 0;
@@ -2375,6 +4204,17 @@ static bool SaveLibretroPortDevices(void) {
 
     char section[256];
     TextCopy(section, TextFormat("%s.controllers", coreName));
+
+    // Leave the section, and the config's dirty flag, alone when nothing changed.
+    int ports = 0;
+    bool unchanged = true;
+    for (unsigned port = 0; port < count && port < 16; port++) {
+        if (info[port].num_types <= 1) continue;
+        ports++;
+        unchanged = unchanged && rlconfig_get_int(menu.cfg, section, TextFormat("port%u", port), -1) == (int)GetLibretroPortDevice(port);
+    }
+    if (unchanged && rlconfig_section_size(menu.cfg, section) == ports) return true;
+
     rlconfig_clear_section(menu.cfg, section);
     for (unsigned port = 0; port < count && port < 16; port++) {
         if (info[port].num_types <= 1) continue;
@@ -2419,8 +4259,10 @@ bool SaveLibretroAllSettings(void) {
     LibretroMenuUpdateConfig();
     LibretroMenuWriteCoreOptions();
     SaveLibretroPortDevices();
+    // Only touches the disk when a setting actually changed since the last save.
+    bool dirty = rlconfig_is_dirty(menu.cfg);
     bool ok = rlconfig_save(menu.cfg, RAYLIB_LIBRETRO_CFG_FILE);
-    TraceLog(LOG_INFO, "MENU: Saved all settings to %s", RAYLIB_LIBRETRO_CFG_FILE);
+    if (dirty) TraceLog(ok ? LOG_INFO : LOG_WARNING, "MENU: %s all settings to %s", ok ? "Saved" : "Failed to save", RAYLIB_LIBRETRO_CFG_FILE);
     MenuSaveGameSRAM();
     LibretroFlushPersistentStorage();
     return ok;
@@ -2519,16 +4361,23 @@ static bool LoadLibretroMenuSettings(void) {
     // Save Slot
     menu.saveSlotIndex = rlconfig_get_int(menu.cfg, "raylib-libretro", "saveSlot", 0);
     menu.sramAutoSaveIndex = rlconfig_get_int(menu.cfg, "raylib-libretro", "sramAutoSave", menu.sramAutoSaveIndex);
+    menu.sramMemoryMapped = (nk_bool)(rlconfig_get_int(menu.cfg, "raylib-libretro", "sramMemoryMapped", 0) > 0);
     if (menu.saveSlotIndex < 0 || menu.saveSlotIndex > 9) menu.saveSlotIndex = 0;
 
     // Username
     LibretroMenuLoadString("username", LIBRETRO.username);
 
+    // Core pool: closed cores kept loaded for quick switching (off by default).
+    SetLibretroCorePool(rlconfig_get_int(menu.cfg, "raylib-libretro", "corePoolSize", 0),
+        rlconfig_get(menu.cfg, "raylib-libretro", "corePoolWhitelist"));
+
     // Hotkey bindings (keyboard + gamepad), keyed by name as "key<Name>"/"gamepad<Name>".
     for (int i = 0; i < LIBRETRO_HOTKEY_COUNT; i++) {
-        const char* shortName = TextReplace(menu.hotkeys[i].name, " ", "");
-        menu.hotkeys[i].key = (nk_rune)rlconfig_get_int(menu.cfg, "raylib-libretro", TextFormat("key%s", shortName), (int)menu.hotkeys[i].key);
-        menu.hotkeys[i].gamepad = (enum nk_gamepad_button)rlconfig_get_int(menu.cfg, "raylib-libretro", TextFormat("gamepad%s", shortName), (int)menu.hotkeys[i].gamepad);
+        char key[64];
+        LibretroMenuHotkeyConfigKey(key, sizeof(key), "key", menu.hotkeys[i].name);
+        menu.hotkeys[i].key = (nk_rune)rlconfig_get_int(menu.cfg, "raylib-libretro", key, (int)menu.hotkeys[i].key);
+        LibretroMenuHotkeyConfigKey(key, sizeof(key), "gamepad", menu.hotkeys[i].name);
+        menu.hotkeys[i].gamepad = (enum nk_gamepad_button)rlconfig_get_int(menu.cfg, "raylib-libretro", key, (int)menu.hotkeys[i].gamepad);
     }
     SetExitKey(LibretroHotkeyToKeyboardKey(menu.hotkeys[LIBRETRO_HOTKEY_QUIT].key));
 
@@ -2551,6 +4400,7 @@ static bool LoadLibretroMenuSettings(void) {
     LibretroMenuLoadString("systemDirectory", LIBRETRO.systemDirectory);
     LibretroMenuLoadString("playlistsDirectory", LIBRETRO.playlistsDirectory);
     LibretroMenuLoadString("fileBrowserStartDirectory", LIBRETRO.fileBrowserStartDirectory);
+    LibretroMenuLoadString("cacheDirectory", LIBRETRO.cacheDirectory);
 
     // Keyboard Controls
     for (int i = 0; i <= RETRO_DEVICE_ID_JOYPAD_R3; i++) {
@@ -2572,6 +4422,7 @@ void CloseLibretroMenu(void) {
     if (menu.console != NULL) {
         nk_console_free(menu.console);
         menu.console = NULL;
+        menu.availableCoresTree = NULL;
     }
     if (menu.ctx != NULL) {
         UnloadNuklear(menu.ctx);
@@ -2583,7 +4434,17 @@ void CloseLibretroMenu(void) {
         menu.font.recs = NULL;
     }
 
+    MenuCancelCoreScan();
     FreeLibretroCoreInfos();
+    MenuCloseSRAMMap();
+    MenuCloseImageWriter();
+    UnloadLibretroStateRing(&menu.undoHistory);
+
+    MemFree(menu.optionSelectedIndices);
+    MemFree(menu.optionCheckboxValues);
+    menu.optionSelectedIndices = NULL;
+    menu.optionCheckboxValues = NULL;
+    menu.optionStateCapacity = 0;
 
     rlconfig_free(menu.cfg);
     menu.cfg = NULL;
@@ -2608,7 +4469,7 @@ static void UpdateLibretroMenuVisibility(void) {
     if (menu.optionsMenu && IsLibretroReady()) {
         int visibleOptions = 0;
         for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-            if (TextLength(LIBRETRO.core.variableValuesList[i]) > 0 && LIBRETRO.core.variableVisible[i]) {
+            if (TextLength(LIBRETRO.core.variables[i].valuesList) > 0 && LIBRETRO.core.variables[i].visible) {
                 visibleOptions++;
                 break;
             }
@@ -2638,16 +4499,55 @@ static nk_bool LibretroHotkeyGPPressed(enum nk_gamepad_button btn) {
     return btn != NK_GAMEPAD_BUTTON_INVALID && nk_gamepad_is_button_pressed(&menu.gamepads, -1, btn);
 }
 
+// Drive a background game load started by MenuDoLoadGame(). The menu key
+// cancels it; the menu then opens as it normally would.
+static void MenuPollGameLoad(void) {
+    if (menu.loadingGamePath[0] == '\0') {
+        return;
+    }
+
+    if (IsLibretroGameLoading() &&
+            ((!menu.disableHotKeysActive && IsKeyReleased(LibretroHotkeyToKeyboardKey(menu.hotkeys[LIBRETRO_HOTKEY_MENU].key))) ||
+            LibretroHotkeyGPReleased(menu.hotkeys[LIBRETRO_HOTKEY_MENU].gamepad) ||
+            IsGamepadButtonReleased(0, GAMEPAD_BUTTON_MIDDLE))) {
+        CancelLoadLibretroGame();
+    }
+
+    switch (UpdateLoadLibretroGame()) {
+        case LIBRETRO_GAME_LOAD_READING:
+        case LIBRETRO_GAME_LOAD_IDLE:
+            return;
+        case LIBRETRO_GAME_LOAD_DONE:
+            MenuTimelineMark("retro_load_game");
+            MenuFinishLoadGame(menu.loadingGamePath);
+            break;
+        case LIBRETRO_GAME_LOAD_FAILED:
+            if (MenuLoadGameFailed()) MenuFinishLoadGame(menu.loadingGamePath); else ShowLibretroMenu();
+            break;
+        case LIBRETRO_GAME_LOAD_CANCELLED:
+            SetLibretroMessage("Loading cancelled", 2.0);
+            menuTimeline.start = 0;
+            ShowLibretroMenu();
+            break;
+    }
+    menu.loadingGamePath[0] = '\0';
+}
+
 void UpdateLibretroMenu(void) { // If there is no menu, skip.
     if (menu.ctx == NULL) {
         return;
     }
 
     MenuTickSRAMAutoSave();
+    MenuPollImageWriter();
+    MenuPollCoreScan();
+    MenuTimelineTickFirstFrame();
 
     // Update the gamepad state, so that menu inputs can still be found.
     nk_gamepad_update(nk_console_get_gamepads(menu.console));
 
+    MenuPollGameLoad();
+
     // Menu Guide Button
     if (IsGamepadButtonReleased(0, GAMEPAD_BUTTON_MIDDLE) ||
             IsGamepadButtonReleased(1, GAMEPAD_BUTTON_MIDDLE) ||
@@ -7,7 +7,8 @@
 *   Wraps LoadLibretroGame so that .zip archives are mounted at /game and the
 *   ROM inside is handed to the core (data or path, per RETRO_ENVIRONMENT_SET_
 *   CONTENT_INFO_OVERRIDE). Frontends opt in by including this header; the core
-*   raylib-libretro.h stays free of PhysFS.
+*   raylib-libretro.h stays free of PhysFS. The mount is process-wide, so only
+*   the default instance loads through it; other instances get LoadLibretroGame().
 *
 *   USAGE:
 *       In exactly one source file, before include:
@@ -38,6 +39,27 @@ extern "C" {
 static bool InitLibretroPhysFS(void);                       // Start PhysFS. Safe to call repeatedly.
 static void CloseLibretroPhysFS(void);                      // Tear down PhysFS and any active /game mount.
 static bool LoadLibretroGameFromPhysFS(const char* gameFile);   // Zip-aware replacement for LoadLibretroGame.
+static void SetLibretroExtractCacheSize(uint64_t maxBytes);  // Cap the archive extraction cache; 0 disables it.
+static void WarmLibretroZipIndex(const char* directory);    // Index every .zip in a directory in the background.
+
+/**
+ * Stages of an asynchronous game load, see BeginLoadLibretroGameFromPhysFS().
+ */
+typedef enum LibretroGameLoadState {
+    LIBRETRO_GAME_LOAD_IDLE = 0,    // nothing in flight
+    LIBRETRO_GAME_LOAD_READING,     // content is being read and inflated on a worker
+    LIBRETRO_GAME_LOAD_DONE,        // the core has the content
+    LIBRETRO_GAME_LOAD_FAILED,
+    LIBRETRO_GAME_LOAD_CANCELLED
+} LibretroGameLoadState;
+
+static bool BeginLoadLibretroGameFromPhysFS(const char* gameFile);   // Start loading; finish with UpdateLoadLibretroGame().
+static bool PrefetchLibretroGameFromPhysFS(const char* gameFile, const char* validExtensions); // Start reading before the core is initialized.
+static LibretroGameLoadState UpdateLoadLibretroGame(void);           // Call every frame; hands the content to the core once read.
+static void CancelLoadLibretroGame(void);                           // Abandon an in-flight load.
+static bool IsLibretroGameLoading(void);                            // Whether a load is still reading content.
+static float GetLibretroGameLoadProgress(void);                     // Fraction of the content read, 0 to 1.
+static bool GetLibretroGameLoadReadTime(int64_t* startUsec, int64_t* endUsec); // When the last load's read ran.
 
 #if defined(__cplusplus)
 }
@@ -49,34 +71,838 @@ static bool LoadLibretroGameFromPhysFS(const char* gameFile);   // Zip-aware rep
 #ifndef RAYLIB_LIBRETRO_PHYSFS_IMPLEMENTATION_ONCE
 #define RAYLIB_LIBRETRO_PHYSFS_IMPLEMENTATION_ONCE
 
+#if defined(_WIN32)
+#include <sys/utime.h>  // _utime()
+#define LIBRETRO_PHYSFS_UTIME _utime
+#else
+#include <utime.h>      // utime()
+#define LIBRETRO_PHYSFS_UTIME utime
+#endif
+
+// Total size of the extraction cache, which keeps archived content that
+// full-path cores can't read through the VFS extracted across sessions. Room
+// for about one CD image. Off on the web, where it would only fill memory.
+#ifndef RAYLIB_LIBRETRO_EXTRACT_CACHE_MAX_BYTES
+#if defined(__EMSCRIPTEN__) || defined(PLATFORM_WEB)
+#define RAYLIB_LIBRETRO_EXTRACT_CACHE_MAX_BYTES 0
+#else
+#define RAYLIB_LIBRETRO_EXTRACT_CACHE_MAX_BYTES (1ULL * 1024 * 1024 * 1024)
+#endif
+#endif
+
+// Directory, under GetLibretroCacheDirectory(), that holds the extraction cache.
+#ifndef RAYLIB_LIBRETRO_EXTRACT_CACHE_DIR
+#define RAYLIB_LIBRETRO_EXTRACT_CACHE_DIR "extract"
+#endif
+
+// Directory, under GetLibretroCacheDirectory(), that holds the zip index cache.
+#ifndef RAYLIB_LIBRETRO_ZIP_INDEX_DIR
+#define RAYLIB_LIBRETRO_ZIP_INDEX_DIR "zipindex"
+#endif
+
+#ifdef HAVE_THREADS
+#include <rthreads/rthreads.h>
+#endif
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
 
+/**
+ * The file list of one zip archive, as read from its central directory.
+ */
+typedef struct LibretroZipIndex {
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];  // the archive
+    long modTime;               // archive modification time the index was built from
+    int64_t fileSize;           // archive size the index was built from
+    unsigned int count;         // number of file entries (directories are skipped)
+    char* names;                // NUL-terminated entry names, back to back
+    unsigned int* nameOffsets;  // start of each entry's name in names
+    uint64_t* sizes;            // uncompressed size of each entry
+    uint32_t* crc32s;           // CRC32 of each entry
+} LibretroZipIndex;
+
 typedef struct rLibretroPhysFS {
     bool ready;
+    bool mountIsArchive;          // mountSource is a .zip rather than a directory
     char mountSource[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    uint64_t extractCacheMaxBytes;
+    LibretroZipIndex zipIndex;    // most recently used zip index
+#ifdef HAVE_THREADS
+    sthread_t* warmThread;        // WarmLibretroZipIndex() worker, or NULL
+    slock_t* warmLock;            // guards warmQuit and warmDone while the worker exists
+    bool warmQuit;
+    bool warmDone;
+#endif
 } rLibretroPhysFS;
 
-static rLibretroPhysFS LibretroPhysFS = {0};
+static rLibretroPhysFS LibretroPhysFS = { .extractCacheMaxBytes = RAYLIB_LIBRETRO_EXTRACT_CACHE_MAX_BYTES };
+
+/**
+ * One file in a zip's central directory. name is not NUL-terminated.
+ */
+typedef struct LibretroZipEntry {
+    const char* name;
+    unsigned int nameLength;
+    uint32_t crc32;
+    uint64_t size;          // uncompressed size
+} LibretroZipEntry;
+
+static uint16_t LibretroZipU16(const unsigned char* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t LibretroZipU32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t LibretroZipU64(const unsigned char* p) {
+    return (uint64_t)LibretroZipU32(p) | ((uint64_t)LibretroZipU32(p + 4) << 32);
+}
+
+static bool LibretroZipReadAt(FILE* file, int64_t offset, void* buffer, size_t size) {
+    return RAYLIB_LIBRETRO_VFS_FSEEK(file, offset, SEEK_SET) == 0 && fread(buffer, 1, size, file) == size;
+}
+
+/**
+ * Find where a zip's central directory lives. Handles zip64 archives.
+ *
+ * @return true if @p offset and @p size were found and lie inside the file.
+ */
+static bool LibretroZipLocateCentralDirectory(FILE* file, int64_t fileSize, uint64_t* offset, uint64_t* size) {
+    // The end of central directory record is 22 bytes plus a comment of up to
+    // 64 KB, so search backwards through the tail for its signature.
+    int64_t tailSize = (fileSize < 22 + 65535) ? fileSize : 22 + 65535;
+    unsigned char* tail = (unsigned char*)MemAlloc((unsigned int)tailSize);
+    if (tail == NULL) return false;
+    if (!LibretroZipReadAt(file, fileSize - tailSize, tail, (size_t)tailSize)) {
+        MemFree(tail);
+        return false;
+    }
+
+    int64_t eocd = -1;
+    for (int64_t i = tailSize - 22; i >= 0; i--) {
+        if (LibretroZipU32(tail + i) == 0x06054b50) {
+            eocd = i;
+            break;
+        }
+    }
+    if (eocd < 0) {
+        MemFree(tail);
+        return false;
+    }
+
+    *size = LibretroZipU32(tail + eocd + 12);
+    *offset = LibretroZipU32(tail + eocd + 16);
+    bool zip64 = *size == 0xFFFFFFFF || *offset == 0xFFFFFFFF || LibretroZipU16(tail + eocd + 10) == 0xFFFF;
+    MemFree(tail);
+
+    if (zip64) {
+        // A locator just before the record points at the zip64 record.
+        int64_t eocdOffset = fileSize - tailSize + eocd;
+        unsigned char locator[20];
+        unsigned char record[56];
+        if (eocdOffset < 20 || !LibretroZipReadAt(file, eocdOffset - 20, locator, sizeof(locator)) ||
+                LibretroZipU32(locator) != 0x07064b50 ||
+                !LibretroZipReadAt(file, (int64_t)LibretroZipU64(locator + 8), record, sizeof(record)) ||
+                LibretroZipU32(record) != 0x06064b50) {
+            return false;
+        }
+        *size = LibretroZipU64(record + 40);
+        *offset = LibretroZipU64(record + 48);
+    }
+
+    return *size > 0 && *size <= UINT_MAX && *offset + *size <= (uint64_t)fileSize;
+}
+
+/**
+ * Read a zip's central directory straight from the file, without PhysFS.
+ *
+ * @param zipPath The archive to read.
+ * @param size Receives the byte size of the returned directory.
+ * @return A MemAlloc'd copy of the central directory, to walk with
+ * LibretroZipNextEntry() and free with MemFree(), or NULL on failure.
+ */
+static unsigned char* LibretroZipLoadCentralDirectory(const char* zipPath, uint64_t* size) {
+    int64_t fileSize = raylib_libretro_vfs_file_size_64(zipPath);
+    if (fileSize < 22) return NULL;
+    FILE* file = raylib_libretro_vfs_fopen(zipPath, "rb");
+    if (file == NULL) return NULL;
+
+    unsigned char* directory = NULL;
+    uint64_t directoryOffset = 0;
+    uint64_t directorySize = 0;
+    if (LibretroZipLocateCentralDirectory(file, fileSize, &directoryOffset, &directorySize)) {
+        directory = (unsigned char*)MemAlloc((unsigned int)directorySize);
+        if (directory != NULL && !LibretroZipReadAt(file, (int64_t)directoryOffset, directory, (size_t)directorySize)) {
+            MemFree(directory);
+            directory = NULL;
+        }
+    }
+    fclose(file);
+
+    if (directory != NULL) *size = directorySize;
+    return directory;
+}
+
+/**
+ * Walk the entries of a central directory from LibretroZipLoadCentralDirectory().
+ *
+ * @param offset Cursor into @p directory; start it at 0.
+ * @return false once there are no more entries.
+ */
+static bool LibretroZipNextEntry(const unsigned char* directory, uint64_t directorySize, uint64_t* offset, LibretroZipEntry* entry) {
+    if (*offset + 46 > directorySize) return false;
+    const unsigned char* header = directory + *offset;
+    if (LibretroZipU32(header) != 0x02014b50) return false;
+
+    unsigned int nameLength = LibretroZipU16(header + 28);
+    unsigned int extraLength = LibretroZipU16(header + 30);
+    unsigned int commentLength = LibretroZipU16(header + 32);
+    uint64_t next = *offset + 46 + nameLength + extraLength + commentLength;
+    if (next > directorySize) return false;
+
+    entry->name = (const char*)(header + 46);
+    entry->nameLength = nameLength;
+    entry->crc32 = LibretroZipU32(header + 16);
+    entry->size = LibretroZipU32(header + 24);
+
+    // Zip64 sizes live in extra field 0x0001, uncompressed size first.
+    if (entry->size == 0xFFFFFFFF) {
+        const unsigned char* extra = header + 46 + nameLength;
+        const unsigned char* extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd) {
+            unsigned int id = LibretroZipU16(extra);
+            unsigned int length = LibretroZipU16(extra + 2);
+            if (id == 0x0001 && length >= 8 && extra + 4 + 8 <= extraEnd) {
+                entry->size = LibretroZipU64(extra + 4);
+                break;
+            }
+            extra += 4 + length;
+        }
+    }
+
+    *offset = next;
+    return true;
+}
+
+static void UnloadLibretroZipIndex(LibretroZipIndex* index) {
+    if (index->names != NULL) MemFree(index->names);
+    if (index->nameOffsets != NULL) MemFree(index->nameOffsets);
+    if (index->sizes != NULL) MemFree(index->sizes);
+    if (index->crc32s != NULL) MemFree(index->crc32s);
+    memset(index, 0, sizeof(LibretroZipIndex));
+}
+
+static bool LibretroZipIndexAlloc(LibretroZipIndex* index, unsigned int count, size_t namesSize) {
+    index->count = count;
+    index->names = (char*)MemAlloc((unsigned int)(namesSize + 1));
+    index->nameOffsets = (unsigned int*)MemAlloc((unsigned int)(sizeof(unsigned int) * (count + 1)));
+    index->sizes = (uint64_t*)MemAlloc((unsigned int)(sizeof(uint64_t) * (count + 1)));
+    index->crc32s = (uint32_t*)MemAlloc((unsigned int)(sizeof(uint32_t) * (count + 1)));
+    return index->names != NULL && index->nameOffsets != NULL && index->sizes != NULL && index->crc32s != NULL;
+}
+
+/**
+ * Build a zip index from the archive's central directory.
+ *
+ * Thread-safe: only touches the archive and @p index.
+ */
+static bool LibretroZipIndexBuild(const char* zipPath, long modTime, int64_t fileSize, LibretroZipIndex* index) {
+    uint64_t directorySize = 0;
+    unsigned char* directory = LibretroZipLoadCentralDirectory(zipPath, &directorySize);
+    if (directory == NULL) return false;
+
+    // First pass sizes the arrays, second fills them.
+    unsigned int count = 0;
+    size_t namesSize = 0;
+    uint64_t offset = 0;
+    LibretroZipEntry entry;
+    while (LibretroZipNextEntry(directory, directorySize, &offset, &entry)) {
+        if (entry.nameLength == 0 || entry.name[entry.nameLength - 1] == '/') continue;
+        count++;
+        namesSize += entry.nameLength + 1;
+    }
+
+    memset(index, 0, sizeof(LibretroZipIndex));
+    bool ok = LibretroZipIndexAlloc(index, count, namesSize);
+    unsigned int i = 0;
+    size_t namesUsed = 0;
+    offset = 0;
+    while (ok && LibretroZipNextEntry(directory, directorySize, &offset, &entry)) {
+        if (entry.nameLength == 0 || entry.name[entry.nameLength - 1] == '/') continue;
+        index->nameOffsets[i] = (unsigned int)namesUsed;
+        memcpy(index->names + namesUsed, entry.name, entry.nameLength);
+        index->names[namesUsed + entry.nameLength] = '\0';
+        namesUsed += entry.nameLength + 1;
+        index->sizes[i] = entry.size;
+        index->crc32s[i] = entry.crc32;
+        i++;
+    }
+    MemFree(directory);
+
+    if (!ok) {
+        UnloadLibretroZipIndex(index);
+        return false;
+    }
+    snprintf(index->path, sizeof(index->path), "%s", zipPath);
+    index->modTime = modTime;
+    index->fileSize = fileSize;
+    return true;
+}
+
+/**
+ * Path of the on-disk index for @p zipPath inside @p indexDir.
+ * Uses snprintf() rather than TextFormat() so the warm worker can call it.
+ */
+static void LibretroZipIndexFilePath(const char* indexDir, const char* zipPath, char* outPath, size_t outSize) {
+    uint64_t hash = GetLibretroDataHash(zipPath, strlen(zipPath));
+    snprintf(outPath, outSize, "%s/%016llx.zidx", indexDir, (unsigned long long)hash);
+}
+
+// On-disk index layout, little-endian as written by this machine:
+//   "RLZI" | u32 version | i64 modTime | i64 fileSize | u32 pathLength | path
+//   | u32 count | u32 namesSize | names | count x (u64 size, u32 crc32, u32 nameOffset)
+#define LIBRETRO_ZIP_INDEX_MAGIC 0x495a4c52  // "RLZI"
+#define LIBRETRO_ZIP_INDEX_VERSION 1
+
+/**
+ * Write an index to disk. Goes through a temp file and a rename, so a reader
+ * never sees a half-written index.
+ *
+ * Thread-safe when each thread passes its own @p tempSuffix.
+ */
+static bool LibretroZipIndexSave(const char* indexPath, const LibretroZipIndex* index, const char* tempSuffix) {
+    uint32_t pathLength = (uint32_t)strlen(index->path);
+    uint32_t namesSize = (index->count > 0) ? index->nameOffsets[index->count - 1] + (uint32_t)strlen(index->names + index->nameOffsets[index->count - 1]) + 1 : 0;
+    size_t size = 4 + 4 + 8 + 8 + 4 + pathLength + 4 + 4 + namesSize + (size_t)index->count * (8 + 4 + 4);
+    if (size > INT_MAX) return false;
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)size);
+    if (data == NULL) return false;
+
+    unsigned char* p = data;
+    uint32_t magic = LIBRETRO_ZIP_INDEX_MAGIC, version = LIBRETRO_ZIP_INDEX_VERSION;
+    int64_t modTime = (int64_t)index->modTime;
+    memcpy(p, &magic, 4); p += 4;
+    memcpy(p, &version, 4); p += 4;
+    memcpy(p, &modTime, 8); p += 8;
+    memcpy(p, &index->fileSize, 8); p += 8;
+    memcpy(p, &pathLength, 4); p += 4;
+    memcpy(p, index->path, pathLength); p += pathLength;
+    memcpy(p, &index->count, 4); p += 4;
+    memcpy(p, &namesSize, 4); p += 4;
+    memcpy(p, index->names, namesSize); p += namesSize;
+    for (unsigned int i = 0; i < index->count; i++) {
+        memcpy(p, &index->sizes[i], 8); p += 8;
+        memcpy(p, &index->crc32s[i], 4); p += 4;
+        memcpy(p, &index->nameOffsets[i], 4); p += 4;
+    }
+
+    char tempPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    snprintf(tempPath, sizeof(tempPath), "%s.%s", indexPath, tempSuffix);
+    bool ok = SaveFileData(tempPath, data, (int)size);
+    MemFree(data);
+    if (ok) {
+        ok = raylib_libretro_vfs_replace_file(tempPath, indexPath);
+    }
+    if (!ok) remove(tempPath);
+    return ok;
+}
+
+/**
+ * Read an index from disk, if it exists and still matches the archive's
+ * path, modification time and size.
+ *
+ * Thread-safe: only touches the index file and @p index.
+ */
+static bool LibretroZipIndexLoad(const char* indexPath, const char* zipPath, long modTime, int64_t fileSize, LibretroZipIndex* index) {
+    if (!FileExists(indexPath)) return false;
+    int size = 0;
+    unsigned char* data = LoadFileData(indexPath, &size);
+    if (data == NULL) return false;
+
+    const unsigned char* p = data;
+    const unsigned char* end = data + size;
+    uint32_t magic = 0, version = 0, pathLength = 0, count = 0, namesSize = 0;
+    int64_t storedModTime = 0, storedSize = 0;
+    bool ok = size >= 32;
+    if (ok) {
+        memcpy(&magic, p, 4); p += 4;
+        memcpy(&version, p, 4); p += 4;
+        memcpy(&storedModTime, p, 8); p += 8;
+        memcpy(&storedSize, p, 8); p += 8;
+        memcpy(&pathLength, p, 4); p += 4;
+        ok = magic == LIBRETRO_ZIP_INDEX_MAGIC && version == LIBRETRO_ZIP_INDEX_VERSION &&
+            storedModTime == (int64_t)modTime && storedSize == fileSize &&
+            pathLength == strlen(zipPath) && (size_t)(end - p) >= (size_t)pathLength + 8 &&
+            memcmp(p, zipPath, pathLength) == 0;
+    }
+    if (ok) {
+        p += pathLength;
+        memcpy(&count, p, 4); p += 4;
+        memcpy(&namesSize, p, 4); p += 4;
+        ok = (uint64_t)(end - p) == (uint64_t)namesSize + (uint64_t)count * 16;
+    }
+
+    memset(index, 0, sizeof(LibretroZipIndex));
+    if (ok) ok = LibretroZipIndexAlloc(index, count, namesSize);
+    if (ok) {
+        memcpy(index->names, p, namesSize); p += namesSize;
+        index->names[namesSize] = '\0';
+        for (unsigned int i = 0; ok && i < count; i++) {
+            memcpy(&index->sizes[i], p, 8); p += 8;
+            memcpy(&index->crc32s[i], p, 4); p += 4;
+            memcpy(&index->nameOffsets[i], p, 4); p += 4;
+            ok = index->nameOffsets[i] < namesSize;
+        }
+    }
+    UnloadFileData(data);
+
+    if (!ok) {
+        UnloadLibretroZipIndex(index);
+        return false;
+    }
+    snprintf(index->path, sizeof(index->path), "%s", zipPath);
+    index->modTime = modTime;
+    index->fileSize = fileSize;
+    return true;
+}
+
+/**
+ * Get the file list of a zip, from memory, the on-disk index cache, or the
+ * archive's central directory, in that order. Main thread only.
+ *
+ * @return The index, valid until the next call, or NULL if @p zipPath can't
+ * be read as a zip.
+ */
+static const LibretroZipIndex* GetLibretroZipIndex(const char* zipPath) {
+    long modTime = GetFileModTime(zipPath);
+    int64_t fileSize = raylib_libretro_vfs_file_size_64(zipPath);
+    if (fileSize < 0) return NULL;
+
+    LibretroZipIndex* index = &LibretroPhysFS.zipIndex;
+    if (index->names != NULL && index->modTime == modTime && index->fileSize == fileSize && TextIsEqual(index->path, zipPath)) {
+        return index;
+    }
+    UnloadLibretroZipIndex(index);
+
+    // Without a cache directory the index is only kept in memory.
+    const char* cacheDir = GetLibretroCacheDirectory();
+    char indexDir[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char indexPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    if (cacheDir != NULL) {
+        TextCopy(indexDir, TextFormat("%s/%s", cacheDir, RAYLIB_LIBRETRO_ZIP_INDEX_DIR));
+        LibretroZipIndexFilePath(indexDir, zipPath, indexPath, sizeof(indexPath));
+        if (LibretroZipIndexLoad(indexPath, zipPath, modTime, fileSize, index)) {
+            return index;
+        }
+    }
+
+    if (!LibretroZipIndexBuild(zipPath, modTime, fileSize, index)) {
+        return NULL;
+    }
+    if (cacheDir != NULL && (DirectoryExists(indexDir) || MakeDirectory(indexDir) == 0)) {
+        LibretroZipIndexSave(indexPath, index, "tmp");
+    }
+    return index;
+}
+
+/**
+ * List the files in a zip as virtual paths under @p prefix (e.g. "/game"),
+ * read from the zip index rather than by mounting and walking the archive.
+ *
+ * @return A list to free with UnloadDirectoryFiles(); empty if the archive
+ * couldn't be indexed.
+ */
+static FilePathList LoadLibretroZipEntryPaths(const char* zipPath, const char* prefix) {
+    FilePathList list = {0};
+    const LibretroZipIndex* index = GetLibretroZipIndex(zipPath);
+    if (index == NULL || index->count == 0) return list;
+
+    list.paths = (char**)MemAlloc((unsigned int)(sizeof(char*) * index->count));
+    if (list.paths == NULL) return list;
+    size_t prefixLength = strlen(prefix);
+    for (unsigned int i = 0; i < index->count; i++) {
+        const char* name = index->names + index->nameOffsets[i];
+        size_t length = prefixLength + 1 + strlen(name) + 1;
+        list.paths[list.count] = (char*)MemAlloc((unsigned int)length);
+        if (list.paths[list.count] == NULL) break;
+        snprintf(list.paths[list.count], length, "%s/%s", prefix, name);
+        list.count++;
+    }
+    // UnloadDirectoryFiles() frees up to capacity.
+    list.capacity = list.count;
+    return list;
+}
+
+/**
+ * Look up one entry of a zip by its name inside the archive.
+ *
+ * @return true if found, filling @p crc32 and @p size.
+ */
+static bool LibretroZipFindEntry(const char* zipPath, const char* entryName, uint32_t* crc32, uint64_t* size) {
+    const LibretroZipIndex* index = GetLibretroZipIndex(zipPath);
+    if (index == NULL) return false;
+    for (unsigned int i = 0; i < index->count; i++) {
+        if (TextIsEqual(index->names + index->nameOffsets[i], entryName)) {
+            *crc32 = index->crc32s[i];
+            *size = index->sizes[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef HAVE_THREADS
+typedef struct LibretroZipIndexWarmJob {
+    FilePathList archives;
+    char indexDir[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+} LibretroZipIndexWarmJob;
+
+/**
+ * Worker for WarmLibretroZipIndex(): index each archive that doesn't already
+ * have an up to date index on disk. Avoids raylib helpers with shared static
+ * buffers (TextFormat(), IsFileExtension()), which the main thread is using.
+ */
+static void LibretroZipIndexWarmThread(void* userData) {
+    LibretroZipIndexWarmJob* job = (LibretroZipIndexWarmJob*)userData;
+    unsigned int built = 0;
+    for (unsigned int i = 0; i < job->archives.count; i++) {
+        slock_lock(LibretroPhysFS.warmLock);
+        bool quit = LibretroPhysFS.warmQuit;
+        slock_unlock(LibretroPhysFS.warmLock);
+        if (quit) break;
+
+        const char* zipPath = job->archives.paths[i];
+        long modTime = GetFileModTime(zipPath);
+        int64_t fileSize = raylib_libretro_vfs_file_size_64(zipPath);
+        if (fileSize < 0) continue;
+
+        char indexPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+        LibretroZipIndexFilePath(job->indexDir, zipPath, indexPath, sizeof(indexPath));
+        LibretroZipIndex index;
+        if (LibretroZipIndexLoad(indexPath, zipPath, modTime, fileSize, &index)) {
+            UnloadLibretroZipIndex(&index);
+            continue;
+        }
+        if (LibretroZipIndexBuild(zipPath, modTime, fileSize, &index)) {
+            LibretroZipIndexSave(indexPath, &index, "warm");
+            UnloadLibretroZipIndex(&index);
+            built++;
+        }
+    }
+    TraceLog(LOG_DEBUG, "LIBRETRO: Indexed %u of %u archives", built, job->archives.count);
+    UnloadDirectoryFiles(job->archives);
+    MemFree(job);
+    slock_lock(LibretroPhysFS.warmLock);
+    LibretroPhysFS.warmDone = true;
+    slock_unlock(LibretroPhysFS.warmLock);
+}
+
+/**
+ * Stop the warm worker, waiting for the archive it's on to finish.
+ */
+static void LibretroZipIndexStopWarm(void) {
+    if (LibretroPhysFS.warmThread == NULL) return;
+    slock_lock(LibretroPhysFS.warmLock);
+    LibretroPhysFS.warmQuit = true;
+    slock_unlock(LibretroPhysFS.warmLock);
+    sthread_join(LibretroPhysFS.warmThread);
+    LibretroPhysFS.warmThread = NULL;
+    slock_free(LibretroPhysFS.warmLock);
+    LibretroPhysFS.warmLock = NULL;
+    LibretroPhysFS.warmQuit = false;
+}
+#else
+#define LibretroZipIndexStopWarm() ((void)0)
+#endif
+
+/**
+ * Build the zip index of every .zip in @p directory on a background thread,
+ * so browsing and loading them later skips parsing their central directories.
+ * Archives whose index is already up to date are skipped. Does nothing
+ * without thread support, or while a previous warm-up is still running.
+ *
+ * @param directory Directory to scan (not recursively).
+ */
+static void WarmLibretroZipIndex(const char* directory) {
+#ifdef HAVE_THREADS
+    if (directory == NULL || directory[0] == '\0' || !DirectoryExists(directory)) return;
+    if (LibretroPhysFS.warmThread != NULL) {
+        slock_lock(LibretroPhysFS.warmLock);
+        bool done = LibretroPhysFS.warmDone;
+        slock_unlock(LibretroPhysFS.warmLock);
+        if (!done) return;
+        LibretroZipIndexStopWarm();
+    }
+
+    const char* cacheDir = GetLibretroCacheDirectory();
+    if (cacheDir == NULL) return;
+    LibretroZipIndexWarmJob* job = (LibretroZipIndexWarmJob*)MemAlloc(sizeof(LibretroZipIndexWarmJob));
+    if (job == NULL) return;
+    TextCopy(job->indexDir, TextFormat("%s/%s", cacheDir, RAYLIB_LIBRETRO_ZIP_INDEX_DIR));
+    if (!DirectoryExists(job->indexDir) && MakeDirectory(job->indexDir) != 0) {
+        MemFree(job);
+        return;
+    }
+    // List on this thread: the directory scan's extension filter isn't thread-safe.
+    job->archives = LoadDirectoryFilesEx(directory, ".zip", false);
+    if (job->archives.count == 0) {
+        UnloadDirectoryFiles(job->archives);
+        MemFree(job);
+        return;
+    }
+
+    LibretroPhysFS.warmDone = false;
+    LibretroPhysFS.warmLock = slock_new();
+    if (LibretroPhysFS.warmLock != NULL) {
+        LibretroPhysFS.warmThread = sthread_create(LibretroZipIndexWarmThread, job);
+    }
+    if (LibretroPhysFS.warmThread == NULL) {
+        if (LibretroPhysFS.warmLock != NULL) slock_free(LibretroPhysFS.warmLock);
+        LibretroPhysFS.warmLock = NULL;
+        UnloadDirectoryFiles(job->archives);
+        MemFree(job);
+    }
+#else
+    (void)directory;
+#endif
+}
 
 /**
  * PhysFS-backed VFS hook: load file data from the PhysFS search path.
  * Returns NULL silently when the file is not found in any mount.
  */
-static unsigned char* LibretroPhysFSVfsLoadFileData(const char* fileName, int* bytesRead) {
+static unsigned char* LibretroPhysFSVfsLoadFileData(const char* fileName, int64_t* bytesRead) {
+    *bytesRead = 0;
     if (!IsPhysFSReady() || !FileExistsInPhysFS(fileName)) {
-        *bytesRead = 0;
         return NULL;
     }
-    return LoadFileDataFromPhysFS(fileName, bytesRead);
+    PHYSFS_File* file = PHYSFS_openRead(fileName);
+    if (file == NULL) {
+        return NULL;
+    }
+
+    // LoadFileDataFromPhysFS() reports an int size; read directly to keep the
+    // full 64-bit length, up to what MemAlloc() can hold.
+    PHYSFS_sint64 length = PHYSFS_fileLength(file);
+    unsigned char* data = NULL;
+    if (length > 0 && (PHYSFS_uint64)length <= (PHYSFS_uint64)UINT_MAX) {
+        data = (unsigned char*)MemAlloc((unsigned int)length);
+        if (data != NULL && PHYSFS_readBytes(file, data, (PHYSFS_uint64)length) != length) {
+            MemFree(data);
+            data = NULL;
+        }
+    } else if (length > 0) {
+        TraceLog(LOG_WARNING, "LIBRETRO: %s is too large to load into memory", fileName);
+    }
+    PHYSFS_close(file);
+
+    if (data != NULL) {
+        *bytesRead = (int64_t)length;
+    }
+    return data;
+}
+
+/**
+ * PhysFS-backed VFS hook: open a file in the PhysFS search path for streaming.
+ *
+ * Entries are read on demand through PHYSFS_readBytes(), so a core that only
+ * reads a header never inflates the rest, and stored (uncompressed) zip
+ * entries are copied straight out of the archive. Returns NULL silently when
+ * the file is not found in any mount.
+ */
+static void* LibretroPhysFSVfsOpen(const char* path, int64_t* size) {
+    if (!IsPhysFSReady() || !FileExistsInPhysFS(path)) return NULL;
+    PHYSFS_File* file = PHYSFS_openRead(path);
+    if (file == NULL) return NULL;
+
+    PHYSFS_sint64 length = PHYSFS_fileLength(file);
+    if (length < 0) {
+        // Unknown length; let the whole-file hook handle it instead.
+        PHYSFS_close(file);
+        return NULL;
+    }
+
+    // Cores often read a few bytes at a time; let PhysFS batch those.
+    PHYSFS_setBuffer(file, 64 * 1024);
+    *size = (int64_t)length;
+    return file;
+}
+
+/**
+ * PhysFS-backed VFS hook: read from a file opened by LibretroPhysFSVfsOpen().
+ */
+static int64_t LibretroPhysFSVfsRead(void* file, void* buffer, uint64_t len) {
+    return (int64_t)PHYSFS_readBytes((PHYSFS_File*)file, buffer, (PHYSFS_uint64)len);
+}
+
+/**
+ * PhysFS-backed VFS hook: seek a file opened by LibretroPhysFSVfsOpen().
+ */
+static bool LibretroPhysFSVfsSeek(void* file, int64_t position) {
+    return PHYSFS_seek((PHYSFS_File*)file, (PHYSFS_uint64)position) != 0;
+}
+
+/**
+ * PhysFS-backed VFS hook: close a file opened by LibretroPhysFSVfsOpen().
+ */
+static void LibretroPhysFSVfsClose(void* file) {
+    PHYSFS_close((PHYSFS_File*)file);
+}
+
+/**
+ * Set the size cap of the archive extraction cache.
+ *
+ * @param maxBytes Total bytes of extracted content kept on disk. The least
+ *                 recently used entries are evicted to stay under it. 0
+ *                 disables the cache, so archived content for full-path cores
+ *                 goes back to a throwaway temp file.
+ */
+static void SetLibretroExtractCacheSize(uint64_t maxBytes) {
+    LibretroPhysFS.extractCacheMaxBytes = maxBytes;
+}
+
+typedef struct LibretroExtractCacheFile {
+    char* path;
+    long modTime;
+    int64_t size;
+} LibretroExtractCacheFile;
+
+static int LibretroExtractCacheCompare(const void* a, const void* b) {
+    long ta = ((const LibretroExtractCacheFile*)a)->modTime;
+    long tb = ((const LibretroExtractCacheFile*)b)->modTime;
+    return (ta > tb) - (ta < tb);
+}
+
+/**
+ * Evict least recently used cache entries (by modification time, which a
+ * cache hit refreshes) until @p incoming more bytes fit under the cap. Also
+ * drops ".part" files left by an interrupted extraction.
+ */
+static void LibretroExtractCacheMakeRoom(const char* cacheDir, uint64_t incoming) {
+    FilePathList files = LoadDirectoryFiles(cacheDir);
+    LibretroExtractCacheFile* entries = (LibretroExtractCacheFile*)MemAlloc((unsigned int)(sizeof(LibretroExtractCacheFile) * (files.count + 1)));
+    if (entries == NULL) {
+        UnloadDirectoryFiles(files);
+        return;
+    }
+
+    unsigned int count = 0;
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < files.count; i++) {
+        if (IsFileExtension(files.paths[i], ".part")) {
+            FileRemove(files.paths[i]);
+            continue;
+        }
+        int64_t size = raylib_libretro_vfs_file_size_64(files.paths[i]);
+        if (size < 0) continue;
+        entries[count].path = files.paths[i];
+        entries[count].modTime = GetFileModTime(files.paths[i]);
+        entries[count].size = size;
+        total += (uint64_t)size;
+        count++;
+    }
+
+    qsort(entries, count, sizeof(LibretroExtractCacheFile), LibretroExtractCacheCompare);
+    for (unsigned int i = 0; i < count && total + incoming > LibretroPhysFS.extractCacheMaxBytes; i++) {
+        if (TextIsEqual(entries[i].path, LIBRETRO.core.cachedGamePath)) continue;
+        if (FileRemove(entries[i].path) == 0) {
+            TraceLog(LOG_DEBUG, "LIBRETRO: Evicted %s from the extraction cache", entries[i].path);
+            total -= (uint64_t)entries[i].size;
+        }
+    }
+
+    MemFree(entries);
+    UnloadDirectoryFiles(files);
+}
+
+/**
+ * VFS extraction hook: materialize a file from the mounted archive in a
+ * persistent cache, so full-path cores that can't read the virtual path only
+ * pay for the extraction once.
+ *
+ * Entries are keyed by the archive path, modification time and size, plus the
+ * entry's CRC32 from the zip directory, so a changed archive never serves
+ * stale content. Extraction streams through PhysFS into a ".part" file that is
+ * renamed into place once complete.
+ */
+static bool LibretroPhysFSVfsExtract(const char* path, char* outPath) {
+    if (!IsPhysFSReady() || !LibretroPhysFS.mountIsArchive || LibretroPhysFS.extractCacheMaxBytes == 0) return false;
+    if (TextFindIndex(path, "/game/") != 0) return false;
+
+    const char* archive = LibretroPhysFS.mountSource;
+    const char* entryName = path + 6;  // strlen("/game/")
+    uint32_t crc32 = 0;
+    uint64_t entrySize = 0;
+    if (!LibretroZipFindEntry(archive, entryName, &crc32, &entrySize)) return false;
+    if (entrySize > LibretroPhysFS.extractCacheMaxBytes) {
+        TraceLog(LOG_INFO, "LIBRETRO: %s is larger than the extraction cache", path);
+        return false;
+    }
+
+    const char* key = TextFormat("%s|%ld|%lld|%08x|%s", archive, GetFileModTime(archive),
+        (long long)raylib_libretro_vfs_file_size_64(archive), (unsigned int)crc32, entryName);
+    uint64_t hash = GetLibretroDataHash(key, TextLength(key));
+
+    const char* cacheRoot = GetLibretroCacheDirectory();
+    if (cacheRoot == NULL) return false;
+    char cacheDir[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    TextCopy(cacheDir, TextFormat("%s/%s", cacheRoot, RAYLIB_LIBRETRO_EXTRACT_CACHE_DIR));
+    TextCopy(outPath, TextFormat("%s/%016llx-%s", cacheDir, (unsigned long long)hash, GetFileName(path)));
+
+    // Cache hit: touch it so eviction sees it as recently used.
+    if (raylib_libretro_vfs_file_size_64(outPath) == (int64_t)entrySize) {
+        LIBRETRO_PHYSFS_UTIME(outPath, NULL);
+        TraceLog(LOG_INFO, "LIBRETRO: Reusing extracted %s", outPath);
+        return true;
+    }
+
+    if (!DirectoryExists(cacheDir) && MakeDirectory(cacheDir) != 0) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to create extraction cache %s", cacheDir);
+        return false;
+    }
+    LibretroExtractCacheMakeRoom(cacheDir, entrySize);
+
+    char partPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    TextCopy(partPath, TextFormat("%s.part", outPath));
+    PHYSFS_File* source = PHYSFS_openRead(path);
+    FILE* destination = (source != NULL) ? raylib_libretro_vfs_fopen(partPath, "wb") : NULL;
+    unsigned char* buffer = (destination != NULL) ? (unsigned char*)MemAlloc(1024 * 1024) : NULL;
+    uint64_t written = 0;
+    bool ok = buffer != NULL;
+    while (ok) {
+        PHYSFS_sint64 bytes = PHYSFS_readBytes(source, buffer, 1024 * 1024);
+        if (bytes <= 0) {
+            ok = bytes == 0 && PHYSFS_eof(source);
+            break;
+        }
+        ok = fwrite(buffer, 1, (size_t)bytes, destination) == (size_t)bytes;
+        written += (uint64_t)bytes;
+    }
+    if (buffer != NULL) MemFree(buffer);
+    if (destination != NULL && fclose(destination) != 0) ok = false;
+    if (source != NULL) PHYSFS_close(source);
+
+    ok = ok && written == entrySize;
+    if (ok) {
+        ok = raylib_libretro_vfs_replace_file(partPath, outPath);
+    }
+    if (!ok) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to extract %s to the extraction cache", path);
+        if (destination != NULL) FileRemove(partPath);
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "LIBRETRO: Extracted %s to %s", path, outPath);
+    return true;
 }
 
 /**
  * PhysFS-backed VFS hook: stat a path in the PhysFS search path.
  * Returns RETRO_VFS_STAT flags, or 0 if not found.
  */
-static int LibretroPhysFSVfsStat(const char* path, int32_t* size) {
+static int LibretroPhysFSVfsStat(const char* path, int64_t* size) {
     if (!IsPhysFSReady()) return 0;
     PHYSFS_Stat stat;
     if (PHYSFS_stat(path, &stat) == 0) return 0;
@@ -85,22 +911,40 @@ static int LibretroPhysFSVfsStat(const char* path, int32_t* size) {
         return RETRO_VFS_STAT_IS_DIRECTORY | RETRO_VFS_STAT_IS_VALID;
     }
     if (stat.filetype == PHYSFS_FILETYPE_REGULAR) {
-        if (size != NULL) *size = (int32_t)stat.filesize;
+        if (size != NULL) *size = (int64_t)stat.filesize;
         return RETRO_VFS_STAT_IS_VALID;
     }
     return 0;
 }
 
 /**
- * PhysFS-backed VFS hook: list directory contents from the PhysFS search path.
- * Returns an empty list when the directory is not found.
+ * Forwards PHYSFS_enumerate() entries to a VFS directory callback.
+ */
+typedef struct LibretroPhysFSEnumerateContext {
+    void (*callback)(void* userData, const char* name, int isDir);
+    void* userData;
+} LibretroPhysFSEnumerateContext;
+
+static PHYSFS_EnumerateCallbackResult LibretroPhysFSVfsEnumerateEntry(void* data, const char* origdir, const char* fname) {
+    (void)origdir;
+    LibretroPhysFSEnumerateContext* context = (LibretroPhysFSEnumerateContext*)data;
+
+    // The type is left unknown; the VFS only stats entries a core asks about.
+    context->callback(context->userData, fname, -1);
+    return PHYSFS_ENUM_OK;
+}
+
+/**
+ * PhysFS-backed VFS hook: enumerate directory contents from the PhysFS search
+ * path through a callback. Returns false when the directory is not found.
  */
-static FilePathList LibretroPhysFSVfsLoadDirFiles(const char* dirPath) {
-    if (IsPhysFSReady() && DirectoryExistsInPhysFS(dirPath)) {
-        return LoadDirectoryFilesFromPhysFS(dirPath);
+static bool LibretroPhysFSVfsEnumerate(const char* dirPath, void (*callback)(void* userData, const char* name, int isDir), void* userData) {
+    if (!IsPhysFSReady() || !DirectoryExistsInPhysFS(dirPath)) {
+        return false;
     }
-    FilePathList empty = {0};
-    return empty;
+
+    LibretroPhysFSEnumerateContext context = { callback, userData };
+    return PHYSFS_enumerate(dirPath, LibretroPhysFSVfsEnumerateEntry, &context) != 0;
 }
 
 /**
@@ -111,6 +955,7 @@ static void LibretroPhysFSClearMount(void) {
         UnmountPhysFS(LibretroPhysFS.mountSource);
         LibretroPhysFS.mountSource[0] = '\0';
     }
+    LibretroPhysFS.mountIsArchive = false;
 }
 
 /**
@@ -126,7 +971,12 @@ static bool InitLibretroPhysFS(void) {
     }
     raylib_libretro_vfs_alt_load_file_data = LibretroPhysFSVfsLoadFileData;
     raylib_libretro_vfs_alt_stat = LibretroPhysFSVfsStat;
-    raylib_libretro_vfs_alt_load_dir_files = LibretroPhysFSVfsLoadDirFiles;
+    raylib_libretro_vfs_alt_enumerate = LibretroPhysFSVfsEnumerate;
+    raylib_libretro_vfs_alt_open = LibretroPhysFSVfsOpen;
+    raylib_libretro_vfs_alt_read = LibretroPhysFSVfsRead;
+    raylib_libretro_vfs_alt_seek = LibretroPhysFSVfsSeek;
+    raylib_libretro_vfs_alt_close = LibretroPhysFSVfsClose;
+    raylib_libretro_vfs_alt_extract = LibretroPhysFSVfsExtract;
     LibretroPhysFS.ready = true;
     return true;
 }
@@ -135,11 +985,19 @@ static bool InitLibretroPhysFS(void) {
  * Tear down PhysFS, unmounting any active /game mount.
  */
 static void CloseLibretroPhysFS(void) {
+    CancelLoadLibretroGame();
+    LibretroZipIndexStopWarm();
+    UnloadLibretroZipIndex(&LibretroPhysFS.zipIndex);
     LibretroPhysFSClearMount();
     if (LibretroPhysFS.ready) {
         raylib_libretro_vfs_alt_load_file_data = NULL;
         raylib_libretro_vfs_alt_stat = NULL;
-        raylib_libretro_vfs_alt_load_dir_files = NULL;
+        raylib_libretro_vfs_alt_enumerate = NULL;
+        raylib_libretro_vfs_alt_open = NULL;
+        raylib_libretro_vfs_alt_read = NULL;
+        raylib_libretro_vfs_alt_seek = NULL;
+        raylib_libretro_vfs_alt_close = NULL;
+        raylib_libretro_vfs_alt_extract = NULL;
         ClosePhysFS();
         LibretroPhysFS.ready = false;
     }
@@ -155,15 +1013,24 @@ static void CloseLibretroPhysFS(void) {
  *   2. The same basename without the extension. For example: mario.zip > mario.nes
  *   3. The first entry whose extension appears in the core's retro_system_info::valid_extensions
  *
- * Subdirectories are searched recursively.
+ * Subdirectories are searched recursively, in the archive's own entry order.
  *
- * @param zipFile Path of the original archive (used to derive the basename).
+ * @param zipFile Path of the original archive (used to derive the basename and
+ *                look up its zip index).
+ * @param exts    The core's valid extensions, pipe-separated; NULL or empty
+ *                accepts any entry.
  * @param outPath Caller-provided buffer (at least RAYLIB_LIBRETRO_VFS_MAX_PATH
  *                bytes) that receives the virtual path on success.
  * @return \c true if a candidate was found and copied into @p outPath.
  */
-static bool LibretroPhysFSPickFileInZip(const char* zipFile, char* outPath) {
-    FilePathList entries = LoadDirectoryFilesFromPhysFSEx("/game", NULL, true);
+static bool LibretroPhysFSPickFileInZipEx(const char* zipFile, const char* exts, char* outPath) {
+    // The zip index lists the archive without walking the mount; fall back to
+    // PhysFS for anything the index can't read.
+    FilePathList entries = LoadLibretroZipEntryPaths(zipFile, "/game");
+    if (entries.count == 0) {
+        UnloadDirectoryFiles(entries);
+        entries = LoadDirectoryFilesFromPhysFSEx("/game", NULL, true);
+    }
     if (entries.count == 0) {
         UnloadDirectoryFiles(entries);
         return false;
@@ -172,8 +1039,7 @@ static bool LibretroPhysFSPickFileInZip(const char* zipFile, char* outPath) {
     const char* zipBase = GetFileNameWithoutExt(zipFile);
     bool found = false;
 
-    // The loaded core's valid extensions, as an IsFileExtension pattern.
-    const char* exts = GetLibretroValidExtensions();
+    // The core's valid extensions, as an IsFileExtension pattern.
     bool hasExts = exts != NULL && exts[0] != '\0';
     char pattern[256] = {0};
     if (hasExts) {
@@ -224,25 +1090,52 @@ static bool LibretroPhysFSPickFileInZip(const char* zipFile, char* outPath) {
 }
 
 /**
- * Zip-aware replacement for LoadLibretroGame().
- *
- * @param gameFile OS path to the ROM or .zip. May be NULL for a
- *                 content-less core load.
- * @return \c true on success, \c false on failure.
+ * Pick the ROM file inside /game for the loaded core.
+ * @see LibretroPhysFSPickFileInZipEx
  */
-static bool LoadLibretroGameFromPhysFS(const char* gameFile) {
-    if (gameFile == NULL) {
-        return LoadLibretroGame(NULL);
+static bool LibretroPhysFSPickFileInZip(const char* zipFile, char* outPath) {
+    return LibretroPhysFSPickFileInZipEx(zipFile, GetLibretroValidExtensions(), outPath);
+}
+
+/**
+ * Results of LibretroPhysFSMountGame().
+ */
+typedef enum LibretroPhysFSMountResult {
+    LIBRETRO_PHYSFS_MOUNT_FAILED = 0,   // content missing, or nothing loadable in the archive
+    LIBRETRO_PHYSFS_MOUNT_DIRECT,       // PhysFS unavailable; load the OS path with LoadLibretroGame()
+    LIBRETRO_PHYSFS_MOUNT_OK            // mounted at /game, with the content at virtualPath
+} LibretroPhysFSMountResult;
+
+/**
+ * PhysFS, its /game mount and the asynchronous load are shared by the whole
+ * process, so only the default instance loads through them. Other instances
+ * load plain files with LoadLibretroGame().
+ */
+static bool LibretroPhysFSIsDefaultInstance(void) {
+    if (GetLibretroInstance() == &LibretroDefaultInstance) {
+        return true;
     }
+    TraceLog(LOG_DEBUG, "LIBRETRO: PhysFS is only used by the default instance");
+    return false;
+}
 
+/**
+ * The stat and mount stages of a load: checks the content exists, mounts it
+ * (or its directory) at /game, and resolves the content's virtual path.
+ *
+ * @param gameFile    OS path to the ROM or .zip.
+ * @param virtualPath Receives the content path inside /game.
+ * @return Whether the content is mounted, see LibretroPhysFSMountResult.
+ */
+static LibretroPhysFSMountResult LibretroPhysFSMountGame(const char* gameFile, char* virtualPath) {
     if (!FileExists(gameFile)) {
         TraceLog(LOG_ERROR, "LIBRETRO: Given content does not exist: %s", gameFile);
-        return false;
+        return LIBRETRO_PHYSFS_MOUNT_FAILED;
     }
 
     if (!LibretroPhysFS.ready && !InitLibretroPhysFS()) {
         // No PhysFS — fall back to the direct path-based loader.
-        return LoadLibretroGame(gameFile);
+        return LIBRETRO_PHYSFS_MOUNT_DIRECT;
     }
 
     // Drop any prior mount before establishing a new one.
@@ -254,52 +1147,425 @@ static bool LoadLibretroGameFromPhysFS(const char* gameFile) {
 
     if (!MountPhysFS(mountSource, "/game")) {
         TraceLog(LOG_ERROR, "LIBRETRO: Failed to mount %s at /game", mountSource);
-        return LoadLibretroGame(gameFile);
+        return LIBRETRO_PHYSFS_MOUNT_DIRECT;
     }
     TextCopy(LibretroPhysFS.mountSource, mountSource);
+    LibretroPhysFS.mountIsArchive = treatAsArchive;
 
     // Resolve the virtual ROM path inside /game.
-    char virtualPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
     if (treatAsArchive) {
         if (!LibretroPhysFSPickFileInZip(gameFile, virtualPath)) {
             TraceLog(LOG_ERROR, "LIBRETRO: No suitable ROM found inside %s", gameFile);
             LibretroPhysFSClearMount();
-            return false;
+            return LIBRETRO_PHYSFS_MOUNT_FAILED;
         }
     } else {
         TextCopy(virtualPath, TextFormat("/game/%s", GetFileName(gameFile)));
     }
+    return LIBRETRO_PHYSFS_MOUNT_OK;
+}
+
+/**
+ * Loads mounted content for a core that wants a path rather than data.
+ */
+static bool LibretroPhysFSLoadFullPath(const char* gameFile, const char* virtualPath) {
+    bool ok = LoadLibretroGame(LibretroPhysFS.mountIsArchive ? virtualPath : gameFile);
+    if (!ok) LibretroPhysFSClearMount();
+    return ok;
+}
+
+/**
+ * Zip-aware replacement for LoadLibretroGame().
+ *
+ * @param gameFile OS path to the ROM or .zip. May be NULL for a
+ *                 content-less core load.
+ * @return \c true on success, \c false on failure.
+ * @see BeginLoadLibretroGameFromPhysFS
+ */
+static bool LoadLibretroGameFromPhysFS(const char* gameFile) {
+    if (!LibretroPhysFSIsDefaultInstance()) {
+        return LoadLibretroGame(gameFile);
+    }
+
+    // A load in flight would be reading from the mount about to be replaced.
+    CancelLoadLibretroGame();
+
+    if (gameFile == NULL) {
+        return LoadLibretroGame(NULL);
+    }
+
+    char virtualPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    LibretroPhysFSMountResult mount = LibretroPhysFSMountGame(gameFile, virtualPath);
+    if (mount == LIBRETRO_PHYSFS_MOUNT_FAILED) {
+        return false;
+    }
+    if (mount == LIBRETRO_PHYSFS_MOUNT_DIRECT) {
+        return LoadLibretroGame(gameFile);
+    }
 
     // Per-extension content_info_override may flip need_fullpath for the
     // picked ROM (e.g. fceumm declares need_fullpath=false for .nes).
     bool persistent = false;
     if (GetLibretroNeedFullpath(virtualPath, &persistent)) {
-        if (treatAsArchive) {
-            bool ok = LoadLibretroGame(virtualPath);
-            if (!ok) LibretroPhysFSClearMount();
-            return ok;
-        }
-        bool ok = LoadLibretroGame(gameFile);
-        if (!ok) LibretroPhysFSClearMount();
-        return ok;
+        return LibretroPhysFSLoadFullPath(gameFile, virtualPath);
     }
 
-    // Memory path: read through PhysFS, hand to the in-memory loader.
-    int size = 0;
-    unsigned char* gameData = LoadFileDataFromPhysFS(virtualPath, &size);
-    if (gameData == NULL || size == 0) {
-        TraceLog(LOG_ERROR, "LIBRETRO: Failed to read game data from %s", virtualPath);
-        UnloadFileData(gameData);
+    // Memory path: stream the entry through the VFS into a single buffer and
+    // hand it to the in-memory loader.
+    bool ok = LoadLibretroGameFromVFS(virtualPath, persistent);
+    if (!ok) LibretroPhysFSClearMount();
+    return ok;
+}
+
+/**
+ * An asynchronous game load. Only the worker touches file while reading is
+ * set; the main thread waits for finished before using it again. While the
+ * worker runs, bytesRead, cancel, finished, ok and readEnd are only touched
+ * under lock, which also publishes the file's buffer along with finished.
+ */
+typedef struct rLibretroGameLoad {
+    LibretroGameLoadState state;
+    struct retro_vfs_file_handle* file;     // content being read, until it's handed to the core
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH]; // content path reported to the core
+    char source[RAYLIB_LIBRETRO_VFS_MAX_PATH]; // OS path of a prefetch, empty once a core owns the load
+    bool persistent;
+    bool reading;                           // a worker was started for file
+    int64_t bytesRead;
+    bool cancel;
+    bool finished;
+    bool ok;
+    int64_t readStart;                      // cpu_features_get_time_usec() when the read started
+    int64_t readEnd;                        // and when it finished, 0 until then
+#ifdef HAVE_THREADS
+    sthread_t* thread;
+    slock_t* lock;                          // NULL when the read runs on the main thread
+#endif
+} rLibretroGameLoad;
+
+static rLibretroGameLoad LibretroGameLoad = { LIBRETRO_GAME_LOAD_IDLE };
+
+static void LibretroGameLoadLock(void) {
+#ifdef HAVE_THREADS
+    if (LibretroGameLoad.lock != NULL) slock_lock(LibretroGameLoad.lock);
+#endif
+}
+
+static void LibretroGameLoadUnlock(void) {
+#ifdef HAVE_THREADS
+    if (LibretroGameLoad.lock != NULL) slock_unlock(LibretroGameLoad.lock);
+#endif
+}
+
+/**
+ * Publishes the read's progress, and says whether to keep reading.
+ */
+static bool LibretroGameLoadProgress(int64_t loaded, void* userData) {
+    rLibretroGameLoad* load = (rLibretroGameLoad*)userData;
+    LibretroGameLoadLock();
+    load->bytesRead = loaded;
+    bool cancel = load->cancel;
+    LibretroGameLoadUnlock();
+    return !cancel;
+}
+
+/**
+ * Reads and inflates the content into the handle's buffer.
+ */
+static void LibretroGameLoadRead(void* userData) {
+    rLibretroGameLoad* load = (rLibretroGameLoad*)userData;
+    bool ok = raylib_libretro_vfs_load_data(load->file, LibretroGameLoadProgress, load) != NULL;
+    int64_t end = (int64_t)cpu_features_get_time_usec();
+    LibretroGameLoadLock();
+    load->ok = ok;
+    load->readEnd = end;
+    load->finished = true;
+    LibretroGameLoadUnlock();
+}
+
+/**
+ * Waits for the read worker, if there is one, to stop.
+ */
+static void LibretroGameLoadJoin(void) {
+#ifdef HAVE_THREADS
+    if (LibretroGameLoad.thread != NULL) {
+        sthread_join(LibretroGameLoad.thread);
+        LibretroGameLoad.thread = NULL;
+    }
+    if (LibretroGameLoad.lock != NULL) {
+        slock_free(LibretroGameLoad.lock);
+        LibretroGameLoad.lock = NULL;
+    }
+#endif
+    LibretroGameLoad.reading = false;
+}
+
+/**
+ * Open mounted content and start reading it on a worker.
+ */
+static bool LibretroGameLoadStart(const char* virtualPath, bool persistent) {
+    LibretroGameLoad.file = raylib_libretro_vfs_open(virtualPath, RETRO_VFS_FILE_ACCESS_READ, RETRO_VFS_FILE_ACCESS_HINT_FREQUENT_ACCESS);
+    if (LibretroGameLoad.file == NULL) {
         LibretroPhysFSClearMount();
         return false;
     }
+    TextCopy(LibretroGameLoad.path, virtualPath);
+    LibretroGameLoad.source[0] = '\0';
+    LibretroGameLoad.persistent = persistent;
+    LibretroGameLoad.bytesRead = 0;
+    LibretroGameLoad.cancel = false;
+    LibretroGameLoad.finished = false;
+    LibretroGameLoad.ok = false;
+    LibretroGameLoad.readStart = (int64_t)cpu_features_get_time_usec();
+    LibretroGameLoad.readEnd = 0;
+    LibretroGameLoad.reading = true;
+    LibretroGameLoad.state = LIBRETRO_GAME_LOAD_READING;
 
-    bool ok = LoadLibretroGameFromMemoryEx(gameData, size, virtualPath, persistent);
-    if (!ok) LibretroPhysFSClearMount();
-    if (!ok || !persistent) {
-        UnloadFileData(gameData);
+#ifdef HAVE_THREADS
+    LibretroGameLoad.lock = slock_new();
+    if (LibretroGameLoad.lock != NULL) {
+        LibretroGameLoad.thread = sthread_create(LibretroGameLoadRead, &LibretroGameLoad);
+        if (LibretroGameLoad.thread != NULL) {
+            return true;
+        }
+        slock_free(LibretroGameLoad.lock);
+        LibretroGameLoad.lock = NULL;
     }
-    return ok;
+    TraceLog(LOG_WARNING, "LIBRETRO: Content loader thread unavailable, reading on the main thread");
+#endif
+    LibretroGameLoadRead(&LibretroGameLoad);
+    return true;
+}
+
+/**
+ * Start reading content before the core that loads it is initialized, so the
+ * read overlaps the core's dlopen and retro_init().
+ *
+ * The core isn't loaded yet, so the entry inside a .zip is picked with the
+ * extensions from its .info file, and the core is assumed to take the content
+ * as data. BeginLoadLibretroGameFromPhysFS() for the same file then adopts the
+ * read if the initialized core agrees, or starts over if it doesn't.
+ *
+ * @param gameFile        OS path to the ROM or .zip.
+ * @param validExtensions The core's supported extensions, pipe-separated.
+ * @return \c true if a read was started.
+ */
+static bool PrefetchLibretroGameFromPhysFS(const char* gameFile, const char* validExtensions) {
+    if (!LibretroPhysFSIsDefaultInstance()) {
+        return false;
+    }
+    CancelLoadLibretroGame();
+    LibretroGameLoad.state = LIBRETRO_GAME_LOAD_IDLE;
+
+    if (gameFile == NULL || !FileExists(gameFile)) {
+        return false;
+    }
+    if (!LibretroPhysFS.ready && !InitLibretroPhysFS()) {
+        return false;
+    }
+
+    LibretroPhysFSClearMount();
+    bool isZip = IsFileExtension(gameFile, ".zip");
+    const char* mountSource = isZip ? gameFile : GetDirectoryPath(gameFile);
+    if (!MountPhysFS(mountSource, "/game")) {
+        return false;
+    }
+    TextCopy(LibretroPhysFS.mountSource, mountSource);
+    LibretroPhysFS.mountIsArchive = isZip;
+
+    char virtualPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    if (isZip) {
+        if (!LibretroPhysFSPickFileInZipEx(gameFile, validExtensions, virtualPath)) {
+            LibretroPhysFSClearMount();
+            return false;
+        }
+    } else {
+        TextCopy(virtualPath, TextFormat("/game/%s", GetFileName(gameFile)));
+    }
+
+    if (!LibretroGameLoadStart(virtualPath, false)) {
+        return false;
+    }
+    TextCopy(LibretroGameLoad.source, gameFile);
+    return true;
+}
+
+/**
+ * Take over a prefetch of gameFile for the now initialized core, if it read
+ * what the core would have asked for.
+ */
+static bool LibretroGameLoadAdoptPrefetch(const char* gameFile) {
+    if (!LibretroGameLoad.reading || !TextIsEqual(LibretroGameLoad.source, gameFile)) {
+        return false;
+    }
+    LibretroGameLoad.source[0] = '\0';
+
+    // The core must want the same entry, without extraction blocked, as data.
+    if (LibretroPhysFS.mountIsArchive) {
+        char virtualPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+        if (IsLibretroBlockExtract() || !LibretroPhysFSPickFileInZip(gameFile, virtualPath) ||
+                !TextIsEqual(virtualPath, LibretroGameLoad.path)) {
+            return false;
+        }
+    }
+    bool persistent = false;
+    if (GetLibretroNeedFullpath(LibretroGameLoad.path, &persistent)) {
+        return false;
+    }
+    LibretroGameLoad.persistent = persistent;
+    TraceLog(LOG_INFO, "LIBRETRO: Using content prefetched while the core initialized");
+    return true;
+}
+
+/**
+ * Start loading a game without blocking: the zip-aware equivalent of
+ * LoadLibretroGameFromPhysFS(), split into stages.
+ *
+ * The content is checked and mounted right away. Content handed to the core
+ * as data is then read and inflated on a worker thread, and passed to
+ * retro_load_game() by UpdateLoadLibretroGame() on the main thread. Content
+ * the core opens by path itself has nothing to read ahead, so it is loaded
+ * immediately, in which case IsLibretroGameLoading() is false on return.
+ *
+ * @param gameFile OS path to the ROM or .zip, or NULL for a content-less load.
+ * @return \c false if the load already failed.
+ */
+static bool BeginLoadLibretroGameFromPhysFS(const char* gameFile) {
+    if (!LibretroPhysFSIsDefaultInstance()) {
+        return LoadLibretroGame(gameFile);
+    }
+    if (gameFile != NULL && LibretroGameLoadAdoptPrefetch(gameFile)) {
+        return true;
+    }
+
+    CancelLoadLibretroGame();
+    LibretroGameLoad.state = LIBRETRO_GAME_LOAD_IDLE;
+
+    char virtualPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    LibretroPhysFSMountResult mount = (gameFile != NULL) ? LibretroPhysFSMountGame(gameFile, virtualPath) : LIBRETRO_PHYSFS_MOUNT_DIRECT;
+    if (mount == LIBRETRO_PHYSFS_MOUNT_FAILED) {
+        return false;
+    }
+
+    bool persistent = false;
+    if (mount == LIBRETRO_PHYSFS_MOUNT_DIRECT || GetLibretroNeedFullpath(virtualPath, &persistent)) {
+        return (mount == LIBRETRO_PHYSFS_MOUNT_DIRECT) ? LoadLibretroGame(gameFile) : LibretroPhysFSLoadFullPath(gameFile, virtualPath);
+    }
+
+    return LibretroGameLoadStart(virtualPath, persistent);
+}
+
+/**
+ * Advance an asynchronous load. Call once per frame while
+ * IsLibretroGameLoading() is true.
+ *
+ * While the content is being read, this shows its progress as an OSD progress
+ * bar. Once it has been read, it is handed to the core on this thread.
+ *
+ * @return The load's state. \c LIBRETRO_GAME_LOAD_DONE, \c _FAILED and
+ * \c _CANCELLED are reported once, after which the state is idle again.
+ */
+static LibretroGameLoadState UpdateLoadLibretroGame(void) {
+    LibretroGameLoadState state = LibretroGameLoad.state;
+    if (state != LIBRETRO_GAME_LOAD_READING) {
+        LibretroGameLoad.state = LIBRETRO_GAME_LOAD_IDLE;
+        return state;
+    }
+
+    LibretroGameLoadLock();
+    bool finished = LibretroGameLoad.finished;
+    LibretroGameLoadUnlock();
+    if (!finished) {
+        struct retro_message_ext message = {0};
+        message.msg = TextFormat("Loading %s", GetFileName(LibretroGameLoad.path));
+        message.duration = 1000;
+        message.priority = 1;
+        message.level = RETRO_LOG_INFO;
+        message.target = RETRO_MESSAGE_TARGET_OSD;
+        message.type = RETRO_MESSAGE_TYPE_PROGRESS;
+        message.progress = (int8_t)(GetLibretroGameLoadProgress() * 100.0f);
+        SetLibretroMessageEx(&message);
+        return state;
+    }
+
+    LibretroGameLoadJoin();
+    SetLibretroMessage(NULL, 0.0);
+
+    struct retro_vfs_file_handle* file = LibretroGameLoad.file;
+    LibretroGameLoad.file = NULL;
+    if (LibretroGameLoad.cancel || !LibretroGameLoad.ok) {
+        raylib_libretro_vfs_close(file);
+        LibretroPhysFSClearMount();
+        state = LibretroGameLoad.cancel ? LIBRETRO_GAME_LOAD_CANCELLED : LIBRETRO_GAME_LOAD_FAILED;
+    } else if (LoadLibretroGameFromVFSHandle(file, LibretroGameLoad.path, LibretroGameLoad.persistent)) {
+        state = LIBRETRO_GAME_LOAD_DONE;
+    } else {
+        LibretroPhysFSClearMount();
+        state = LIBRETRO_GAME_LOAD_FAILED;
+    }
+
+    LibretroGameLoad.state = LIBRETRO_GAME_LOAD_IDLE;
+    return state;
+}
+
+/**
+ * Abandon an in-flight asynchronous load, waiting for its worker to stop.
+ * The next UpdateLoadLibretroGame() reports \c LIBRETRO_GAME_LOAD_CANCELLED.
+ */
+static void CancelLoadLibretroGame(void) {
+    if (!LibretroGameLoad.reading) {
+        return;
+    }
+
+    LibretroGameLoadLock();
+    LibretroGameLoad.cancel = true;
+    LibretroGameLoadUnlock();
+    LibretroGameLoad.source[0] = '\0';
+    LibretroGameLoadJoin();
+    raylib_libretro_vfs_close(LibretroGameLoad.file);
+    LibretroGameLoad.file = NULL;
+    LibretroPhysFSClearMount();
+    LibretroGameLoad.state = LIBRETRO_GAME_LOAD_CANCELLED;
+}
+
+/**
+ * Check whether an asynchronous load is still reading its content.
+ */
+static bool IsLibretroGameLoading(void) {
+    return LibretroGameLoad.state == LIBRETRO_GAME_LOAD_READING;
+}
+
+/**
+ * Get how much of the content an asynchronous load has read.
+ *
+ * @return A fraction from 0 to 1.
+ */
+static float GetLibretroGameLoadProgress(void) {
+    if (LibretroGameLoad.file == NULL || LibretroGameLoad.file->dataSize <= 0) {
+        return 0.0f;
+    }
+    LibretroGameLoadLock();
+    int64_t bytesRead = LibretroGameLoad.bytesRead;
+    LibretroGameLoadUnlock();
+    return (float)((double)bytesRead / (double)LibretroGameLoad.file->dataSize);
+}
+
+/**
+ * Get when the last asynchronous load read its content.
+ *
+ * @param startUsec Receives when the read started, from cpu_features_get_time_usec().
+ * @param endUsec   Receives when it finished.
+ * @return \c false if no read has finished.
+ */
+static bool GetLibretroGameLoadReadTime(int64_t* startUsec, int64_t* endUsec) {
+    LibretroGameLoadLock();
+    int64_t readEnd = LibretroGameLoad.readEnd;
+    LibretroGameLoadUnlock();
+    if (readEnd == 0) {
+        return false;
+    }
+    if (startUsec) *startUsec = LibretroGameLoad.readStart;
+    if (endUsec) *endUsec = readEnd;
+    return true;
 }
 
 #if defined(__cplusplus)
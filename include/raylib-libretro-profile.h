@@ -0,0 +1,183 @@
+/**********************************************************************************************
+*
+*   raylib-libretro-profile - Nested phase timings, e.g. of startup, for raylib-libretro.
+*
+*   LICENSE: zlib/libpng
+*
+*   raylib-libretro-profile is licensed under an unmodified zlib/libpng license, which is an OSI-certified,
+*   BSD-like license that allows static linking with closed source software:
+*
+*   Copyright (c) 2026 Rob Loach (@RobLoach)
+*
+*   This software is provided "as-is", without any express or implied warranty. In no event
+*   will the authors be held liable for any damages arising from the use of this software.
+*
+*   Permission is granted to anyone to use this software for any purpose, including commercial
+*   applications, and to alter it and redistribute it freely, subject to the following restrictions:
+*
+*     1. The origin of this software must not be misrepresented; you must not claim that you
+*     wrote the original software. If you use this software in a product, an acknowledgment
+*     in the product documentation would be appreciated but is not required.
+*
+*     2. Altered source versions must be plainly marked as such, and must not be misrepresented
+*     as being the original software.
+*
+*     3. This notice may not be removed or altered from any source distribution.
+*
+**********************************************************************************************/
+
+#ifndef RAYLIB_LIBRETRO_PROFILE_H__
+#define RAYLIB_LIBRETRO_PROFILE_H__
+
+#include "libretro.h"
+#include "raylib.h"
+#include <stdio.h>   // FILE
+
+// Phases recorded before further ones are dropped.
+#ifndef RAYLIB_LIBRETRO_PROFILE_MAX
+#define RAYLIB_LIBRETRO_PROFILE_MAX 256
+#endif
+
+/**
+ * A timed phase, between BeginLibretroProfile() and EndLibretroProfile().
+ */
+typedef struct LibretroProfilePhase {
+    char name[64];
+    int parent;             // index of the enclosing phase, -1 at the top
+    int depth;
+    retro_time_t start;     // microseconds, from cpu_features_get_time_usec()
+    retro_time_t end;       // 0 while the phase is still open
+} LibretroProfilePhase;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+static void BeginLibretroProfile(const char* name);
+static void EndLibretroProfile(void);
+static void LogLibretroProfile(int logLevel);
+static bool SaveLibretroProfileTrace(const char* fileName);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
+
+#ifdef RAYLIB_LIBRETRO_PROFILE_IMPLEMENTATION
+#ifndef RAYLIB_LIBRETRO_PROFILE_IMPLEMENTATION_ONCE
+#define RAYLIB_LIBRETRO_PROFILE_IMPLEMENTATION_ONCE
+
+#include <features/features_cpu.h> // cpu_features_get_time_usec()
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Phases in the order they began. Only the main thread records them.
+static LibretroProfilePhase raylib_libretro_profile_phases[RAYLIB_LIBRETRO_PROFILE_MAX];
+static int raylib_libretro_profile_count = 0;
+static int raylib_libretro_profile_current = -1;
+static int raylib_libretro_profile_dropped = 0;   // open phases that didn't fit
+
+/**
+ * Start timing a phase, nested in the phase that is open, if any. Every call
+ * needs a matching EndLibretroProfile().
+ *
+ * @param name What the phase does; copied, truncated to 63 characters.
+ */
+static void BeginLibretroProfile(const char* name) {
+    if (raylib_libretro_profile_count >= RAYLIB_LIBRETRO_PROFILE_MAX) {
+        raylib_libretro_profile_dropped++;
+        return;
+    }
+    LibretroProfilePhase* phase = &raylib_libretro_profile_phases[raylib_libretro_profile_count];
+    snprintf(phase->name, sizeof(phase->name), "%s", name != NULL ? name : "");
+    phase->parent = raylib_libretro_profile_current;
+    phase->depth = (phase->parent >= 0) ? raylib_libretro_profile_phases[phase->parent].depth + 1 : 0;
+    phase->end = 0;
+    raylib_libretro_profile_current = raylib_libretro_profile_count++;
+    phase->start = cpu_features_get_time_usec();
+}
+
+/**
+ * Stop timing the innermost open phase.
+ */
+static void EndLibretroProfile(void) {
+    retro_time_t now = cpu_features_get_time_usec();
+    if (raylib_libretro_profile_dropped > 0) {
+        raylib_libretro_profile_dropped--;
+        return;
+    }
+    if (raylib_libretro_profile_current < 0) {
+        return;
+    }
+    LibretroProfilePhase* phase = &raylib_libretro_profile_phases[raylib_libretro_profile_current];
+    phase->end = now;
+    raylib_libretro_profile_current = phase->parent;
+}
+
+// Length of a phase; phases still open are measured up to now.
+static retro_time_t raylib_libretro_profile_duration(const LibretroProfilePhase* phase, retro_time_t now) {
+    return ((phase->end != 0) ? phase->end : now) - phase->start;
+}
+
+/**
+ * Log the phases as a tree: each one's time, and its share of the phase it
+ * is nested in.
+ */
+static void LogLibretroProfile(int logLevel) {
+    retro_time_t now = cpu_features_get_time_usec();
+    for (int i = 0; i < raylib_libretro_profile_count; i++) {
+        const LibretroProfilePhase* phase = &raylib_libretro_profile_phases[i];
+        double ms = (double)raylib_libretro_profile_duration(phase, now) / 1000.0;
+        int indent = phase->depth * 2;
+        if (phase->parent < 0) {
+            TraceLog(logLevel, "PROFILE: %*s%-*s %10.2f ms", indent, "", 40 - indent, phase->name, ms);
+            continue;
+        }
+        double parentMs = (double)raylib_libretro_profile_duration(&raylib_libretro_profile_phases[phase->parent], now) / 1000.0;
+        TraceLog(logLevel, "PROFILE: %*s%-*s %10.2f ms %5.1f%%", indent, "", 40 - indent, phase->name, ms,
+            parentMs > 0.0 ? ms * 100.0 / parentMs : 0.0);
+    }
+}
+
+/**
+ * Write the phases as a Chrome trace_event JSON file, for chrome://tracing
+ * or https://ui.perfetto.dev.
+ *
+ * @param fileName The file to write, replacing any existing one.
+ * @return true on success.
+ */
+static bool SaveLibretroProfileTrace(const char* fileName) {
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "PROFILE: Failed to write %s", fileName);
+        return false;
+    }
+
+    retro_time_t now = cpu_features_get_time_usec();
+    retro_time_t origin = (raylib_libretro_profile_count > 0) ? raylib_libretro_profile_phases[0].start : now;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (int i = 0; i < raylib_libretro_profile_count; i++) {
+        const LibretroProfilePhase* phase = &raylib_libretro_profile_phases[i];
+        fprintf(file, "%s\n{\"name\":\"", i > 0 ? "," : "");
+        for (const char* c = phase->name; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') fputc('\\', file);
+            if ((unsigned char)*c >= 0x20) fputc(*c, file);
+        }
+        fprintf(file, "\",\"cat\":\"raylib-libretro\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lld,\"dur\":%lld}",
+            (long long)(phase->start - origin), (long long)raylib_libretro_profile_duration(phase, now));
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    TraceLog(LOG_INFO, "PROFILE: Wrote %d phases to %s", raylib_libretro_profile_count, fileName);
+    return true;
+}
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
+#endif
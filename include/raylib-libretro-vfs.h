@@ -32,10 +32,16 @@
 #include "libretro.h"
 #include "raylib.h"
 #include <string.h>  // memcpy
+#include <stdio.h>   // FILE
 #ifndef RAYLIB_LIBRETRO_VFS_MAX_PATH
 #define RAYLIB_LIBRETRO_VFS_MAX_PATH 4096
 #endif
 
+// Bytes of pending writes a file-backed write handle holds before they reach the OS.
+#ifndef RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE
+#define RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE (64 * 1024)
+#endif
+
 #ifndef RAYLIB_LIBRETRO_VFS_SEEK_SET
 #define RAYLIB_LIBRETRO_VFS_SEEK_SET  0 /* Seek from beginning of file.  */
 #endif
@@ -46,20 +52,81 @@
 #define RAYLIB_LIBRETRO_VFS_SEEK_END  2       /* Set file pointer to EOF plus "offset" */
 #endif
 
+/**
+ * The VFS calls counted by raylib_libretro_vfs_stats.
+ */
+typedef enum raylib_libretro_vfs_call {
+    RAYLIB_LIBRETRO_VFS_CALL_OPEN = 0,
+    RAYLIB_LIBRETRO_VFS_CALL_CLOSE,
+    RAYLIB_LIBRETRO_VFS_CALL_SIZE,
+    RAYLIB_LIBRETRO_VFS_CALL_TELL,
+    RAYLIB_LIBRETRO_VFS_CALL_SEEK,
+    RAYLIB_LIBRETRO_VFS_CALL_READ,
+    RAYLIB_LIBRETRO_VFS_CALL_WRITE,
+    RAYLIB_LIBRETRO_VFS_CALL_FLUSH,
+    RAYLIB_LIBRETRO_VFS_CALL_TRUNCATE,
+    RAYLIB_LIBRETRO_VFS_CALL_REMOVE,
+    RAYLIB_LIBRETRO_VFS_CALL_RENAME,
+    RAYLIB_LIBRETRO_VFS_CALL_STAT,
+    RAYLIB_LIBRETRO_VFS_CALL_MKDIR,
+    RAYLIB_LIBRETRO_VFS_CALL_OPENDIR,
+    RAYLIB_LIBRETRO_VFS_CALL_READDIR,
+    RAYLIB_LIBRETRO_VFS_CALL_CLOSEDIR,
+    RAYLIB_LIBRETRO_VFS_CALL_COUNT
+} raylib_libretro_vfs_call;
+
+/**
+ * I/O counters, kept for each file handle and as a process-wide total.
+ */
+typedef struct raylib_libretro_vfs_stats {
+    uint64_t calls[RAYLIB_LIBRETRO_VFS_CALL_COUNT];   // number of calls, e.g. calls[RAYLIB_LIBRETRO_VFS_CALL_SEEK]
+    int64_t usec[RAYLIB_LIBRETRO_VFS_CALL_COUNT];     // microseconds spent in each call
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    uint64_t largestAllocation;                       // largest single buffer allocated for a handle, in bytes
+} raylib_libretro_vfs_stats;
+
 struct retro_vfs_file_handle {
-    unsigned char* data;
+    unsigned char* data;        // in-memory contents (alternate filesystem files), or NULL
     char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
     int mode;
     unsigned int hints;
-    int dataSize;
+    int64_t dataSize;
     int64_t position;
+    unsigned char* mapping;     // read-only mmap() of a real file, or NULL
+    FILE* file;                 // streamed real file (write handles, or reads that can't be mapped), or NULL
+    int64_t filePosition;       // offset of file's own cursor, -1 when unknown
+    unsigned char* buffer;      // write-back buffer for file, RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE bytes
+    int64_t bufferOffset;       // file offset of buffer[0]
+    size_t bufferLength;        // dirty bytes in buffer, written to the file on flush
+    size_t dataCapacity;        // bytes allocated behind data
+    bool dirty;                 // data changed since the last flush
+    void* altFile;              // streamed file from raylib_libretro_vfs_alt_open, or NULL
+    int64_t altPosition;        // offset of altFile's own cursor, -1 when unknown
+    raylib_libretro_vfs_stats stats; // calls made through this handle
 };
 
+/**
+ * One listed entry of a directory handle.
+ */
+typedef struct raylib_libretro_vfs_dir_entry {
+    size_t nameOffset;          // into retro_vfs_dir_handle::names
+    int isDir;                  // 1 directory, 0 not, -1 unknown until asked
+} raylib_libretro_vfs_dir_entry;
+
 struct retro_vfs_dir_handle {
     char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
     bool include_hidden;
-    FilePathList directoryFiles;
-    int directoryFilesIndex;
+    void* dir;                  // DIR* streamed with readdir() for real directories, or NULL
+    raylib_libretro_vfs_dir_entry* entries; // listed entries (alternate filesystem, or platforms without dirent.h)
+    int entryCount;
+    int entryCapacity;
+    char* names;                // names of the listed entries, NUL-terminated back to back
+    size_t namesSize;
+    size_t namesCapacity;
+    int entryIndex;             // current listed entry
+    char entryName[RAYLIB_LIBRETRO_VFS_MAX_PATH]; // current streamed entry
+    int entryIsDir;             // current streamed entry: 1 directory, 0 not, -1 unknown until asked
 };
 
 #if defined(__cplusplus)
@@ -87,6 +154,21 @@ static const char* raylib_libretro_vfs_dirent_get_name(struct retro_vfs_dir_hand
 static bool raylib_libretro_vfs_dirent_is_dir(struct retro_vfs_dir_handle* dirstream);
 static int raylib_libretro_vfs_closedir(struct retro_vfs_dir_handle* dirstream);
 
+// Whole-file helpers, 64-bit clean
+static const unsigned char* raylib_libretro_vfs_get_data(struct retro_vfs_file_handle* stream);
+static const unsigned char* raylib_libretro_vfs_load_data(struct retro_vfs_file_handle* stream, bool (*progress)(int64_t loaded, void* userData), void* userData);
+static bool raylib_libretro_vfs_save_file_data(const char* path, const void* data, uint64_t size);
+static bool raylib_libretro_vfs_replace_file(const char* source, const char* target);
+static bool raylib_libretro_vfs_copy_to_file(struct retro_vfs_file_handle* stream, const char* path);
+
+// Instrumentation
+static const raylib_libretro_vfs_stats* raylib_libretro_vfs_get_stats(void);
+static const raylib_libretro_vfs_stats* raylib_libretro_vfs_get_file_stats(struct retro_vfs_file_handle* stream);
+static void raylib_libretro_vfs_reset_stats(void);
+static const char* raylib_libretro_vfs_call_name(raylib_libretro_vfs_call call);
+static void raylib_libretro_vfs_log_stats(int logLevel);
+static bool raylib_libretro_vfs_set_trace_file(const char* path);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -97,6 +179,44 @@ static int raylib_libretro_vfs_closedir(struct retro_vfs_dir_handle* dirstream);
 #ifndef RAYLIB_LIBRETRO_VFS_IMPLEMENTATION_ONCE
 #define RAYLIB_LIBRETRO_VFS_IMPLEMENTATION_ONCE
 
+#include <sys/stat.h>  // stat()
+#include <limits.h>    // UINT_MAX
+#include <stdarg.h>    // va_list
+#include <features/features_cpu.h> // cpu_features_get_time_usec()
+
+// Read-only handles on real files are memory-mapped where POSIX mmap() exists,
+// and streamed through a FILE* elsewhere, so opening never reads the file.
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__) && !defined(PLATFORM_WEB)
+#define RAYLIB_LIBRETRO_VFS_MMAP
+#include <sys/mman.h>  // mmap(), munmap(), madvise()
+#include <fcntl.h>     // open()
+#endif
+
+// Real directories are streamed with readdir(), whose d_type usually gives
+// each entry's type without a stat(). Windows lists them up front instead.
+#if !defined(_WIN32)
+#define RAYLIB_LIBRETRO_VFS_DIRENT
+#include <dirent.h>    // opendir(), readdir(), closedir()
+#endif
+
+#if defined(_WIN32)
+#include <io.h>        // _chsize_s(), _fileno()
+#define RAYLIB_LIBRETRO_VFS_FSEEK _fseeki64
+#define RAYLIB_LIBRETRO_VFS_FTRUNCATE(file, length) _chsize_s(_fileno(file), (length))
+#else
+#include <unistd.h>    // close(), ftruncate()
+#include <fcntl.h>     // fcntl()
+#define RAYLIB_LIBRETRO_VFS_FSEEK fseeko
+#define RAYLIB_LIBRETRO_VFS_FTRUNCATE(file, length) ftruncate(fileno(file), (off_t)(length))
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>    // _InterlockedExchangeAdd64(), _InterlockedCompareExchange64()
+#endif
+
+// Longest line written to the trace: a path escaped as JSON, plus the counters.
+#define RAYLIB_LIBRETRO_VFS_TRACE_LINE_MAX (RAYLIB_LIBRETRO_VFS_MAX_PATH * 2 + 1024)
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -105,7 +225,7 @@ extern "C" {
  * Optional hook to read a file from an alternate read-only filesystem (e.g. PhysFS).
  *
  * When non-NULL, VFS read operations try this before the real filesystem. The
- * signature matches raylib's \c LoadFileData contract.
+ * signature follows raylib's \c LoadFileData contract, with a 64-bit size.
  *
  * @param fileName The path to load.
  * @param dataSize Out parameter set to the number of bytes read.
@@ -114,7 +234,7 @@ extern "C" {
  * @see raylib_libretro_vfs_alt_stat
  * @see raylib_libretro_vfs_alt_load_dir_files
  */
-static unsigned char* (*raylib_libretro_vfs_alt_load_file_data)(const char* fileName, int* dataSize) = NULL;
+static unsigned char* (*raylib_libretro_vfs_alt_load_file_data)(const char* fileName, int64_t* dataSize) = NULL;
 
 /**
  * Optional hook to stat a path on an alternate read-only filesystem (e.g. PhysFS).
@@ -127,7 +247,7 @@ static unsigned char* (*raylib_libretro_vfs_alt_load_file_data)(const char* file
  * in the alternate filesystem.
  * @see raylib_libretro_vfs_alt_load_file_data
  */
-static int (*raylib_libretro_vfs_alt_stat)(const char* path, int32_t* size) = NULL;
+static int (*raylib_libretro_vfs_alt_stat)(const char* path, int64_t* size) = NULL;
 
 /**
  * Optional hook to list a directory on an alternate read-only filesystem (e.g. PhysFS).
@@ -140,6 +260,297 @@ static int (*raylib_libretro_vfs_alt_stat)(const char* path, int32_t* size) = NU
  */
 static FilePathList (*raylib_libretro_vfs_alt_load_dir_files)(const char* dirPath) = NULL;
 
+/**
+ * Optional hook to enumerate a directory on an alternate read-only filesystem
+ * (e.g. PhysFS) through a callback, without building a \c FilePathList.
+ *
+ * When non-NULL, VFS directory listings try this before
+ * \c raylib_libretro_vfs_alt_load_dir_files.
+ *
+ * @param dirPath The directory to enumerate.
+ * @param callback Called once per entry with its name (not a full path) and
+ * whether it is a directory: 1, 0, or -1 if that isn't known without a stat.
+ * @param userData Passed through to \c callback.
+ * @return \c true if \c dirPath is a directory on the alternate filesystem.
+ */
+static bool (*raylib_libretro_vfs_alt_enumerate)(const char* dirPath, void (*callback)(void* userData, const char* name, int isDir), void* userData) = NULL;
+
+/**
+ * Optional hook to open a file on an alternate read-only filesystem for
+ * streaming (e.g. an entry inside a PhysFS-mounted zip).
+ *
+ * When non-NULL, read-only VFS opens try this before
+ * \c raylib_libretro_vfs_alt_load_file_data, so the file is read on demand
+ * instead of being decompressed whole. Requires the read, seek and close hooks.
+ *
+ * @param path The path to open.
+ * @param size Out parameter set to the file size in bytes.
+ * @return An opaque file pointer, or \c NULL if the file was not found in the
+ * alternate filesystem.
+ * @see raylib_libretro_vfs_alt_read
+ * @see raylib_libretro_vfs_alt_seek
+ * @see raylib_libretro_vfs_alt_close
+ */
+static void* (*raylib_libretro_vfs_alt_open)(const char* path, int64_t* size) = NULL;
+
+/**
+ * Reads from a file opened with \c raylib_libretro_vfs_alt_open, at its
+ * current position.
+ *
+ * @return The number of bytes read, or -1 on error.
+ */
+static int64_t (*raylib_libretro_vfs_alt_read)(void* file, void* buffer, uint64_t len) = NULL;
+
+/**
+ * Moves the position of a file opened with \c raylib_libretro_vfs_alt_open.
+ *
+ * @param position The absolute offset to seek to.
+ * @return \c true on success.
+ */
+static bool (*raylib_libretro_vfs_alt_seek)(void* file, int64_t position) = NULL;
+
+/**
+ * Closes a file opened with \c raylib_libretro_vfs_alt_open.
+ */
+static void (*raylib_libretro_vfs_alt_close)(void* file) = NULL;
+
+/**
+ * Optional hook to materialize a file from an alternate filesystem at a real,
+ * persistent path (e.g. an extraction cache for archived content).
+ *
+ * Used for full-path cores that read content with raw stdio and so can't see
+ * virtual paths. The returned file is owned by the hook's cache: callers must
+ * not delete it.
+ *
+ * @param path The virtual path to materialize.
+ * @param outPath Buffer of at least \c RAYLIB_LIBRETRO_VFS_MAX_PATH bytes that
+ * receives the real path.
+ * @return \c true if \c outPath names a complete copy of the file.
+ */
+static bool (*raylib_libretro_vfs_alt_extract)(const char* path, char* outPath) = NULL;
+
+// Totals across every handle, since startup or the last raylib_libretro_vfs_reset_stats().
+// Every instance and thread adds to them, so they're only updated atomically.
+static raylib_libretro_vfs_stats raylib_libretro_vfs_totals = {0};
+
+// JSONL trace of every call, opened by raylib_libretro_vfs_set_trace_file(), or NULL.
+// Lines are written whole, so threads tracing at once don't interleave them.
+static FILE* raylib_libretro_vfs_trace = NULL;
+static retro_time_t raylib_libretro_vfs_trace_start = 0;
+
+// Adds to one of the totals.
+static void raylib_libretro_vfs_atomic_add(uint64_t* target, uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    _InterlockedExchangeAdd64((volatile __int64*)target, (__int64)value);
+#else
+    __atomic_fetch_add(target, value, __ATOMIC_RELAXED);
+#endif
+}
+
+// Raises one of the totals to value, if it's lower.
+static void raylib_libretro_vfs_atomic_max(uint64_t* target, uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    __int64 current = *(volatile __int64*)target;
+    while ((uint64_t)current < value) {
+        __int64 previous = _InterlockedCompareExchange64((volatile __int64*)target, (__int64)value, current);
+        if (previous == current) break;
+        current = previous;
+    }
+#else
+    uint64_t current = __atomic_load_n(target, __ATOMIC_RELAXED);
+    while (current < value && !__atomic_compare_exchange_n(target, &current, value, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+#endif
+}
+
+/**
+ * Records a buffer allocated on behalf of a handle, for the largest allocation counters.
+ *
+ * @param stream The handle the buffer belongs to, or NULL for directory listings.
+ * @param size The number of bytes allocated.
+ */
+static void raylib_libretro_vfs_note_allocation(struct retro_vfs_file_handle* stream, uint64_t size) {
+    if (stream != NULL && size > stream->stats.largestAllocation) {
+        stream->stats.largestAllocation = size;
+    }
+    raylib_libretro_vfs_atomic_max(&raylib_libretro_vfs_totals.largestAllocation, size);
+}
+
+/**
+ * Opens a real file with fopen(), marked close-on-exec so helper processes
+ * spawned while it's open, like the core probe, don't inherit it.
+ *
+ * @param path The file to open.
+ * @param mode The fopen() mode.
+ * @return The file, or NULL if it couldn't be opened.
+ */
+static FILE* raylib_libretro_vfs_fopen(const char* path, const char* mode) {
+    FILE* file = fopen(path, mode);
+#if !defined(_WIN32)
+    if (file != NULL) {
+        fcntl(fileno(file), F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    return file;
+}
+
+/**
+ * Gets the size of a real file in bytes, without the 2 GB limit of raylib's
+ * GetFileLength().
+ *
+ * @param path The file to query.
+ * @return The file size, or -1 if it doesn't exist or isn't a regular file.
+ */
+static int64_t raylib_libretro_vfs_file_size_64(const char* path) {
+#if defined(_WIN32)
+    struct _stat64 info;
+    if (_stat64(path, &info) != 0 || !(info.st_mode & _S_IFREG)) {
+        return -1;
+    }
+#else
+    struct stat info;
+    if (stat(path, &info) != 0 || !S_ISREG(info.st_mode)) {
+        return -1;
+    }
+#endif
+    return (int64_t)info.st_size;
+}
+
+/**
+ * Opens a real file for reading without loading it: maps it into memory where
+ * possible, or falls back to a FILE* that raylib_libretro_vfs_read() streams from.
+ *
+ * @param handle The handle to fill; \c path and \c hints must already be set.
+ * @return true if the file was opened.
+ */
+static bool raylib_libretro_vfs_open_read_only(struct retro_vfs_file_handle* handle) {
+    int64_t size = raylib_libretro_vfs_file_size_64(handle->path);
+    if (size < 0) {
+        return false;
+    }
+    handle->dataSize = size;
+
+    // Empty files have nothing to map or read.
+    if (size == 0) {
+        return true;
+    }
+
+#ifdef RAYLIB_LIBRETRO_VFS_MMAP
+    if ((uint64_t)size <= (uint64_t)SIZE_MAX) {
+        int fd = open(handle->path, O_RDONLY | O_CLOEXEC);
+        if (fd >= 0) {
+            void* mapping = mmap(NULL, (size_t)size, PROT_READ, MAP_PRIVATE, fd, 0);
+            // The mapping holds its own reference to the file.
+            close(fd);
+            if (mapping != MAP_FAILED) {
+                if (handle->hints & RETRO_VFS_FILE_ACCESS_HINT_FREQUENT_ACCESS) {
+                    madvise(mapping, (size_t)size, MADV_WILLNEED);
+                }
+                handle->mapping = (unsigned char*)mapping;
+                return true;
+            }
+        }
+    }
+#endif
+
+    handle->file = raylib_libretro_vfs_fopen(handle->path, "rb");
+    handle->filePosition = 0;
+    return handle->file != NULL;
+}
+
+/**
+ * Opens a real file for writing, without reading its contents.
+ *
+ * @param handle The handle to fill; \c path and \c mode must already be set.
+ * @return true if the file was opened.
+ */
+static bool raylib_libretro_vfs_open_writable(struct retro_vfs_file_handle* handle) {
+    // Read/write handles and UPDATE_EXISTING keep what's in the file. Read/write
+    // requires the file to exist; UPDATE_EXISTING creates it if it doesn't.
+    bool keep = (handle->mode & (RETRO_VFS_FILE_ACCESS_READ | RETRO_VFS_FILE_ACCESS_UPDATE_EXISTING)) != 0;
+    if (keep) {
+        handle->file = raylib_libretro_vfs_fopen(handle->path, "r+b");
+        if (handle->file == NULL && (handle->mode & RETRO_VFS_FILE_ACCESS_READ)) {
+            return false;
+        }
+    }
+    if (handle->file == NULL) {
+        handle->file = raylib_libretro_vfs_fopen(handle->path, "w+b");
+    }
+    if (handle->file == NULL) {
+        return false;
+    }
+
+    int64_t size = raylib_libretro_vfs_file_size_64(handle->path);
+    handle->dataSize = (size > 0) ? size : 0;
+    handle->filePosition = 0;
+    return true;
+}
+
+/**
+ * Writes bytes to the handle's file at the given offset.
+ *
+ * @return true if every byte was written.
+ */
+static bool raylib_libretro_vfs_write_at(struct retro_vfs_file_handle* stream, const void* data, size_t size, int64_t offset) {
+    // Always seek: C requires a positioning call between a read and a write on
+    // the same FILE*. Writing past the end zero-fills the gap.
+    if (RAYLIB_LIBRETRO_VFS_FSEEK(stream->file, offset, SEEK_SET) != 0) {
+        stream->filePosition = -1;
+        return false;
+    }
+    size_t written = fwrite(data, 1, size, stream->file);
+    // Force the next read to seek too.
+    stream->filePosition = -1;
+    return written == size;
+}
+
+/**
+ * Writes the dirty range of the handle's write-back buffer to its file.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int raylib_libretro_vfs_flush_buffer(struct retro_vfs_file_handle* stream) {
+    if (stream->file == NULL || stream->bufferLength == 0) {
+        return 0;
+    }
+    bool ok = raylib_libretro_vfs_write_at(stream, stream->buffer, stream->bufferLength, stream->bufferOffset);
+    stream->bufferLength = 0;
+    return ok ? 0 : -1;
+}
+
+/**
+ * Ensures an in-memory handle can hold at least \c size bytes, growing its
+ * allocation geometrically so a run of small appends is amortized O(1).
+ *
+ * @return true if \c data has room for \c size bytes.
+ */
+static bool raylib_libretro_vfs_reserve(struct retro_vfs_file_handle* stream, int64_t size) {
+    if ((uint64_t)size <= (uint64_t)stream->dataCapacity) {
+        return true;
+    }
+    if ((uint64_t)size > (uint64_t)UINT_MAX) {
+        return false;
+    }
+
+    uint64_t capacity = (stream->dataCapacity > 0) ? (uint64_t)stream->dataCapacity : 4096;
+    while (capacity < (uint64_t)size) {
+        capacity *= 2;
+    }
+    if (capacity > (uint64_t)UINT_MAX) {
+        capacity = (uint64_t)size;
+    }
+
+    unsigned char* resized = (unsigned char*)MemRealloc(stream->data, (unsigned int)capacity);
+    if (resized == NULL) {
+        return false;
+    }
+    raylib_libretro_vfs_note_allocation(stream, capacity);
+    stream->data = resized;
+    stream->dataCapacity = (size_t)capacity;
+    return true;
+}
+
 /**
  * Gets the path associated with the given file handle.
  *
@@ -188,26 +599,56 @@ static struct retro_vfs_file_handle* raylib_libretro_vfs_open(const char* path,
     handle->position = 0;
     handle->dataSize = 0;
     handle->data = NULL;
+    handle->mapping = NULL;
+    handle->file = NULL;
+    handle->filePosition = 0;
+    handle->buffer = NULL;
+    handle->bufferOffset = 0;
+    handle->bufferLength = 0;
+    handle->dataCapacity = 0;
+    handle->dirty = false;
+    handle->altFile = NULL;
+    handle->altPosition = 0;
+    memset(&handle->stats, 0, sizeof(handle->stats));
 
     if (mode & RETRO_VFS_FILE_ACCESS_READ) {
+        // Stream read-only files from the alternate filesystem, so a core that
+        // only reads a header doesn't pay for decompressing the whole entry.
+        if (!(mode & RETRO_VFS_FILE_ACCESS_WRITE) && raylib_libretro_vfs_alt_open != NULL &&
+                raylib_libretro_vfs_alt_read != NULL && raylib_libretro_vfs_alt_seek != NULL && raylib_libretro_vfs_alt_close != NULL) {
+            int64_t altSize = 0;
+            handle->altFile = raylib_libretro_vfs_alt_open(path, &altSize);
+            if (handle->altFile != NULL) {
+                handle->dataSize = altSize;
+                return handle;
+            }
+        }
+
         if (raylib_libretro_vfs_alt_load_file_data != NULL) {
-            handle->data = raylib_libretro_vfs_alt_load_file_data(path, &handle->dataSize);
+            int64_t altSize = 0;
+            handle->data = raylib_libretro_vfs_alt_load_file_data(path, &altSize);
+            handle->dataSize = altSize;
+            handle->dataCapacity = (size_t)altSize;
+            raylib_libretro_vfs_note_allocation(handle, (uint64_t)altSize);
         }
-        if (handle->data == NULL) {
-            handle->data = LoadFileData(path, &handle->dataSize);
+
+        // Real files are never read up front: read-only handles are mapped or
+        // streamed, so opening a multi-gigabyte disc image is O(1), and
+        // read/write handles go through the write-back buffer.
+        bool opened = handle->data != NULL;
+        if (!opened) {
+            opened = (mode & RETRO_VFS_FILE_ACCESS_WRITE) ? raylib_libretro_vfs_open_writable(handle) : raylib_libretro_vfs_open_read_only(handle);
         }
-        if (handle->data == NULL) {
+        if (!opened) {
             MemFree(handle);
             TraceLog(LOG_ERROR, "LIBRETRO: File not found: %s", path);
             return NULL;
         }
-    } else if ((mode & RETRO_VFS_FILE_ACCESS_WRITE) && (mode & RETRO_VFS_FILE_ACCESS_UPDATE_EXISTING)) {
-        if (FileExists(path)) {
-            handle->data = LoadFileData(path, &handle->dataSize);
-            if (handle->data == NULL) {
-                MemFree(handle);
-                return NULL;
-            }
+    } else if (mode & RETRO_VFS_FILE_ACCESS_WRITE) {
+        if (!raylib_libretro_vfs_open_writable(handle)) {
+            MemFree(handle);
+            TraceLog(LOG_ERROR, "LIBRETRO: Failed to open file for writing: %s", path);
+            return NULL;
         }
     }
 
@@ -231,15 +672,31 @@ static int raylib_libretro_vfs_close(struct retro_vfs_file_handle* stream) {
         return 0;
     }
 
+    int result = 0;
     if (stream->mode & RETRO_VFS_FILE_ACCESS_WRITE) {
-        raylib_libretro_vfs_flush(stream);
+        result = raylib_libretro_vfs_flush(stream);
+    }
+    if (stream->data != NULL) {
         MemFree(stream->data);
-    } else if (stream->data != NULL) {
-        UnloadFileData(stream->data);
+    }
+    if (stream->buffer != NULL) {
+        MemFree(stream->buffer);
+    }
+
+#ifdef RAYLIB_LIBRETRO_VFS_MMAP
+    if (stream->mapping != NULL) {
+        munmap(stream->mapping, (size_t)stream->dataSize);
+    }
+#endif
+    if (stream->file != NULL && fclose(stream->file) != 0) {
+        result = -1;
+    }
+    if (stream->altFile != NULL && raylib_libretro_vfs_alt_close != NULL) {
+        raylib_libretro_vfs_alt_close(stream->altFile);
     }
 
     MemFree(stream);
-    return 0;
+    return result;
 }
 
 /**
@@ -256,7 +713,7 @@ static int64_t raylib_libretro_vfs_size(struct retro_vfs_file_handle* stream) {
         return -1;
     }
 
-    return (int64_t)stream->dataSize;
+    return stream->dataSize;
 }
 
 /**
@@ -280,13 +737,27 @@ static int64_t raylib_libretro_vfs_truncate(struct retro_vfs_file_handle* stream
         return -1;
     }
 
-    unsigned char* resized = (unsigned char*)MemRealloc(stream->data, (unsigned int)length);
-    if (resized == NULL && length > 0) {
-        return -1;
+    if (stream->file != NULL) {
+        // Pending writes may lie past the new end; land them first so the
+        // truncation cuts them off like it would any other data.
+        if (raylib_libretro_vfs_flush_buffer(stream) != 0 || fflush(stream->file) != 0) {
+            return -1;
+        }
+        if (RAYLIB_LIBRETRO_VFS_FTRUNCATE(stream->file, length) != 0) {
+            return -1;
+        }
+        stream->filePosition = -1;
+    } else {
+        if (!raylib_libretro_vfs_reserve(stream, length)) {
+            return -1;
+        }
+        if (length > stream->dataSize) {
+            memset(stream->data + stream->dataSize, 0, (size_t)(length - stream->dataSize));
+        }
+        stream->dirty = true;
     }
 
-    stream->data = resized;
-    stream->dataSize = (int)length;
+    stream->dataSize = length;
 
     if (stream->position > length) {
         stream->position = length;
@@ -375,7 +846,7 @@ static int64_t raylib_libretro_vfs_seek(struct retro_vfs_file_handle* stream, in
  * @see filestream_read
  */
 static int64_t raylib_libretro_vfs_read(struct retro_vfs_file_handle* stream, void *s, uint64_t len) {
-    if (stream == NULL || s == NULL || stream->data == NULL) {
+    if (stream == NULL || s == NULL || !(stream->mode & RETRO_VFS_FILE_ACCESS_READ)) {
         return -1;
     }
 
@@ -386,7 +857,43 @@ static int64_t raylib_libretro_vfs_read(struct retro_vfs_file_handle* stream, vo
     uint64_t remaining = (uint64_t)(stream->dataSize - stream->position);
     uint64_t bytesRead = (len < remaining) ? len : remaining;
 
-    memcpy(s, stream->data + stream->position, (size_t)bytesRead);
+    if (stream->altFile != NULL) {
+        // Seeks only move position; the alternate file catches up here.
+        if (stream->altPosition != stream->position) {
+            if (!raylib_libretro_vfs_alt_seek(stream->altFile, stream->position)) {
+                stream->altPosition = -1;
+                return -1;
+            }
+            stream->altPosition = stream->position;
+        }
+        int64_t altRead = raylib_libretro_vfs_alt_read(stream->altFile, s, bytesRead);
+        if (altRead < 0) {
+            stream->altPosition = -1;
+            return -1;
+        }
+        bytesRead = (uint64_t)altRead;
+        stream->altPosition += altRead;
+    } else if (stream->file != NULL) {
+        // Read/write handles: pending writes must be visible to the read.
+        if (raylib_libretro_vfs_flush_buffer(stream) != 0) {
+            return -1;
+        }
+        if (stream->filePosition != stream->position) {
+            if (RAYLIB_LIBRETRO_VFS_FSEEK(stream->file, stream->position, SEEK_SET) != 0) {
+                return -1;
+            }
+            stream->filePosition = stream->position;
+        }
+        bytesRead = (uint64_t)fread(s, 1, (size_t)bytesRead, stream->file);
+        stream->filePosition += (int64_t)bytesRead;
+    } else {
+        const unsigned char* source = (stream->mapping != NULL) ? stream->mapping : stream->data;
+        if (source == NULL) {
+            return -1;
+        }
+        memcpy(s, source + stream->position, (size_t)bytesRead);
+    }
+
     stream->position += (int64_t)bytesRead;
     return (int64_t)bytesRead;
 }
@@ -413,22 +920,62 @@ static int64_t raylib_libretro_vfs_write(struct retro_vfs_file_handle* stream, c
     }
 
     int64_t end = stream->position + (int64_t)len;
+
+    // File-backed handles collect writes in a fixed write-back buffer holding
+    // one contiguous dirty range. Writes that extend or overwrite that range
+    // are a memcpy; anything else flushes it and starts a new range, and
+    // writes too large to buffer go straight to the file.
+    if (stream->file != NULL) {
+        int64_t bufferEnd = stream->bufferOffset + (int64_t)stream->bufferLength;
+        bool fits = stream->bufferLength > 0 &&
+            stream->position >= stream->bufferOffset && stream->position <= bufferEnd &&
+            end - stream->bufferOffset <= RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE;
+        if (!fits) {
+            if (raylib_libretro_vfs_flush_buffer(stream) != 0) {
+                return -1;
+            }
+            if (len >= RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE) {
+                if (!raylib_libretro_vfs_write_at(stream, s, (size_t)len, stream->position)) {
+                    return -1;
+                }
+                stream->position = end;
+                if (end > stream->dataSize) stream->dataSize = end;
+                return (int64_t)len;
+            }
+            if (stream->buffer == NULL) {
+                stream->buffer = (unsigned char*)MemAlloc(RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE);
+                if (stream->buffer == NULL) {
+                    return -1;
+                }
+                raylib_libretro_vfs_note_allocation(stream, RAYLIB_LIBRETRO_VFS_WRITE_BUFFER_SIZE);
+            }
+            stream->bufferOffset = stream->position;
+        }
+
+        memcpy(stream->buffer + (stream->position - stream->bufferOffset), s, (size_t)len);
+        if ((size_t)(end - stream->bufferOffset) > stream->bufferLength) {
+            stream->bufferLength = (size_t)(end - stream->bufferOffset);
+        }
+        stream->position = end;
+        if (end > stream->dataSize) stream->dataSize = end;
+        return (int64_t)len;
+    }
+
+    // In-memory handles (files from the alternate filesystem).
     if (end > stream->dataSize) {
-        unsigned char* resized = (unsigned char*)MemRealloc(stream->data, (unsigned int)end);
-        if (resized == NULL) {
+        if (!raylib_libretro_vfs_reserve(stream, end)) {
             return -1;
         }
-        stream->data = resized;
         // Zero-fill any gap left by a seek past the previous end of file,
-        // matching standard fwrite() semantics. Uses the old dataSize, so this
-        // must run before dataSize is updated.
+        // matching standard fwrite() semantics.
         if (stream->position > stream->dataSize) {
             memset(stream->data + stream->dataSize, 0, (size_t)(stream->position - stream->dataSize));
         }
-        stream->dataSize = (int)end;
+        stream->dataSize = end;
     }
 
     memcpy(stream->data + stream->position, s, (size_t)len);
+    stream->dirty = true;
 
     stream->position = end;
     return (int64_t)len;
@@ -450,9 +997,22 @@ static int raylib_libretro_vfs_flush(struct retro_vfs_file_handle* stream) {
         return 0;
     }
 
-    if (!SaveFileData(stream->path, stream->data, stream->dataSize)) {
+    // Only the dirty range is written, so cores that flush after every small
+    // write (memory cards, for example) no longer rewrite the whole file.
+    if (stream->file != NULL) {
+        if (raylib_libretro_vfs_flush_buffer(stream) != 0 || fflush(stream->file) != 0) {
+            return -1;
+        }
+        return 0;
+    }
+
+    if (!stream->dirty) {
+        return 0;
+    }
+    if (!raylib_libretro_vfs_save_file_data(stream->path, stream->data, (uint64_t)stream->dataSize)) {
         return -1;
     }
+    stream->dirty = false;
 
     return 0;
 }
@@ -497,26 +1057,14 @@ static int raylib_libretro_vfs_rename(const char* old_path, const char* new_path
  * @since VFS API v3
  */
 static int raylib_libretro_vfs_stat(const char* path, int32_t *size) {
-    if (raylib_libretro_vfs_alt_stat != NULL) {
-        int result = raylib_libretro_vfs_alt_stat(path, size);
-        if (result != 0) return result;
-    }
-
-    // DirectoryExists must be checked first, because FileExists uses
-    // access() which returns true for directories.
-    if (DirectoryExists(path)) {
-        return RETRO_VFS_STAT_IS_DIRECTORY | RETRO_VFS_STAT_IS_VALID;
-    }
-
-    if (FileExists(path)) {
-        int fileLength = GetFileLength(path);
-        if (size != NULL) {
-            *size = (int32_t)fileLength;
-        }
-        return RETRO_VFS_STAT_IS_VALID;
+    int64_t size64 = 0;
+    int output = raylib_libretro_vfs_stat_64(path, &size64);
+    if (size != NULL) {
+        // Files past 2 GB don't fit; report the largest size that does,
+        // and leave the exact value to raylib_libretro_vfs_stat_64().
+        *size = (size64 > INT32_MAX) ? INT32_MAX : (int32_t)size64;
     }
-
-    return 0;
+    return output;
 }
 
 /**
@@ -534,13 +1082,26 @@ static int raylib_libretro_vfs_stat(const char* path, int32_t *size) {
  * @since VFS API v4
  */
 static int raylib_libretro_vfs_stat_64(const char* path, int64_t *size) {
-    // TODO: raylib doesn't really have an int64 file size type, so we use stat() instead.
-    int32_t size32;
-    int output = raylib_libretro_vfs_stat(path, &size32);
-    if (size != NULL) {
-        *size = (int64_t)size32;
+    if (raylib_libretro_vfs_alt_stat != NULL) {
+        int result = raylib_libretro_vfs_alt_stat(path, size);
+        if (result != 0) return result;
     }
-    return output;
+
+    // DirectoryExists must be checked first, because FileExists uses
+    // access() which returns true for directories.
+    if (DirectoryExists(path)) {
+        return RETRO_VFS_STAT_IS_DIRECTORY | RETRO_VFS_STAT_IS_VALID;
+    }
+
+    if (FileExists(path)) {
+        if (size != NULL) {
+            int64_t fileLength = raylib_libretro_vfs_file_size_64(path);
+            *size = (fileLength > 0) ? fileLength : 0;
+        }
+        return RETRO_VFS_STAT_IS_VALID;
+    }
+
+    return 0;
 }
 
 /**
@@ -565,9 +1126,56 @@ static int raylib_libretro_vfs_mkdir(const char* dir) {
     return -1;
 }
 
+/**
+ * Appends an entry to a directory handle's list.
+ * Matches the \c raylib_libretro_vfs_alt_enumerate callback signature.
+ */
+static void raylib_libretro_vfs_dir_add_entry(void* userData, const char* name, int isDir) {
+    struct retro_vfs_dir_handle* handle = (struct retro_vfs_dir_handle*)userData;
+    size_t nameSize = strlen(name) + 1;
+
+    if (handle->entryCount >= handle->entryCapacity) {
+        int capacity = (handle->entryCapacity > 0) ? handle->entryCapacity * 2 : 64;
+        raylib_libretro_vfs_dir_entry* entries = (raylib_libretro_vfs_dir_entry*)MemRealloc(handle->entries, (unsigned int)(sizeof(raylib_libretro_vfs_dir_entry) * (size_t)capacity));
+        if (entries == NULL) return;
+        handle->entries = entries;
+        handle->entryCapacity = capacity;
+        raylib_libretro_vfs_note_allocation(NULL, sizeof(raylib_libretro_vfs_dir_entry) * (uint64_t)capacity);
+    }
+    if (handle->namesSize + nameSize > handle->namesCapacity) {
+        size_t capacity = (handle->namesCapacity > 0) ? handle->namesCapacity * 2 : 4096;
+        while (capacity < handle->namesSize + nameSize) capacity *= 2;
+        char* names = (char*)MemRealloc(handle->names, (unsigned int)capacity);
+        if (names == NULL) return;
+        handle->names = names;
+        handle->namesCapacity = capacity;
+        raylib_libretro_vfs_note_allocation(NULL, (uint64_t)capacity);
+    }
+
+    memcpy(handle->names + handle->namesSize, name, nameSize);
+    handle->entries[handle->entryCount].nameOffset = handle->namesSize;
+    handle->entries[handle->entryCount].isDir = isDir;
+    handle->namesSize += nameSize;
+    handle->entryCount++;
+}
+
+/**
+ * Copies a FilePathList into a directory handle's list. Entry types are left
+ * unknown, to be resolved only if asked for.
+ */
+static void raylib_libretro_vfs_dir_add_files(struct retro_vfs_dir_handle* handle, FilePathList files) {
+    for (unsigned int i = 0; i < files.count; i++) {
+        raylib_libretro_vfs_dir_add_entry(handle, GetFileName(files.paths[i]), -1);
+    }
+}
+
 /**
  * Opens a handle to a directory so its contents can be inspected.
  *
+ * Real directories are streamed: nothing is listed up front, and entry types
+ * come from readdir() where the platform reports them. Alternate filesystem
+ * directories are enumerated into a compact name list.
+ *
  * @param dir The path to the directory to open.
  * Must be an existing directory.
  * @param include_hidden Whether to include hidden files in the directory listing.
@@ -587,33 +1195,61 @@ static struct retro_vfs_dir_handle* raylib_libretro_vfs_opendir(const char* dir,
         return NULL;
     }
 
-    bool dirFound = false;
-    if (raylib_libretro_vfs_alt_stat != NULL) {
-        int result = raylib_libretro_vfs_alt_stat(dir, NULL);
-        if (result & RETRO_VFS_STAT_IS_DIRECTORY) dirFound = true;
-    }
-    if (!dirFound && !DirectoryExists(dir)) {
-        return NULL;
-    }
-
     struct retro_vfs_dir_handle* handle = (struct retro_vfs_dir_handle*)MemAlloc(sizeof(struct retro_vfs_dir_handle));
     if (handle == NULL) {
         return NULL;
     }
-
+    memset(handle, 0, sizeof(struct retro_vfs_dir_handle));
     TextCopy(handle->path, dir);
     handle->include_hidden = include_hidden;
+    handle->entryIndex = -1;
+
+    // Alternate filesystem first.
+    bool altFound = false;
+    if (raylib_libretro_vfs_alt_enumerate != NULL) {
+        altFound = raylib_libretro_vfs_alt_enumerate(handle->path, raylib_libretro_vfs_dir_add_entry, handle);
+    } else if (raylib_libretro_vfs_alt_load_dir_files != NULL) {
+        FilePathList files = raylib_libretro_vfs_alt_load_dir_files(handle->path);
+        raylib_libretro_vfs_dir_add_files(handle, files);
+        UnloadDirectoryFiles(files);
+        altFound = handle->entryCount > 0;
+    }
+    if (altFound && handle->entryCount > 0) {
+        return handle;
+    }
 
-    handle->directoryFiles.count = 0;
-    if (raylib_libretro_vfs_alt_load_dir_files != NULL) {
-        handle->directoryFiles = raylib_libretro_vfs_alt_load_dir_files(handle->path);
+#ifdef RAYLIB_LIBRETRO_VFS_DIRENT
+    handle->dir = opendir(handle->path);
+    if (handle->dir != NULL) {
+        return handle;
     }
-    if (handle->directoryFiles.count == 0) {
-        handle->directoryFiles = LoadDirectoryFiles(handle->path);
+#else
+    if (DirectoryExists(handle->path)) {
+        FilePathList files = LoadDirectoryFiles(handle->path);
+        raylib_libretro_vfs_dir_add_files(handle, files);
+        UnloadDirectoryFiles(files);
+        return handle;
     }
-    handle->directoryFilesIndex = -1;
+#endif
 
-    return handle;
+    // An empty directory on the alternate filesystem is still a directory.
+    if (altFound) {
+        return handle;
+    }
+
+    raylib_libretro_vfs_closedir(handle);
+    return NULL;
+}
+
+/**
+ * Whether a dirent should be skipped: "." and "..", and hidden files unless
+ * they were asked for.
+ */
+static bool raylib_libretro_vfs_dir_skip(struct retro_vfs_dir_handle* dirstream, const char* name) {
+    if (TextIsEqual(name, ".") || TextIsEqual(name, "..")) {
+        return true;
+    }
+    return !dirstream->include_hidden && name[0] == '.';
 }
 
 /**
@@ -638,25 +1274,38 @@ static bool raylib_libretro_vfs_readdir(struct retro_vfs_dir_handle* dirstream)
         return false;
     }
 
-    bool found = false;
-    while (!found) {
-        if (++dirstream->directoryFilesIndex >= dirstream->directoryFiles.count) {
-            return false;
-        }
-
-        const char* name = GetFileName(dirstream->directoryFiles.paths[dirstream->directoryFilesIndex]);
-        if (TextIsEqual(name, ".") || TextIsEqual(name, "..")) {
-            continue;
+#ifdef RAYLIB_LIBRETRO_VFS_DIRENT
+    if (dirstream->dir != NULL) {
+        struct dirent* entry;
+        while ((entry = readdir((DIR*)dirstream->dir)) != NULL) {
+            if (raylib_libretro_vfs_dir_skip(dirstream, entry->d_name)) {
+                continue;
+            }
+            TextCopy(dirstream->entryName, entry->d_name);
+            dirstream->entryIsDir = -1;
+#if defined(DT_DIR) && defined(DT_UNKNOWN) && defined(DT_LNK)
+            // Symlinks and filesystems that don't fill d_type need a stat().
+            if (entry->d_type == DT_DIR) {
+                dirstream->entryIsDir = 1;
+            } else if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK) {
+                dirstream->entryIsDir = 0;
+            }
+#endif
+            return true;
         }
+        dirstream->entryName[0] = '\0';
+        return false;
+    }
+#endif
 
-        if (!dirstream->include_hidden && name[0] == '.') {
-            continue;
+    while (++dirstream->entryIndex < dirstream->entryCount) {
+        const char* name = dirstream->names + dirstream->entries[dirstream->entryIndex].nameOffset;
+        if (!raylib_libretro_vfs_dir_skip(dirstream, name)) {
+            return true;
         }
-
-        found = true;
     }
-
-    return true;
+    dirstream->entryIndex = dirstream->entryCount;
+    return false;
 }
 
 /**
@@ -678,16 +1327,23 @@ static const char* raylib_libretro_vfs_dirent_get_name(struct retro_vfs_dir_hand
         return NULL;
     }
 
-    if (dirstream->directoryFilesIndex >= dirstream->directoryFiles.count) {
+    if (dirstream->dir != NULL) {
+        return (dirstream->entryName[0] != '\0') ? dirstream->entryName : NULL;
+    }
+
+    if (dirstream->entryIndex < 0 || dirstream->entryIndex >= dirstream->entryCount) {
         return NULL;
     }
 
-    return GetFileName(dirstream->directoryFiles.paths[dirstream->directoryFilesIndex]);
+    return dirstream->names + dirstream->entries[dirstream->entryIndex].nameOffset;
 }
 
 /**
  * Checks whether the current dirent names a directory.
  *
+ * Uses the type reported while listing when there is one, and otherwise stats
+ * the entry once and remembers the answer.
+ *
  * @param dirstream The directory to read from.
  * @return \c true if \c dirstream's current dirent points to a directory,
  * \c false if not or if there was an error.
@@ -695,20 +1351,22 @@ static const char* raylib_libretro_vfs_dirent_get_name(struct retro_vfs_dir_hand
  * @since VFS API v3
  */
 static bool raylib_libretro_vfs_dirent_is_dir(struct retro_vfs_dir_handle* dirstream) {
-    if (dirstream == NULL) {
+    const char* name = raylib_libretro_vfs_dirent_get_name(dirstream);
+    if (name == NULL) {
         return false;
     }
 
-    if (dirstream->directoryFilesIndex < 0 || dirstream->directoryFilesIndex >= dirstream->directoryFiles.count) {
-        return false;
-    }
-
-    const char* entryPath = dirstream->directoryFiles.paths[dirstream->directoryFilesIndex];
-    if (raylib_libretro_vfs_alt_stat != NULL) {
-        int result = raylib_libretro_vfs_alt_stat(entryPath, NULL);
-        if (result & RETRO_VFS_STAT_IS_DIRECTORY) return true;
+    int* isDir = (dirstream->dir != NULL) ? &dirstream->entryIsDir : &dirstream->entries[dirstream->entryIndex].isDir;
+    if (*isDir < 0) {
+        const char* entryPath = TextFormat("%s/%s", dirstream->path, name);
+        *isDir = 0;
+        if (raylib_libretro_vfs_alt_stat != NULL && (raylib_libretro_vfs_alt_stat(entryPath, NULL) & RETRO_VFS_STAT_IS_DIRECTORY)) {
+            *isDir = 1;
+        } else if (DirectoryExists(entryPath)) {
+            *isDir = 1;
+        }
     }
-    return DirectoryExists(entryPath);
+    return *isDir == 1;
 }
 
 /**
@@ -728,11 +1386,548 @@ static int raylib_libretro_vfs_closedir(struct retro_vfs_dir_handle* dirstream)
         return 0;
     }
 
-    UnloadDirectoryFiles(dirstream->directoryFiles);
+#ifdef RAYLIB_LIBRETRO_VFS_DIRENT
+    if (dirstream->dir != NULL) {
+        closedir((DIR*)dirstream->dir);
+    }
+#endif
+    if (dirstream->entries != NULL) {
+        MemFree(dirstream->entries);
+    }
+    if (dirstream->names != NULL) {
+        MemFree(dirstream->names);
+    }
     MemFree(dirstream);
     return 0;
 }
 
+/**
+ * Gets the whole contents of a file handle as one contiguous buffer.
+ *
+ * Mapped and in-memory handles return their data directly. Streamed handles
+ * are read into memory once, in chunks straight into the final buffer, and
+ * then served from it. This suits content that must be handed over in one
+ * piece, such as \c retro_game_info::data.
+ *
+ * @param stream A readable file handle.
+ * @return The file's contents, \c stream->dataSize bytes long and owned by the
+ * handle, or NULL if the file is empty, unreadable or too large to buffer.
+ * @see raylib_libretro_vfs_load_data
+ */
+static const unsigned char* raylib_libretro_vfs_get_data(struct retro_vfs_file_handle* stream) {
+    return raylib_libretro_vfs_load_data(stream, NULL, NULL);
+}
+
+/**
+ * Same as raylib_libretro_vfs_get_data(), with progress and cancellation, so
+ * it can run on a worker thread while another thread watches.
+ *
+ * Only the calling thread may use \c stream until this returns. Sharing the
+ * progress, and the result, with other threads is up to \c progress and the
+ * caller; this does no synchronization of its own.
+ *
+ * @param stream   A readable file handle.
+ * @param progress Optional; called with the number of bytes read so far after
+ *                 each chunk. Reading stops, and NULL is returned, once it
+ *                 returns false.
+ * @param userData Passed to \c progress.
+ * @return The file's contents, or NULL on failure or cancellation.
+ */
+static const unsigned char* raylib_libretro_vfs_load_data(struct retro_vfs_file_handle* stream, bool (*progress)(int64_t loaded, void* userData), void* userData) {
+    if (stream == NULL || !(stream->mode & RETRO_VFS_FILE_ACCESS_READ) || stream->dataSize <= 0) {
+        return NULL;
+    }
+    if (stream->mapping != NULL || (stream->file == NULL && stream->altFile == NULL)) {
+        if (progress != NULL) progress(stream->dataSize, userData);
+        return (stream->mapping != NULL) ? stream->mapping : stream->data;
+    }
+
+    // MemAlloc() takes an unsigned int; anything larger has to stay streamed or mapped.
+    if ((uint64_t)stream->dataSize > (uint64_t)UINT_MAX) {
+        TraceLog(LOG_ERROR, "LIBRETRO: File is too large to load into memory: %s", stream->path);
+        return NULL;
+    }
+    stream->data = (unsigned char*)MemAlloc((unsigned int)stream->dataSize);
+    if (stream->data == NULL) {
+        return NULL;
+    }
+    stream->dataCapacity = (size_t)stream->dataSize;
+    raylib_libretro_vfs_note_allocation(stream, (uint64_t)stream->dataSize);
+
+    int64_t position = stream->position;
+    int64_t total = 0;
+    bool cancelled = false;
+    stream->position = 0;
+    while (total < stream->dataSize && !cancelled) {
+        uint64_t chunk = (uint64_t)(stream->dataSize - total);
+        if (chunk > 1024 * 1024) chunk = 1024 * 1024;
+        int64_t bytes = raylib_libretro_vfs_read(stream, stream->data + total, chunk);
+        if (bytes <= 0) {
+            break;
+        }
+        total += bytes;
+        if (progress != NULL && !progress(total, userData)) {
+            cancelled = true;
+        }
+    }
+    if (total != stream->dataSize || cancelled) {
+        if (!cancelled) {
+            TraceLog(LOG_ERROR, "LIBRETRO: Failed to read %s", stream->path);
+        }
+        MemFree(stream->data);
+        stream->data = NULL;
+        stream->dataCapacity = 0;
+        stream->position = position;
+        return NULL;
+    }
+
+    // Serve everything from memory from now on.
+    if (stream->altFile != NULL) {
+        raylib_libretro_vfs_alt_close(stream->altFile);
+        stream->altFile = NULL;
+    }
+    if (stream->file != NULL) {
+        fclose(stream->file);
+        stream->file = NULL;
+    }
+    stream->position = position;
+    return stream->data;
+}
+
+/**
+ * Writes a buffer to a file, replacing it, without the 2 GB limit of raylib's
+ * SaveFileData().
+ *
+ * @param path The file to write.
+ * @param data The bytes to write.
+ * @param size The number of bytes in \c data.
+ * @return true if every byte was written.
+ */
+static bool raylib_libretro_vfs_save_file_data(const char* path, const void* data, uint64_t size) {
+    FILE* file = raylib_libretro_vfs_fopen(path, "wb");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to open file for writing: %s", path);
+        return false;
+    }
+
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t written = 0;
+    while (written < size) {
+        size_t chunk = (size - written > 16 * 1024 * 1024) ? 16 * 1024 * 1024 : (size_t)(size - written);
+        if (fwrite(bytes + written, 1, chunk, file) != chunk) {
+            break;
+        }
+        written += chunk;
+    }
+    bool ok = fclose(file) == 0 && written == size;
+    if (!ok) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to write file: %s", path);
+    }
+    return ok;
+}
+
+/**
+ * Moves a fully written temporary file over its target, so a crash leaves
+ * either the old file or the new one, never neither.
+ *
+ * rename() replaces the target atomically on POSIX. Windows' rename() won't
+ * replace an existing file, so there the target is removed first, which
+ * leaves a brief window without it.
+ *
+ * @param source The temporary file, removed on success.
+ * @param target The file to replace.
+ * @return true if @p target now holds what @p source held.
+ */
+static bool raylib_libretro_vfs_replace_file(const char* source, const char* target) {
+#if defined(_WIN32)
+    remove(target);
+#endif
+    return rename(source, target) == 0;
+}
+
+/**
+ * Copies the rest of a readable file handle to a real file, a chunk at a time,
+ * so extracting a multi-gigabyte image never holds it in memory.
+ *
+ * @param stream The file handle to copy from, starting at its current position.
+ * @param path The file to write, replacing it.
+ * @return true if the whole file was copied.
+ */
+static bool raylib_libretro_vfs_copy_to_file(struct retro_vfs_file_handle* stream, const char* path) {
+    if (stream == NULL) {
+        return false;
+    }
+    FILE* file = raylib_libretro_vfs_fopen(path, "wb");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to open file for writing: %s", path);
+        return false;
+    }
+
+    const size_t chunkSize = 1024 * 1024;
+    unsigned char* chunk = (unsigned char*)MemAlloc((unsigned int)chunkSize);
+    bool ok = chunk != NULL;
+    while (ok) {
+        int64_t bytes = raylib_libretro_vfs_read(stream, chunk, chunkSize);
+        if (bytes <= 0) {
+            ok = bytes == 0 && stream->position >= stream->dataSize;
+            break;
+        }
+        ok = fwrite(chunk, 1, (size_t)bytes, file) == (size_t)bytes;
+    }
+    if (chunk != NULL) {
+        MemFree(chunk);
+    }
+    if (fclose(file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to write file: %s", path);
+    }
+    return ok;
+}
+
+/**
+ * Gets the name of a counted VFS call, as used in logs and traces.
+ *
+ * @param call The call to name.
+ * @return The call's name, e.g. "read", or "unknown".
+ */
+static const char* raylib_libretro_vfs_call_name(raylib_libretro_vfs_call call) {
+    static const char* names[RAYLIB_LIBRETRO_VFS_CALL_COUNT] = {
+        "open", "close", "size", "tell", "seek", "read", "write", "flush",
+        "truncate", "remove", "rename", "stat", "mkdir", "opendir", "readdir", "closedir"
+    };
+    if ((int)call < 0 || call >= RAYLIB_LIBRETRO_VFS_CALL_COUNT) {
+        return "unknown";
+    }
+    return names[call];
+}
+
+/**
+ * Appends a string to a trace line as a JSON string literal, cut short
+ * rather than overflowing the line.
+ *
+ * @param line The line being built.
+ * @param size The bytes the string may use up to, from the start of the line.
+ * @param length The line's length so far.
+ * @param text The string to append.
+ * @return The line's new length.
+ */
+static size_t raylib_libretro_vfs_trace_string(char* line, size_t size, size_t length, const char* text) {
+    if (length + 3 > size) {
+        return length;
+    }
+    line[length++] = '"';
+    for (const unsigned char* c = (const unsigned char*)text; *c != '\0'; c++) {
+        char escaped[8];
+        size_t escapedLength = 1;
+        escaped[0] = (char)*c;
+        if (*c == '"' || *c == '\\') {
+            escaped[0] = '\\';
+            escaped[1] = (char)*c;
+            escapedLength = 2;
+        } else if (*c < 0x20) {
+            escapedLength = (size_t)snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+        }
+        if (length + escapedLength + 2 > size) {
+            break;
+        }
+        memcpy(line + length, escaped, escapedLength);
+        length += escapedLength;
+    }
+    line[length++] = '"';
+    line[length] = '\0';
+    return length;
+}
+
+/**
+ * Appends formatted text to a trace line, up to the end of the line buffer.
+ *
+ * @return The line's new length.
+ */
+static size_t raylib_libretro_vfs_trace_append(char* line, size_t length, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(line + length, RAYLIB_LIBRETRO_VFS_TRACE_LINE_MAX - length, format, args);
+    va_end(args);
+    if (written < 0) {
+        return length;
+    }
+    length += (size_t)written;
+    return (length < RAYLIB_LIBRETRO_VFS_TRACE_LINE_MAX) ? length : RAYLIB_LIBRETRO_VFS_TRACE_LINE_MAX - 1;
+}
+
+/**
+ * Counts a finished VFS call against the totals and its handle, and traces it.
+ *
+ * @param stream The file handle the call used, or NULL.
+ * @param call The call that was made.
+ * @param path The path the call worked on, for the trace.
+ * @param start When the call started, from cpu_features_get_time_usec().
+ * @param result The call's return value.
+ */
+static void raylib_libretro_vfs_record(struct retro_vfs_file_handle* stream, raylib_libretro_vfs_call call, const char* path, retro_time_t start, int64_t result) {
+    int64_t elapsed = (int64_t)(cpu_features_get_time_usec() - start);
+    uint64_t bytes = (result > 0 && (call == RAYLIB_LIBRETRO_VFS_CALL_READ || call == RAYLIB_LIBRETRO_VFS_CALL_WRITE)) ? (uint64_t)result : 0;
+
+    raylib_libretro_vfs_atomic_add(&raylib_libretro_vfs_totals.calls[call], 1);
+    raylib_libretro_vfs_atomic_add((uint64_t*)&raylib_libretro_vfs_totals.usec[call], (uint64_t)elapsed);
+    if (stream != NULL) {
+        stream->stats.calls[call]++;
+        stream->stats.usec[call] += elapsed;
+    }
+    if (call == RAYLIB_LIBRETRO_VFS_CALL_READ) {
+        raylib_libretro_vfs_atomic_add(&raylib_libretro_vfs_totals.bytesRead, bytes);
+        if (stream != NULL) stream->stats.bytesRead += bytes;
+    } else if (call == RAYLIB_LIBRETRO_VFS_CALL_WRITE) {
+        raylib_libretro_vfs_atomic_add(&raylib_libretro_vfs_totals.bytesWritten, bytes);
+        if (stream != NULL) stream->stats.bytesWritten += bytes;
+    }
+
+    if (raylib_libretro_vfs_trace != NULL) {
+        char line[RAYLIB_LIBRETRO_VFS_TRACE_LINE_MAX];
+        size_t length = raylib_libretro_vfs_trace_append(line, 0, "{\"t\":%lld,\"call\":\"%s\",\"path\":",
+            (long long)(start - raylib_libretro_vfs_trace_start), raylib_libretro_vfs_call_name(call));
+        length = raylib_libretro_vfs_trace_string(line, sizeof(line) - 1024, length, path != NULL ? path : "");
+        length = raylib_libretro_vfs_trace_append(line, length, ",\"us\":%lld,\"result\":%lld}\n", (long long)elapsed, (long long)result);
+        fwrite(line, 1, length, raylib_libretro_vfs_trace);
+    }
+}
+
+/**
+ * Gets the VFS totals across every handle, since startup or the last
+ * raylib_libretro_vfs_reset_stats().
+ *
+ * @return The totals. Look up a call with e.g. \c calls[RAYLIB_LIBRETRO_VFS_CALL_OPEN].
+ */
+static const raylib_libretro_vfs_stats* raylib_libretro_vfs_get_stats(void) {
+    return &raylib_libretro_vfs_totals;
+}
+
+/**
+ * Gets the counters of a single open file handle.
+ *
+ * @param stream The file handle to query.
+ * @return The handle's counters, or NULL if \c stream is NULL.
+ */
+static const raylib_libretro_vfs_stats* raylib_libretro_vfs_get_file_stats(struct retro_vfs_file_handle* stream) {
+    return (stream != NULL) ? &stream->stats : NULL;
+}
+
+/**
+ * Zeroes the VFS totals, e.g. between benchmark runs. Call it while no core
+ * is running, as it isn't atomic.
+ */
+static void raylib_libretro_vfs_reset_stats(void) {
+    memset(&raylib_libretro_vfs_totals, 0, sizeof(raylib_libretro_vfs_totals));
+}
+
+/**
+ * Logs the VFS totals, one line per call that was made.
+ *
+ * @param logLevel The TraceLog() level to log at, e.g. \c LOG_INFO.
+ */
+static void raylib_libretro_vfs_log_stats(int logLevel) {
+    const raylib_libretro_vfs_stats* totals = &raylib_libretro_vfs_totals;
+    TraceLog(logLevel, "LIBRETRO: VFS: %llu bytes read, %llu bytes written, largest allocation %llu bytes",
+        (unsigned long long)totals->bytesRead, (unsigned long long)totals->bytesWritten,
+        (unsigned long long)totals->largestAllocation);
+    for (int call = 0; call < RAYLIB_LIBRETRO_VFS_CALL_COUNT; call++) {
+        if (totals->calls[call] == 0) {
+            continue;
+        }
+        TraceLog(logLevel, "LIBRETRO: VFS:     %-8s %8llu calls %10.3f ms",
+            raylib_libretro_vfs_call_name((raylib_libretro_vfs_call)call),
+            (unsigned long long)totals->calls[call], (double)totals->usec[call] / 1000.0);
+    }
+}
+
+/**
+ * Starts or stops tracing every VFS call to a JSONL file.
+ *
+ * Each line is one call: \c t (microseconds since tracing started), \c call,
+ * \c path, \c us (time spent in the call) and \c result (its return value).
+ * Closing a file handle also writes a \c handle line with that handle's totals.
+ *
+ * Call it while no core is running, as calls on other threads may be writing
+ * to the trace.
+ *
+ * @param path The file to write, replacing any existing one, or NULL to stop tracing.
+ * @return true if tracing was started or stopped.
+ */
+static bool raylib_libretro_vfs_set_trace_file(const char* path) {
+    if (raylib_libretro_vfs_trace != NULL) {
+        fclose(raylib_libretro_vfs_trace);
+        raylib_libretro_vfs_trace = NULL;
+    }
+    if (path == NULL) {
+        return true;
+    }
+
+    raylib_libretro_vfs_trace = raylib_libretro_vfs_fopen(path, "wb");
+    if (raylib_libretro_vfs_trace == NULL) {
+        TraceLog(LOG_ERROR, "LIBRETRO: Failed to open VFS trace file: %s", path);
+        return false;
+    }
+    raylib_libretro_vfs_trace_start = cpu_features_get_time_usec();
+    TraceLog(LOG_INFO, "LIBRETRO: Tracing VFS calls to %s", path);
+    return true;
+}
+
+/**
+ * Counted versions of the VFS calls, which are what RETRO_ENVIRONMENT_GET_VFS_INTERFACE
+ * hands to cores. Each forwards to the raylib_libretro_vfs_* call of the same name.
+ */
+static struct retro_vfs_file_handle* raylib_libretro_vfs_traced_open(const char* path, unsigned int mode, unsigned int hints) {
+    retro_time_t start = cpu_features_get_time_usec();
+    struct retro_vfs_file_handle* handle = raylib_libretro_vfs_open(path, mode, hints);
+    raylib_libretro_vfs_record(handle, RAYLIB_LIBRETRO_VFS_CALL_OPEN, path, start, (handle != NULL) ? 0 : -1);
+    return handle;
+}
+
+static int raylib_libretro_vfs_traced_close(struct retro_vfs_file_handle* stream) {
+    if (stream == NULL) {
+        return raylib_libretro_vfs_close(stream);
+    }
+
+    // The handle is gone once closed, so keep what the trace needs.
+    raylib_libretro_vfs_stats stats = stream->stats;
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    TextCopy(path, stream->path);
+
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_close(stream);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_CLOSE, path, start, result);
+
+    if (raylib_libretro_vfs_trace != NULL) {
+        char line[RAYLIB_LIBRETRO_VFS_TRACE_LINE_MAX];
+        size_t length = raylib_libretro_vfs_trace_append(line, 0, "{\"handle\":");
+        length = raylib_libretro_vfs_trace_string(line, sizeof(line) - 1024, length, path);
+        for (int call = 0; call < RAYLIB_LIBRETRO_VFS_CALL_COUNT; call++) {
+            if (stats.calls[call] > 0) {
+                length = raylib_libretro_vfs_trace_append(line, length, ",\"%s\":[%llu,%lld]",
+                    raylib_libretro_vfs_call_name((raylib_libretro_vfs_call)call),
+                    (unsigned long long)stats.calls[call], (long long)stats.usec[call]);
+            }
+        }
+        length = raylib_libretro_vfs_trace_append(line, length, ",\"bytesRead\":%llu,\"bytesWritten\":%llu,\"largestAllocation\":%llu}\n",
+            (unsigned long long)stats.bytesRead, (unsigned long long)stats.bytesWritten,
+            (unsigned long long)stats.largestAllocation);
+        fwrite(line, 1, length, raylib_libretro_vfs_trace);
+    }
+    return result;
+}
+
+static int64_t raylib_libretro_vfs_traced_size(struct retro_vfs_file_handle* stream) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int64_t result = raylib_libretro_vfs_size(stream);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_SIZE, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int64_t raylib_libretro_vfs_traced_truncate(struct retro_vfs_file_handle* stream, int64_t length) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int64_t result = raylib_libretro_vfs_truncate(stream, length);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_TRUNCATE, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int64_t raylib_libretro_vfs_traced_tell(struct retro_vfs_file_handle* stream) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int64_t result = raylib_libretro_vfs_tell(stream);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_TELL, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int64_t raylib_libretro_vfs_traced_seek(struct retro_vfs_file_handle* stream, int64_t offset, int seek_position) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int64_t result = raylib_libretro_vfs_seek(stream, offset, seek_position);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_SEEK, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int64_t raylib_libretro_vfs_traced_read(struct retro_vfs_file_handle* stream, void *s, uint64_t len) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int64_t result = raylib_libretro_vfs_read(stream, s, len);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_READ, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int64_t raylib_libretro_vfs_traced_write(struct retro_vfs_file_handle* stream, const void *s, uint64_t len) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int64_t result = raylib_libretro_vfs_write(stream, s, len);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_WRITE, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_flush(struct retro_vfs_file_handle* stream) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_flush(stream);
+    raylib_libretro_vfs_record(stream, RAYLIB_LIBRETRO_VFS_CALL_FLUSH, raylib_libretro_vfs_get_path(stream), start, result);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_remove(const char* path) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_remove(path);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_REMOVE, path, start, result);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_rename(const char* old_path, const char* new_path) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_rename(old_path, new_path);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_RENAME, old_path, start, result);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_stat(const char* path, int32_t *size) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_stat(path, size);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_STAT, path, start, result);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_stat_64(const char* path, int64_t *size) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_stat_64(path, size);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_STAT, path, start, result);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_mkdir(const char* dir) {
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_mkdir(dir);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_MKDIR, dir, start, result);
+    return result;
+}
+
+static struct retro_vfs_dir_handle* raylib_libretro_vfs_traced_opendir(const char* dir, bool include_hidden) {
+    retro_time_t start = cpu_features_get_time_usec();
+    struct retro_vfs_dir_handle* handle = raylib_libretro_vfs_opendir(dir, include_hidden);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_OPENDIR, dir, start, (handle != NULL) ? 0 : -1);
+    return handle;
+}
+
+static bool raylib_libretro_vfs_traced_readdir(struct retro_vfs_dir_handle* dirstream) {
+    retro_time_t start = cpu_features_get_time_usec();
+    bool result = raylib_libretro_vfs_readdir(dirstream);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_READDIR, (dirstream != NULL) ? dirstream->path : NULL, start, result ? 1 : 0);
+    return result;
+}
+
+static int raylib_libretro_vfs_traced_closedir(struct retro_vfs_dir_handle* dirstream) {
+    char path[RAYLIB_LIBRETRO_VFS_MAX_PATH] = { 0 };
+    if (dirstream != NULL) {
+        TextCopy(path, dirstream->path);
+    }
+
+    retro_time_t start = cpu_features_get_time_usec();
+    int result = raylib_libretro_vfs_closedir(dirstream);
+    raylib_libretro_vfs_record(NULL, RAYLIB_LIBRETRO_VFS_CALL_CLOSEDIR, path, start, result);
+    return result;
+}
+
 #if defined(__cplusplus)
 }
 #endif
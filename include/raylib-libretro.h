@@ -42,6 +42,18 @@
 
 #include "libretro.h"
 
+/**
+ * A hardware frame being read back from the GPU, see BeginLibretroFrameReadback().
+ */
+typedef struct LibretroFrameReadback {
+    unsigned int buffer;    // GL pixel pack buffer the frame is copied into, 0 when idle
+    void* fence;            // GLsync signaled once the copy has landed in buffer
+    int width;
+    int height;
+    int displayWidth;       // as reported by LoadImageFromLibretroEx()
+    int rotation;
+} LibretroFrameReadback;
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -75,12 +87,18 @@ static int GetLibretroRotation(void);
 static Texture2D GetLibretroTexture(void);
 static bool ResetLibretroVideo(void);
 static Image LoadImageFromLibretro();
+static Image LoadImageFromLibretroEx(int* displayWidth, int* rotation); // Capture the frame without scaling/rotating it; see FinishLibretroImage().
+static void FinishLibretroImage(Image* image, int displayWidth, int rotation); // Apply the aspect-ratio scale and rotation to a captured frame.
+static bool BeginLibretroFrameReadback(LibretroFrameReadback* readback); // Start reading a hardware frame back from the GPU without waiting for it.
+static bool PollLibretroFrameReadback(LibretroFrameReadback* readback, bool wait, Image* image, int* displayWidth, int* rotation); // Collect a frame started with BeginLibretroFrameReadback().
 static bool IsLibretroGameRequired(void);
 static bool ResetLibretro(void);
 static bool SetLibretroCheat(unsigned index, bool enabled, const char* code);
 static bool ResetLibretroCheats(void);
 static void UnloadLibretroGame(void);
 static void CloseLibretro(void);
+static void SetLibretroCorePool(int size, const char* whitelist);
+static void UnloadLibretroCorePool(void);
 static void SetLibretroVolume(float volume);
 static float GetLibretroVolume(void);
 static void SetLibretroSpeed(float speed);
@@ -90,14 +108,19 @@ static const char* GetLibretroCoreOption(const char* key);
 static bool ResetLibretroCoreOption(const char* key);
 static void ResetAllLibretroCoreOptions(void);
 static void* GetLibretroSerializedData(unsigned int* size);
+static void* GetLibretroSerializedDataEx(unsigned int* size, enum retro_savestate_context context);
 static unsigned int GetLibretroSerializedSize(void);
+static unsigned int GetLibretroSerializedSizeEx(enum retro_savestate_context context);
 static bool SetLibretroSerializedData(void* data, unsigned int size);
+static bool SetLibretroSerializedDataEx(void* data, unsigned int size, enum retro_savestate_context context);
 static void* GetLibretroSRAMData(size_t* size);
 static bool SetLibretroSRAMData(const void* data, size_t size);
+static uint64_t GetLibretroDataHash(const void* data, size_t size);
 static void SetLibretroMessage(const char* msg, double duration);
 static void SetLibretroMessageEx(const struct retro_message_ext *message);
 static bool DrawLibretroMessage(void);
 static const char* GetLibretroDirectory(int directory);
+static const char* GetLibretroCacheDirectory(void);
 static const struct retro_input_descriptor* GetLibretroInputDescriptors(unsigned *count);
 static const struct retro_controller_info* GetLibretroControllerInfo(unsigned *count);
 static const struct retro_subsystem_info* GetLibretroSubsystemInfo(unsigned *count);
@@ -108,8 +131,10 @@ static const char* GetLibretroValidExtensions(void);
 static bool IsLibretroBlockExtract(void);
 static bool GetLibretroNeedFullpath(const char* path, bool* persistent);
 static void GetLibretroFileExtensionPattern(const char* exts, char* pattern, size_t patternSize);
-static bool LoadLibretroGameFromMemoryEx(unsigned char* fileData, int dataSize,
+static bool LoadLibretroGameFromMemoryEx(unsigned char* fileData, size_t dataSize,
     const char* contentPath, bool persistent);
+static bool LoadLibretroGameFromVFS(const char* path, bool persistent);
+static bool LoadLibretroGameFromVFSHandle(struct retro_vfs_file_handle* file, const char* path, bool persistent);
 static void SetLibretroDynamicRateControl(bool enabled);
 static bool IsLibretroDynamicRateControlEnabled(void);
 static bool SetLibretroPortDevice(unsigned port, unsigned device);
@@ -143,6 +168,16 @@ static int LibretroMapRetroLogLevelToTraceLogType(int level);
 
 #include "raylib-libretro-vfs.h"
 
+// Phase profiling compiles out unless RAYLIB_LIBRETRO_PROFILE is defined.
+#ifdef RAYLIB_LIBRETRO_PROFILE
+#include "raylib-libretro-profile.h"
+#elif !defined(RAYLIB_LIBRETRO_PROFILE_H__)
+#define BeginLibretroProfile(name) ((void)0)
+#define EndLibretroProfile() ((void)0)
+#define LogLibretroProfile(logLevel) ((void)0)
+static inline bool SaveLibretroProfileTrace(const char* fileName) { (void)fileName; return false; }
+#endif
+
 #ifdef RAYLIB_LIBRETRO_IMPLEMENTATION
 #ifndef RAYLIB_LIBRETRO_IMPLEMENTATION_ONCE
 #define RAYLIB_LIBRETRO_IMPLEMENTATION_ONCE
@@ -152,6 +187,13 @@ static int LibretroMapRetroLogLevelToTraceLogType(int level);
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#if defined(_WIN32)
+#include <process.h>    // _getpid()
+#else
+#include <unistd.h>     // getpid()
+#include <signal.h>     // kill()
+#include <errno.h>
+#endif
 
 #include "rlgl.h"
 
@@ -161,6 +203,10 @@ static int LibretroMapRetroLogLevelToTraceLogType(int level);
 
 #define RAYLIB_LIBRETRO_VFS_IMPLEMENTATION
 #include "raylib-libretro-vfs.h"
+#ifdef RAYLIB_LIBRETRO_PROFILE
+#define RAYLIB_LIBRETRO_PROFILE_IMPLEMENTATION
+#include "raylib-libretro-profile.h"
+#endif
 
 // Audio ring buffer size in stereo frames
 #define LIBRETRO_AUDIO_RING_BUFFER_SIZE 8192
@@ -170,13 +216,11 @@ static int LibretroMapRetroLogLevelToTraceLogType(int level);
 #define LIBRETRO_MAX_CONTENT_INFO_OVERRIDES 16
 #define LIBRETRO_CONTENT_INFO_OVERRIDE_EXTS_LEN 256
 
-// Core options/variables storage limits
-#define LIBRETRO_MAX_CORE_VARIABLES      512
-#define LIBRETRO_CORE_VARIABLE_KEY_LEN   512
+// Core options/variables parsing limits. Registered options themselves are
+// only limited by memory.
 #define LIBRETRO_CORE_VARIABLE_VALUE_LEN 512
 #define LIBRETRO_CORE_VARIABLE_LABEL_LEN 512
 #define LIBRETRO_CORE_VARIABLE_VALUES_LEN 512
-#define LIBRETRO_CORE_VARIABLE_TOOLTIP_LEN 256
 #define LIBRETRO_MAX_CORE_CATEGORIES     64
 #define LIBRETRO_MAX_PERF_COUNTERS       1024
 #define LIBRETRO_CORE_CATEGORY_KEY_LEN   64
@@ -240,6 +284,60 @@ typedef struct LibretroCoreSymbols {
     size_t (*retro_get_memory_size)(unsigned);
 } LibretroCoreSymbols;
 
+#ifndef LIBRETRO_CORE_POOL_MAX
+/**
+ * Most cores SetLibretroCorePool() can keep loaded at once.
+ */
+#define LIBRETRO_CORE_POOL_MAX 8
+#endif
+
+/**
+ * A closed core whose dylib is kept open, with its symbols already resolved,
+ * so loading it again only needs retro_init().
+ */
+typedef struct LibretroCorePoolEntry {
+    char corePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char libraryName[200];
+    LibretroCoreSymbols symbols;
+    unsigned lastUsed; /** Value of corePoolClock when the core was last closed. */
+} LibretroCorePoolEntry;
+
+/**
+ * A block of interned strings, with its size bytes of storage right after it.
+ */
+typedef struct LibretroStringArenaBlock {
+    struct LibretroStringArenaBlock* next;
+    size_t used;
+    size_t size;
+} LibretroStringArenaBlock;
+
+/**
+ * Append-only store of unique strings. Each distinct string is kept once, and
+ * stays at the same address until the arena is unloaded.
+ */
+typedef struct LibretroStringArena {
+    LibretroStringArenaBlock* blocks;   // newest first
+    const char** table;                 // open-addressing set of the stored strings
+    unsigned tableSize;                 // power of two, or 0 before the first string
+    unsigned count;
+} LibretroStringArena;
+
+/**
+ * A core option, as registered through SET_VARIABLES or SET_CORE_OPTIONS. All
+ * strings are interned in LibretroCoreData::variableStrings and never NULL.
+ */
+typedef struct LibretroCoreVariable {
+    const char* key;
+    const char* value;
+    const char* defaultValue;
+    const char* label;
+    const char* valuesList;     // pipe-separated values
+    const char* displayList;    // pipe-separated labels for valuesList
+    const char* tooltip;
+    const char* categoryKey;    // empty when uncategorized
+    bool visible;
+} LibretroCoreVariable;
+
 /**
  * Dynamic library symbols for a libretro core.
  */
@@ -263,7 +361,9 @@ typedef struct LibretroCoreData {
     enum retro_pixel_format pixelFormat;
     unsigned performanceLevel;
     bool loaded;
+    bool initialized; /** retro_init() was called, so retro_deinit() is owed on close. */
     uint64_t serializationQuirks; /** Bitmask from RETRO_ENVIRONMENT_SET_SERIALIZATION_QUIRKS. */
+    enum retro_savestate_context savestateContext; /** Reported by RETRO_ENVIRONMENT_GET_SAVESTATE_CONTEXT while (un)serializing. */
 
     struct retro_perf_counter** perf_counters;
     unsigned perf_counter_count;
@@ -311,18 +411,13 @@ typedef struct LibretroCoreData {
     struct retro_subsystem_info *subsystemInfo;
     unsigned subsystemCount;
 
-    // Core variables/options
-    // TODO: Switch these to MemAlloc'ed strings.
-    char variableKeys[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_KEY_LEN];
-    char variableValues[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_VALUE_LEN];
-    char variableDefaults[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_VALUE_LEN];
-    char variableLabels[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_LABEL_LEN];
-    char variableValuesList[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_VALUES_LEN];
-    char variableDisplayList[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_VALUES_LEN];
-    char variableTooltips[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_VARIABLE_TOOLTIP_LEN];
-    char variableCategoryKeys[LIBRETRO_MAX_CORE_VARIABLES][LIBRETRO_CORE_CATEGORY_KEY_LEN];
-    bool variableVisible[LIBRETRO_MAX_CORE_VARIABLES];
+    // Core variables/options, in registration order.
+    LibretroCoreVariable* variables;
     unsigned variableCount;
+    unsigned variableCapacity;
+    unsigned* variableIndex;        // open-addressing hash of key to variables slot + 1, 0 when empty
+    unsigned variableIndexSize;     // power of two
+    LibretroStringArena variableStrings;
     char categoryKeys[LIBRETRO_MAX_CORE_CATEGORIES][LIBRETRO_CORE_CATEGORY_KEY_LEN];
     char categoryLabels[LIBRETRO_MAX_CORE_CATEGORIES][LIBRETRO_CORE_VARIABLE_LABEL_LEN];
     unsigned categoryCount;
@@ -347,6 +442,10 @@ typedef struct LibretroCoreData {
     // Temp file written for needFullpath cores when loading from memory (empty if none).
     char tempGamePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
 
+    // Extraction cache file backing archived content for needFullpath cores
+    // (empty if none). Owned by the cache, so it is kept on unload.
+    char cachedGamePath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+
     // Backing storage and struct for RETRO_ENVIRONMENT_GET_GAME_INFO_EXT.
     // Pointers in gameInfoExt reference these buffers (or are NULL).
     char contentDir[RAYLIB_LIBRETRO_VFS_MAX_PATH];
@@ -367,7 +466,9 @@ typedef struct LibretroCoreData {
 
     // Persistent ROM buffer kept alive when an override sets persistent_data=true.
     unsigned char* persistentGameData;
-    int persistentGameDataSize;
+    size_t persistentGameDataSize;
+    // Or, for content loaded by LoadLibretroGameFromVFS(), the handle that owns it.
+    struct retro_vfs_file_handle* persistentGameFile;
 
     // Virtual joypad state injected by touch controls (port 0 only).
     bool virtualJoypadState[16];
@@ -414,6 +515,7 @@ typedef struct LibretroData {
     char systemDirectory[RAYLIB_LIBRETRO_VFS_MAX_PATH];
     char playlistsDirectory[RAYLIB_LIBRETRO_VFS_MAX_PATH];
     char fileBrowserStartDirectory[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    char cacheDirectory[RAYLIB_LIBRETRO_VFS_MAX_PATH];  // empty for the platform's cache directory
 
     /**
      * The username for the libretro cores.
@@ -432,6 +534,30 @@ typedef struct LibretroData {
     double osdEndTime;
     struct retro_message_ext osd;
 
+    // Option strings of the last closed core. A menu built for that core may
+    // still draw its labels in the frame the core closes, so they're freed
+    // when the next core closes instead.
+    LibretroStringArena retiredVariableStrings;
+
+    // Closed cores kept loaded for quick switching (see SetLibretroCorePool()).
+    // corePoolSize 0 disables the pool. corePoolWhitelist is a "|"-separated
+    // list of library names known to survive retro_deinit()/retro_init() in
+    // the same process, or "*" for any core.
+    LibretroCorePoolEntry corePool[LIBRETRO_CORE_POOL_MAX];
+    int corePoolCount;
+    int corePoolSize;
+    unsigned corePoolClock;
+    char corePoolWhitelist[512];
+
+    // Headless instances (see LoadLibretroInstance()) never touch the window,
+    // GL or audio device: frames stay in core.frameBuffer in the core's pixel
+    // format, and audio is dropped.
+    bool headless;
+
+    // Replaces keyboard/gamepad/mouse input when set, e.g. for scripted runs.
+    // GetLibretroInstance() tells which instance is asking.
+    int16_t (*inputState)(unsigned port, unsigned device, unsigned index, unsigned id);
+
     // Per-core state (reset with memset(0) on core unload).
     LibretroCoreData core;
 
@@ -442,57 +568,263 @@ extern "C" {
 #endif
 
 /**
- * The global libretro core object.
+ * A libretro frontend instance: its settings plus the state of its core.
+ *
+ * @see LoadLibretroInstance()
+ */
+typedef LibretroData LibretroInstance;
+
+#ifndef LIBRETRO_THREAD_LOCAL
+#if defined(__cplusplus)
+#define LIBRETRO_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define LIBRETRO_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define LIBRETRO_THREAD_LOCAL __thread
+#else
+#define LIBRETRO_THREAD_LOCAL _Thread_local
+#endif
+#endif
+
+/**
+ * Settings a new instance starts with.
+ */
+#define LIBRETRO_INSTANCE_DEFAULTS { \
+    .volume = 1.0f, \
+    .speed = 1.0f, \
+    .username = "raylib", \
+    .keyboardPlayer1 = { \
+        [RETRO_DEVICE_ID_JOYPAD_B]      = KEY_Z, \
+        [RETRO_DEVICE_ID_JOYPAD_Y]      = KEY_A, \
+        [RETRO_DEVICE_ID_JOYPAD_SELECT] = KEY_RIGHT_SHIFT, \
+        [RETRO_DEVICE_ID_JOYPAD_START]  = KEY_ENTER, \
+        [RETRO_DEVICE_ID_JOYPAD_UP]     = KEY_UP, \
+        [RETRO_DEVICE_ID_JOYPAD_DOWN]   = KEY_DOWN, \
+        [RETRO_DEVICE_ID_JOYPAD_LEFT]   = KEY_LEFT, \
+        [RETRO_DEVICE_ID_JOYPAD_RIGHT]  = KEY_RIGHT, \
+        [RETRO_DEVICE_ID_JOYPAD_A]      = KEY_X, \
+        [RETRO_DEVICE_ID_JOYPAD_X]      = KEY_S, \
+        [RETRO_DEVICE_ID_JOYPAD_L]      = KEY_Q, \
+        [RETRO_DEVICE_ID_JOYPAD_R]      = KEY_W, \
+        [RETRO_DEVICE_ID_JOYPAD_L2]     = KEY_E, \
+        [RETRO_DEVICE_ID_JOYPAD_R2]     = KEY_R, \
+        [RETRO_DEVICE_ID_JOYPAD_L3]     = KEY_D, \
+        [RETRO_DEVICE_ID_JOYPAD_R3]     = KEY_F, \
+    } \
+}
+
+/**
+ * The instance the API functions use when no other one is current.
+ */
+static LibretroData LibretroDefaultInstance = LIBRETRO_INSTANCE_DEFAULTS;
+
+/**
+ * The instance the API functions and core callbacks of this thread act on.
+ * Callbacks run on the thread that called into the core, so they reach the
+ * instance that called it. Threads start on the default instance.
+ */
+static LIBRETRO_THREAD_LOCAL LibretroData* LibretroCurrentInstance = &LibretroDefaultInstance;
+
+/**
+ * The current libretro instance.
+ *
+ * @see SetLibretroInstance()
+ */
+#define LIBRETRO (*LibretroCurrentInstance)
+
+static LibretroInstance* LoadLibretroInstance(bool headless);
+static void UnloadLibretroInstance(LibretroInstance* instance);
+static LibretroInstance* SetLibretroInstance(LibretroInstance* instance);
+static LibretroInstance* GetLibretroInstance(void);
+static bool InitLibretroInstance(LibretroInstance* instance, const char* core);
+static bool LoadLibretroInstanceGame(LibretroInstance* instance, const char* gameFile);
+static void UpdateLibretroInstance(LibretroInstance* instance);
+static void CloseLibretroInstance(LibretroInstance* instance);
+static const void* GetLibretroFrameData(size_t* size);
+
+/**
+ * Get the stored copy of a string, adding it to the arena if it's new.
+ *
+ * @return The interned string, or NULL when out of memory.
+ */
+static const char* LibretroInternString(LibretroStringArena* arena, const char* str) {
+    if (str == NULL) str = "";
+    size_t length = strlen(str);
+    uint64_t hash = GetLibretroDataHash(str, length);
+
+    if (arena->tableSize > 0) {
+        unsigned mask = arena->tableSize - 1;
+        for (unsigned i = (unsigned)hash & mask; arena->table[i] != NULL; i = (i + 1) & mask) {
+            if (strcmp(arena->table[i], str) == 0) {
+                return arena->table[i];
+            }
+        }
+    }
+
+    // Keep the set at most half full.
+    if ((arena->count + 1) * 2 > arena->tableSize) {
+        unsigned newSize = arena->tableSize ? arena->tableSize * 2 : 256;
+        const char** newTable = (const char**)MemAlloc(newSize * sizeof(const char*));
+        if (newTable == NULL) {
+            return NULL;
+        }
+        for (unsigned i = 0; i < arena->tableSize; i++) {
+            const char* entry = arena->table[i];
+            if (entry == NULL) continue;
+            unsigned j = (unsigned)GetLibretroDataHash(entry, strlen(entry)) & (newSize - 1);
+            while (newTable[j] != NULL) j = (j + 1) & (newSize - 1);
+            newTable[j] = entry;
+        }
+        MemFree((void*)arena->table);
+        arena->table = newTable;
+        arena->tableSize = newSize;
+    }
+
+    LibretroStringArenaBlock* block = arena->blocks;
+    if (block == NULL || block->size - block->used < length + 1) {
+        size_t size = length + 1 > 16384 ? length + 1 : 16384;
+        block = (LibretroStringArenaBlock*)MemAlloc((unsigned int)(sizeof(LibretroStringArenaBlock) + size));
+        if (block == NULL) {
+            return NULL;
+        }
+        block->size = size;
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+    char* copy = (char*)(block + 1) + block->used;
+    memcpy(copy, str, length + 1);
+    block->used += length + 1;
+
+    unsigned mask = arena->tableSize - 1;
+    unsigned i = (unsigned)hash & mask;
+    while (arena->table[i] != NULL) i = (i + 1) & mask;
+    arena->table[i] = copy;
+    arena->count++;
+    return copy;
+}
+
+/**
+ * Free every string in the arena.
+ */
+static void UnloadLibretroStringArena(LibretroStringArena* arena) {
+    LibretroStringArenaBlock* block = arena->blocks;
+    while (block != NULL) {
+        LibretroStringArenaBlock* next = block->next;
+        MemFree(block);
+        block = next;
+    }
+    MemFree((void*)arena->table);
+    memset(arena, 0, sizeof(*arena));
+}
+
+/**
+ * Find a registered core option by key, in constant time.
  *
- * TODO: Figure out a way to have LIBRETRO not be a static global?
+ * @return The option, or NULL if the core never registered the key.
  */
-static LibretroData LIBRETRO = {
-    .volume = 1.0f,
-    .speed = 1.0f,
-    .username = "raylib",
-    .keyboardPlayer1 = {
-        [RETRO_DEVICE_ID_JOYPAD_B]      = KEY_Z,
-        [RETRO_DEVICE_ID_JOYPAD_Y]      = KEY_A,
-        [RETRO_DEVICE_ID_JOYPAD_SELECT] = KEY_RIGHT_SHIFT,
-        [RETRO_DEVICE_ID_JOYPAD_START]  = KEY_ENTER,
-        [RETRO_DEVICE_ID_JOYPAD_UP]     = KEY_UP,
-        [RETRO_DEVICE_ID_JOYPAD_DOWN]   = KEY_DOWN,
-        [RETRO_DEVICE_ID_JOYPAD_LEFT]   = KEY_LEFT,
-        [RETRO_DEVICE_ID_JOYPAD_RIGHT]  = KEY_RIGHT,
-        [RETRO_DEVICE_ID_JOYPAD_A]      = KEY_X,
-        [RETRO_DEVICE_ID_JOYPAD_X]      = KEY_S,
-        [RETRO_DEVICE_ID_JOYPAD_L]      = KEY_Q,
-        [RETRO_DEVICE_ID_JOYPAD_R]      = KEY_W,
-        [RETRO_DEVICE_ID_JOYPAD_L2]     = KEY_E,
-        [RETRO_DEVICE_ID_JOYPAD_R2]     = KEY_R,
-        [RETRO_DEVICE_ID_JOYPAD_L3]     = KEY_D,
-        [RETRO_DEVICE_ID_JOYPAD_R3]     = KEY_F,
-    }
-};
+static LibretroCoreVariable* LibretroFindCoreVariable(const char *key) {
+    if (key == NULL || LIBRETRO.core.variableIndexSize == 0) {
+        return NULL;
+    }
+    unsigned mask = LIBRETRO.core.variableIndexSize - 1;
+    unsigned i = (unsigned)GetLibretroDataHash(key, strlen(key)) & mask;
+    for (; LIBRETRO.core.variableIndex[i] != 0; i = (i + 1) & mask) {
+        LibretroCoreVariable* variable = &LIBRETRO.core.variables[LIBRETRO.core.variableIndex[i] - 1];
+        if (strcmp(variable->key, key) == 0) {
+            return variable;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Grow the option array and its key index to hold count options.
+ */
+static bool LibretroReserveCoreVariables(unsigned count) {
+    if (count > LIBRETRO.core.variableCapacity) {
+        unsigned capacity = LIBRETRO.core.variableCapacity ? LIBRETRO.core.variableCapacity * 2 : 64;
+        while (capacity < count) capacity *= 2;
+        LibretroCoreVariable* variables = (LibretroCoreVariable*)MemRealloc(LIBRETRO.core.variables,
+            capacity * sizeof(LibretroCoreVariable));
+        if (variables == NULL) {
+            return false;
+        }
+        LIBRETRO.core.variables = variables;
+        LIBRETRO.core.variableCapacity = capacity;
+    }
+
+    // Keep the index at most half full.
+    if (count * 2 > LIBRETRO.core.variableIndexSize) {
+        unsigned size = LIBRETRO.core.variableIndexSize ? LIBRETRO.core.variableIndexSize : 128;
+        while (count * 2 > size) size *= 2;
+        unsigned* index = (unsigned*)MemAlloc(size * sizeof(unsigned));
+        if (index == NULL) {
+            return false;
+        }
+        for (unsigned n = 0; n < LIBRETRO.core.variableCount; n++) {
+            const char* key = LIBRETRO.core.variables[n].key;
+            unsigned i = (unsigned)GetLibretroDataHash(key, strlen(key)) & (size - 1);
+            while (index[i] != 0) i = (i + 1) & (size - 1);
+            index[i] = n + 1;
+        }
+        MemFree(LIBRETRO.core.variableIndex);
+        LIBRETRO.core.variableIndex = index;
+        LIBRETRO.core.variableIndexSize = size;
+    }
+    return true;
+}
+
+/**
+ * Free the registered core options.
+ */
+static void UnloadLibretroCoreVariables(void) {
+    MemFree(LIBRETRO.core.variables);
+    MemFree(LIBRETRO.core.variableIndex);
+    UnloadLibretroStringArena(&LIBRETRO.retiredVariableStrings);
+    LIBRETRO.retiredVariableStrings = LIBRETRO.core.variableStrings;
+    memset(&LIBRETRO.core.variableStrings, 0, sizeof(LIBRETRO.core.variableStrings));
+    LIBRETRO.core.variables = NULL;
+    LIBRETRO.core.variableIndex = NULL;
+    LIBRETRO.core.variableCount = 0;
+    LIBRETRO.core.variableCapacity = 0;
+    LIBRETRO.core.variableIndexSize = 0;
+}
 
 static void LibretroInitCoreVariable(const char *key, const char *defaultValue,
     const char *label, const char *valuesList, const char *displayList,
     const char *tooltip, const char *categoryKey) {
-    for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        if (TextIsEqual(LIBRETRO.core.variableKeys[i], key)) {
-            return; // Already registered; don't overwrite user-set value.
-        }
+    if (LibretroFindCoreVariable(key) != NULL) {
+        return; // Already registered; don't overwrite user-set value.
     }
-    if (LIBRETRO.core.variableCount >= LIBRETRO_MAX_CORE_VARIABLES) {
-        TraceLog(LOG_WARNING, "LIBRETRO: Core variable limit reached, ignoring: %s", key);
+    if (!LibretroReserveCoreVariables(LIBRETRO.core.variableCount + 1)) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Out of memory for core variable, ignoring: %s", key);
         return;
     }
-    unsigned n = LIBRETRO.core.variableCount;
-    TextCopy(LIBRETRO.core.variableKeys[n],         key);
-    TextCopy(LIBRETRO.core.variableValues[n],       defaultValue  ? defaultValue  : "");
-    TextCopy(LIBRETRO.core.variableDefaults[n],     defaultValue  ? defaultValue  : "");
-    TextCopy(LIBRETRO.core.variableLabels[n],       label         ? label         : "");
-    TextCopy(LIBRETRO.core.variableValuesList[n],   valuesList    ? valuesList    : "");
-    TextCopy(LIBRETRO.core.variableDisplayList[n],  displayList   ? displayList   : "");
-    TextCopy(LIBRETRO.core.variableTooltips[n],     tooltip       ? tooltip       : "");
-    TextCopy(LIBRETRO.core.variableCategoryKeys[n], categoryKey   ? categoryKey   : "");
-    LIBRETRO.core.variableVisible[n] = true;
-    LIBRETRO.core.variableCount++;
+
+    LibretroStringArena* strings = &LIBRETRO.core.variableStrings;
+    LibretroCoreVariable variable;
+    variable.key          = LibretroInternString(strings, key);
+    variable.value        = LibretroInternString(strings, defaultValue);
+    variable.defaultValue = variable.value;
+    variable.label        = LibretroInternString(strings, label);
+    variable.valuesList   = LibretroInternString(strings, valuesList);
+    variable.displayList  = LibretroInternString(strings, displayList);
+    variable.tooltip      = LibretroInternString(strings, tooltip);
+    variable.categoryKey  = LibretroInternString(strings, categoryKey);
+    variable.visible      = true;
+    if (!variable.key || !variable.value || !variable.label || !variable.valuesList ||
+            !variable.displayList || !variable.tooltip || !variable.categoryKey) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Out of memory for core variable, ignoring: %s", key);
+        return;
+    }
+
+    unsigned n = LIBRETRO.core.variableCount++;
+    LIBRETRO.core.variables[n] = variable;
+    unsigned mask = LIBRETRO.core.variableIndexSize - 1;
+    unsigned i = (unsigned)GetLibretroDataHash(variable.key, strlen(variable.key)) & mask;
+    while (LIBRETRO.core.variableIndex[i] != 0) i = (i + 1) & mask;
+    LIBRETRO.core.variableIndex[i] = n + 1;
+
     // A new option appeared: cores that register variables after the menu has
     // been built (e.g. mgba registering GB model options during its deferred
     // setup on first retro_run) need the Core Options section to refresh.
@@ -500,12 +832,8 @@ static void LibretroInitCoreVariable(const char *key, const char *defaultValue,
 }
 
 static const char *LibretroGetCoreVariable(const char *key) {
-    for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        if (TextIsEqual(LIBRETRO.core.variableKeys[i], key)) {
-            return LIBRETRO.core.variableValues[i];
-        }
-    }
-    return NULL;
+    LibretroCoreVariable* variable = LibretroFindCoreVariable(key);
+    return variable ? variable->value : NULL;
 }
 
 /**
@@ -514,14 +842,19 @@ static const char *LibretroGetCoreVariable(const char *key) {
  * @param value New value for the option.
  * @return true if the key was found and the value applied; false if the key is unknown. */
 static bool SetLibretroCoreOption(const char *key, const char *value) {
-    for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        if (TextIsEqual(LIBRETRO.core.variableKeys[i], key)) {
-            snprintf(LIBRETRO.core.variableValues[i], LIBRETRO_CORE_VARIABLE_VALUE_LEN, "%s", value);
-            LIBRETRO.core.variablesDirty = true;
-            return true;
-        }
+    LibretroCoreVariable* variable = LibretroFindCoreVariable(key);
+    if (variable == NULL) {
+        return false;
     }
-    return false;
+    // Values are nearly always one of the option's own tokens, which are
+    // interned already, so switching between them doesn't grow the arena.
+    const char* interned = LibretroInternString(&LIBRETRO.core.variableStrings, value);
+    if (interned == NULL) {
+        return false;
+    }
+    variable->value = interned;
+    LIBRETRO.core.variablesDirty = true;
+    return true;
 }
 
 /**
@@ -537,23 +870,20 @@ static const char *GetLibretroCoreOption(const char *key) {
  * @param key Option key to reset.
  * @return true if the key was found and reset; false if unknown. */
 static bool ResetLibretroCoreOption(const char *key) {
-    for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        if (TextIsEqual(LIBRETRO.core.variableKeys[i], key)) {
-            snprintf(LIBRETRO.core.variableValues[i], LIBRETRO_CORE_VARIABLE_VALUE_LEN,
-                "%s", LIBRETRO.core.variableDefaults[i]);
-            LIBRETRO.core.variablesDirty = true;
-            return true;
-        }
+    LibretroCoreVariable* variable = LibretroFindCoreVariable(key);
+    if (variable == NULL) {
+        return false;
     }
-    return false;
+    variable->value = variable->defaultValue;
+    LIBRETRO.core.variablesDirty = true;
+    return true;
 }
 
 /**
  * Reset all core options to their default values. */
 static void ResetAllLibretroCoreOptions(void) {
     for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-        snprintf(LIBRETRO.core.variableValues[i], LIBRETRO_CORE_VARIABLE_VALUE_LEN,
-            "%s", LIBRETRO.core.variableDefaults[i]);
+        LIBRETRO.core.variables[i].value = LIBRETRO.core.variables[i].defaultValue;
     }
     LIBRETRO.core.variablesDirty = true;
 }
@@ -872,6 +1202,15 @@ static bool InitLibretroVideo(void) {
         return hw_InitLibretroVideo();
     }
 
+    // Headless: no texture, just room for the frame in the core's pixel format.
+    if (LIBRETRO.headless) {
+        size_t bytesPerPixel = (LIBRETRO.core.pixelFormat == RETRO_PIXEL_FORMAT_XRGB8888) ? 4 : 2;
+        LIBRETRO.core.frameBufferSize = (size_t)LIBRETRO.core.width * LIBRETRO.core.height * bytesPerPixel;
+        LIBRETRO.core.frameBuffer = MemAlloc(LIBRETRO.core.frameBufferSize);
+        LIBRETRO.core.textureRebuild = false;
+        return LIBRETRO.core.frameBuffer != NULL;
+    }
+
     // Software path: build an upload texture + conversion buffer.
     Image image = GenImageColor(LIBRETRO.core.width, LIBRETRO.core.height, BLACK);
     if (!IsImageValid(image)) {
@@ -1181,6 +1520,10 @@ static bool CallLibretroEnvironment(unsigned cmd, void * data) {
                 TraceLog(LOG_WARNING, "LIBRETRO: RETRO_ENVIRONMENT_SET_HW_RENDER no data");
                 return false;
             }
+            if (LIBRETRO.headless) {
+                TraceLog(LOG_WARNING, "LIBRETRO: RETRO_ENVIRONMENT_SET_HW_RENDER unavailable without a GL context (headless)");
+                return false;
+            }
             struct retro_hw_render_callback *cb = (struct retro_hw_render_callback *)data;
             // Accept only context types the GL context raylib created can actually serve.
             // We share raylib's single GL context with the core (no second/shared context),
@@ -1628,34 +1971,35 @@ static bool CallLibretroEnvironment(unsigned cmd, void * data) {
             // Populate the full interface up to the version we support, regardless of
             // the requested version.
             vfs_interface->iface = &LIBRETRO.core.vfs_interface;
+            // The traced_* calls count and time each call; see raylib_libretro_vfs_get_stats().
 
             // VFS 1
             vfs_interface->iface->get_path = &raylib_libretro_vfs_get_path;
-            vfs_interface->iface->open = &raylib_libretro_vfs_open;
-            vfs_interface->iface->close = &raylib_libretro_vfs_close;
-            vfs_interface->iface->size = &raylib_libretro_vfs_size;
-            vfs_interface->iface->tell = &raylib_libretro_vfs_tell;
-            vfs_interface->iface->seek = &raylib_libretro_vfs_seek;
-            vfs_interface->iface->read = &raylib_libretro_vfs_read;
-            vfs_interface->iface->write = &raylib_libretro_vfs_write;
-            vfs_interface->iface->flush = &raylib_libretro_vfs_flush;
-            vfs_interface->iface->remove = &raylib_libretro_vfs_remove;
-            vfs_interface->iface->rename = &raylib_libretro_vfs_rename;
+            vfs_interface->iface->open = &raylib_libretro_vfs_traced_open;
+            vfs_interface->iface->close = &raylib_libretro_vfs_traced_close;
+            vfs_interface->iface->size = &raylib_libretro_vfs_traced_size;
+            vfs_interface->iface->tell = &raylib_libretro_vfs_traced_tell;
+            vfs_interface->iface->seek = &raylib_libretro_vfs_traced_seek;
+            vfs_interface->iface->read = &raylib_libretro_vfs_traced_read;
+            vfs_interface->iface->write = &raylib_libretro_vfs_traced_write;
+            vfs_interface->iface->flush = &raylib_libretro_vfs_traced_flush;
+            vfs_interface->iface->remove = &raylib_libretro_vfs_traced_remove;
+            vfs_interface->iface->rename = &raylib_libretro_vfs_traced_rename;
 
             // VFS 2
-            vfs_interface->iface->truncate = &raylib_libretro_vfs_truncate;
+            vfs_interface->iface->truncate = &raylib_libretro_vfs_traced_truncate;
 
             // VFS 3
-            vfs_interface->iface->stat = &raylib_libretro_vfs_stat;
-            vfs_interface->iface->mkdir = &raylib_libretro_vfs_mkdir;
-            vfs_interface->iface->opendir = &raylib_libretro_vfs_opendir;
-            vfs_interface->iface->readdir = &raylib_libretro_vfs_readdir;
+            vfs_interface->iface->stat = &raylib_libretro_vfs_traced_stat;
+            vfs_interface->iface->mkdir = &raylib_libretro_vfs_traced_mkdir;
+            vfs_interface->iface->opendir = &raylib_libretro_vfs_traced_opendir;
+            vfs_interface->iface->readdir = &raylib_libretro_vfs_traced_readdir;
             vfs_interface->iface->dirent_get_name = &raylib_libretro_vfs_dirent_get_name;
             vfs_interface->iface->dirent_is_dir = &raylib_libretro_vfs_dirent_is_dir;
-            vfs_interface->iface->closedir = &raylib_libretro_vfs_closedir;
+            vfs_interface->iface->closedir = &raylib_libretro_vfs_traced_closedir;
 
             // VFS 4
-            vfs_interface->iface->stat_64 = &raylib_libretro_vfs_stat_64;
+            vfs_interface->iface->stat_64 = &raylib_libretro_vfs_traced_stat_64;
 
             // Report the version we actually provide.
             vfs_interface->required_interface_version = supportedVfsVersion;
@@ -1698,7 +2042,8 @@ static bool CallLibretroEnvironment(unsigned cmd, void * data) {
                 TraceLog(LOG_WARNING, "LIBRETRO: RETRO_ENVIRONMENT_GET_TARGET_REFRESH_RATE data missing");
                 return false;
             }
-            *refreshRate = (float)GetMonitorRefreshRate(GetCurrentMonitor());
+            // Headless instances have no monitor; they run at the core's own rate.
+            *refreshRate = LIBRETRO.headless ? (float)LIBRETRO.core.fps : (float)GetMonitorRefreshRate(GetCurrentMonitor());
             TraceLog(LOG_INFO, "LIBRETRO: Monitor Refresh Rate: %i", (int)*refreshRate);
             return true;
         }
@@ -1773,14 +2118,11 @@ static bool CallLibretroEnvironment(unsigned cmd, void * data) {
         case RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY: {
             const struct retro_core_option_display *disp = (const struct retro_core_option_display *)data;
             if (!disp || !disp->key) return false;
-            for (unsigned i = 0; i < LIBRETRO.core.variableCount; i++) {
-                if (TextIsEqual(LIBRETRO.core.variableKeys[i], disp->key)) {
-                    LIBRETRO.core.variableVisible[i] = disp->visible;
-                    LIBRETRO.core.variablesVisibilityDirty = true;
-                    return true;
-                }
-            }
-            return false;
+            LibretroCoreVariable* variable = LibretroFindCoreVariable(disp->key);
+            if (variable == NULL) return false;
+            variable->visible = disp->visible;
+            LIBRETRO.core.variablesVisibilityDirty = true;
+            return true;
         }
 
         case RETRO_ENVIRONMENT_GET_PREFERRED_HW_RENDER: {
@@ -2051,8 +2393,13 @@ static bool CallLibretroEnvironment(unsigned cmd, void * data) {
         }
 
         case RETRO_ENVIRONMENT_GET_SAVESTATE_CONTEXT: {
-            TraceLog(LOG_WARNING, "LIBRETRO: RETRO_ENVIRONMENT_GET_SAVESTATE_CONTEXT not implemented");
-            return false;
+            // Only meaningful inside retro_serialize_size/serialize/unserialize;
+            // outside of those it reads as a normal save.
+            int* context = (int*)data;
+            if (context != NULL) {
+                *context = (int)LIBRETRO.core.savestateContext;
+            }
+            return true;
         }
 
         case RETRO_ENVIRONMENT_GET_HW_RENDER_CONTEXT_NEGOTIATION_INTERFACE_SUPPORT: {
@@ -2590,6 +2937,22 @@ static void LibretroVideoRefresh(const void *data, unsigned width, unsigned heig
         }
     }
 
+    // Headless: keep the frame as is, rows packed together.
+    if (LIBRETRO.headless) {
+        size_t rowBytes = (size_t)width * ((LIBRETRO.core.pixelFormat == RETRO_PIXEL_FORMAT_XRGB8888) ? 4 : 2);
+        if (LIBRETRO.core.frameBuffer == NULL || rowBytes * height > LIBRETRO.core.frameBufferSize) {
+            return;
+        }
+        const uint8_t *src = (const uint8_t *)data;
+        uint8_t *dst = (uint8_t *)LIBRETRO.core.frameBuffer;
+        for (unsigned h = 0; h < height; h++) {
+            memcpy(dst, src, rowBytes);
+            src += pitch;
+            dst += rowBytes;
+        }
+        return;
+    }
+
     if (!IsTextureValid(LIBRETRO.core.texture)) {
         return;
     }
@@ -2641,12 +3004,23 @@ static void LibretroVideoRefresh(const void *data, unsigned width, unsigned heig
 }
 
 static void LibretroInputPoll(void) {
+    if (LIBRETRO.headless) {
+        return;
+    }
+
     // Mouse
     LIBRETRO.core.inputLastMousePosition = LIBRETRO.core.inputMousePosition;
     LIBRETRO.core.inputMousePosition = GetMousePosition();
 }
 
 static int16_t LibretroInputState(unsigned port, unsigned device, unsigned index, unsigned id) {
+    if (LIBRETRO.inputState != NULL) {
+        return LIBRETRO.inputState(port, device, index, id);
+    }
+    if (LIBRETRO.headless) {
+        return 0;
+    }
+
     switch (device) {
         case RETRO_DEVICE_KEYBOARD: {
             int raylibKey = LibretroRetroKeyToKeyboardKey(id);
@@ -2946,6 +3320,12 @@ static void InitLibretroAudio(void) {
         return;
     }
 
+    // The audio device pulls samples on its own thread, which only sees the
+    // default instance, so other instances run without sound.
+    if (LIBRETRO.headless || LibretroCurrentInstance != &LibretroDefaultInstance) {
+        return;
+    }
+
     // Allocate the ring buffer (stereo float samples). At minimum
     // LIBRETRO_AUDIO_RING_BUFFER_SIZE frames; grown to satisfy the core's
     // RETRO_ENVIRONMENT_SET_MINIMUM_AUDIO_LATENCY request if any.
@@ -3033,7 +3413,7 @@ static void SetLibretroGameInfoExt(const void *data, size_t size) {
     LIBRETRO.core.gameInfoExtValid            = true;
 }
 
-static bool LoadLibretroGameFromMemory(const unsigned char *fileData, int dataSize) {
+static bool LoadLibretroGameFromMemory(const unsigned char *fileData, size_t dataSize) {
     if (!IsLibretroReady()) {
         TraceLog(LOG_ERROR, "LIBRETRO: Core is required before loading a game");
         return false;
@@ -3048,7 +3428,7 @@ static bool LoadLibretroGameFromMemory(const unsigned char *fileData, int dataSi
         char tempPath[RAYLIB_LIBRETRO_VFS_MAX_PATH];
         TextCopy(tempPath,
             TextFormat("%s/.raylib-libretro-%d.tmp", GetApplicationDirectory(), GetRandomValue(1, 999999)));
-        if (!SaveFileData(tempPath, fileData, dataSize)) {
+        if (!raylib_libretro_vfs_save_file_data(tempPath, fileData, (uint64_t)dataSize)) {
             TraceLog(LOG_ERROR, "LIBRETRO: Failed to write temp file for needFullPath core");
             return false;
         }
@@ -3066,9 +3446,9 @@ static bool LoadLibretroGameFromMemory(const unsigned char *fileData, int dataSi
     struct retro_game_info info;
     info.path = NULL;
     info.data = fileData;
-    info.size = (size_t)dataSize;
+    info.size = dataSize;
     info.meta = "";
-    SetLibretroGameInfoExt(fileData, (size_t)dataSize);
+    SetLibretroGameInfoExt(fileData, dataSize);
     if (!LIBRETRO.core.symbols.retro_load_game(&info)) {
         TraceLog(LOG_ERROR, "LIBRETRO: Failed to load game data with retro_load_game()");
         LIBRETRO.core.loaded = false;
@@ -3150,7 +3530,7 @@ static bool GetLibretroNeedFullpath(const char *path, bool *persistent) {
  *                    \c true, the buffer is kept alive until retro_deinit().
  * @return \c true on success, \c false on failure.
  */
-static bool LoadLibretroGameFromMemoryEx(unsigned char* fileData, int dataSize, const char* contentPath, bool persistent) {
+static bool LoadLibretroGameFromMemoryEx(unsigned char* fileData, size_t dataSize, const char* contentPath, bool persistent) {
     if (!IsLibretroReady()) {
         TraceLog(LOG_ERROR, "LIBRETRO: Core is required before loading a game");
         return false;
@@ -3168,9 +3548,9 @@ static bool LoadLibretroGameFromMemoryEx(unsigned char* fileData, int dataSize,
     struct retro_game_info info;
     info.path = (contentPath != NULL && contentPath[0] != '\0') ? contentPath : NULL;
     info.data = fileData;
-    info.size = (size_t)dataSize;
+    info.size = dataSize;
     info.meta = "";
-    SetLibretroGameInfoExt(fileData, (size_t)dataSize);
+    SetLibretroGameInfoExt(fileData, dataSize);
     if (!LIBRETRO.core.symbols.retro_load_game(&info)) {
         TraceLog(LOG_ERROR, "LIBRETRO: Failed to load game data with retro_load_game()");
         LIBRETRO.core.loaded = false;
@@ -3191,6 +3571,55 @@ static bool LoadLibretroGameFromMemoryEx(unsigned char* fileData, int dataSize,
     return true;
 }
 
+/**
+ * Load content into the core as a data buffer, read through the VFS.
+ *
+ * Real files are memory-mapped where possible, so even multi-gigabyte images
+ * are not copied; files from the alternate filesystem (e.g. inside a mounted
+ * .zip) are streamed into a single buffer. Sizes are 64-bit throughout.
+ *
+ * @param path       Content path, real or virtual (e.g. "/game/rom.nes").
+ * @param persistent When \c true, the data stays valid until the game is
+ *                   unloaded, as RETRO_ENVIRONMENT_SET_CONTENT_INFO_OVERRIDE's
+ *                   persistent_data requires.
+ * @return \c true on success, \c false on failure.
+ */
+static bool LoadLibretroGameFromVFS(const char* path, bool persistent) {
+    struct retro_vfs_file_handle* file = raylib_libretro_vfs_open(path, RETRO_VFS_FILE_ACCESS_READ, RETRO_VFS_FILE_ACCESS_HINT_FREQUENT_ACCESS);
+    return LoadLibretroGameFromVFSHandle(file, path, persistent);
+}
+
+/**
+ * Load content into the core from an open VFS file handle.
+ *
+ * The handle's data is read in if it hasn't been already, e.g. by
+ * raylib_libretro_vfs_load_data() on a worker thread.
+ *
+ * @param file       A readable handle; ownership passes to this function. May be NULL.
+ * @param path       Content path to report to the core.
+ * @param persistent See LoadLibretroGameFromVFS().
+ * @return \c true on success, \c false on failure.
+ */
+static bool LoadLibretroGameFromVFSHandle(struct retro_vfs_file_handle* file, const char* path, bool persistent) {
+    const unsigned char* gameData = raylib_libretro_vfs_get_data(file);
+    if (gameData == NULL) {
+        TraceLog(LOG_ERROR, "LIBRETRO: Failed to read game data from %s", path);
+        raylib_libretro_vfs_close(file);
+        LIBRETRO.core.loaded = false;
+        return false;
+    }
+
+    // The handle owns the data, so it is passed on as non-persistent and
+    // kept open here instead.
+    bool ok = LoadLibretroGameFromMemoryEx((unsigned char*)gameData, (size_t)file->dataSize, path, false);
+    if (ok && persistent) {
+        LIBRETRO.core.persistentGameFile = file;
+    } else {
+        raylib_libretro_vfs_close(file);
+    }
+    return ok;
+}
+
 /**
  * Get the pipe-separated list of file extensions the core accepts.
  * @return Extension list string (e.g. "nes|fds"), or empty string if not reported.
@@ -3220,20 +3649,98 @@ static const char* LibretroGetTempDirectory(void) {
     return GetWorkingDirectory();
 }
 
+/**
+ * Resolve the directory for caches the frontend can always rebuild, like
+ * extracted archive content and zip indexes. They never go in the save
+ * directory, which holds the player's data and is synced on the web.
+ *
+ * LIBRETRO.cacheDirectory when set, otherwise the platform's cache location:
+ * $XDG_CACHE_HOME or ~/.cache on Linux, ~/Library/Caches on macOS,
+ * %LOCALAPPDATA% on Windows, and the memory-only /tmp on the web. Created
+ * when missing.
+ *
+ * @return The directory, or NULL when there's none to use. Copy it before
+ *         calling again.
+ */
+static const char* GetLibretroCacheDirectory(void) {
+    static char path[RAYLIB_LIBRETRO_VFS_MAX_PATH];
+    if (LIBRETRO.cacheDirectory[0] != '\0') {
+        snprintf(path, sizeof(path), "%s", LIBRETRO.cacheDirectory);
+    } else {
+#if defined(__EMSCRIPTEN__) || defined(PLATFORM_WEB)
+        snprintf(path, sizeof(path), "/tmp/raylib-libretro");
+#elif defined(_WIN32)
+        const char* base = getenv("LOCALAPPDATA");
+        if (base == NULL || base[0] == '\0') return NULL;
+        snprintf(path, sizeof(path), "%s/raylib-libretro/cache", base);
+#elif defined(__APPLE__)
+        const char* home = getenv("HOME");
+        if (home == NULL || home[0] == '\0') return NULL;
+        snprintf(path, sizeof(path), "%s/Library/Caches/raylib-libretro", home);
+#else
+        const char* xdg = getenv("XDG_CACHE_HOME");
+        const char* home = getenv("HOME");
+        if (xdg != NULL && xdg[0] == '/') {
+            snprintf(path, sizeof(path), "%s/raylib-libretro", xdg);
+        } else if (home != NULL && home[0] != '\0') {
+            snprintf(path, sizeof(path), "%s/.cache/raylib-libretro", home);
+        } else {
+            return NULL;
+        }
+#endif
+    }
+    if (!DirectoryExists(path) && MakeDirectory(path) != 0) {
+        TraceLog(LOG_WARNING, "LIBRETRO: Failed to create the cache directory %s", path);
+        return NULL;
+    }
+    return path;
+}
+
+// Temp content files are named ".raylib-libretro-<pid>-...", after the process that wrote them.
+#define LIBRETRO_TEMP_FILE_PREFIX ".raylib-libretro-"
+
+static int LibretroGetProcessId(void) {
+#if defined(_WIN32)
+    return (int)_getpid();
+#else
+    return (int)getpid();
+#endif
+}
+
+// Whether the process that wrote a temp file may still be using it.
+static bool LibretroIsProcessRunning(int pid) {
+#if defined(_WIN32)
+    // Windows refuses to delete a file a running core still has open.
+    (void)pid;
+    return false;
+#else
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+}
+
 /**
  * Delete leftover temporary content files from previous sessions.
  *
  * LibretroExtractContentToTempFile() writes ".raylib-libretro-*" files that are
  * removed on unload, but a crash can orphan them (including large CD images). Sweep
- * the temp directory and remove any that aren't backing the current game. */
+ * the temp directory and remove those whose process is gone. Files of this
+ * process, which other instances may be playing, and of other running processes,
+ * like batch jobs sharing the directory, are left alone. */
 static void LibretroCleanupTempFiles(void) {
+    int self = LibretroGetProcessId();
     FilePathList files = LoadDirectoryFiles(LibretroGetTempDirectory());
     for (unsigned int i = 0; i < files.count; i++) {
-        if (TextFindIndex(GetFileName(files.paths[i]), ".raylib-libretro-") != 0) {
+        const char* name = GetFileName(files.paths[i]);
+        if (TextFindIndex(name, LIBRETRO_TEMP_FILE_PREFIX) != 0) {
             continue; // Not one of ours.
         }
-        if (TextIsEqual(files.paths[i], LIBRETRO.core.tempGamePath)) {
-            continue; // Leave the file backing the currently loaded game.
+        if (DirectoryExists(files.paths[i])) {
+            continue; // Temp content is always a file.
+        }
+        char* end = NULL;
+        long pid = strtol(name + sizeof(LIBRETRO_TEMP_FILE_PREFIX) - 1, &end, 10);
+        if (*end == '-' && pid > 0 && (pid == self || LibretroIsProcessRunning((int)pid))) {
+            continue; // Still in use. Files named before the pid was added are always orphans.
         }
         FileRemove(files.paths[i]);
     }
@@ -3252,17 +3759,27 @@ static void LibretroCleanupTempFiles(void) {
  * original extension is preserved so the core's content-format detection still
  * works. The path is stored in LIBRETRO.core.tempGamePath and removed on unload.
  *
- * @param originalName Virtual path of the content (used only for its extension).
- * @param data         File contents to write.
- * @param size         Number of bytes in \c data.
+ * @param originalName Virtual path of the content, copied a chunk at a time
+ *                     through the VFS so large images are never held in memory.
  * @return true if the temp file was written, false otherwise. */
-static bool LibretroExtractContentToTempFile(const char* originalName, const unsigned char* data, int size) {
+static bool LibretroExtractContentToTempFile(const char* originalName) {
+    struct retro_vfs_file_handle* source = raylib_libretro_vfs_open(originalName, RETRO_VFS_FILE_ACCESS_READ, RETRO_VFS_FILE_ACCESS_HINT_NONE);
+    if (source == NULL || source->dataSize <= 0) {
+        raylib_libretro_vfs_close(source);
+        return false;
+    }
+
+    // Named after the process and instance, which has one temp file at a time,
+    // so instances on other threads never pick the same name.
     const char* ext = GetFileExtension(originalName);
     if (ext == NULL) ext = "";
-    TextCopy(LIBRETRO.core.tempGamePath,
-        TextFormat("%s/.raylib-libretro-%d%s", LibretroGetTempDirectory(), GetRandomValue(1, 999999), ext));
-    if (!SaveFileData(LIBRETRO.core.tempGamePath, (void*)data, size)) {
+    snprintf(LIBRETRO.core.tempGamePath, sizeof(LIBRETRO.core.tempGamePath), "%s/" LIBRETRO_TEMP_FILE_PREFIX "%d-%llx%s",
+        LibretroGetTempDirectory(), LibretroGetProcessId(), (unsigned long long)(uintptr_t)LibretroCurrentInstance, ext);
+    bool ok = raylib_libretro_vfs_copy_to_file(source, LIBRETRO.core.tempGamePath);
+    raylib_libretro_vfs_close(source);
+    if (!ok) {
         TraceLog(LOG_ERROR, "LIBRETRO: Failed to write temp file for full-path core: %s", LIBRETRO.core.tempGamePath);
+        FileRemove(LIBRETRO.core.tempGamePath);
         LIBRETRO.core.tempGamePath[0] = '\0';
         return false;
     }
@@ -3340,25 +3857,33 @@ static bool LoadLibretroGame(const char* gameFile) {
         // rather than the VFS (such as PlayStation CD handling) can't see the virtual
         // path. Extract the file to a real temp path and retry with that. contentPath
         // keeps the logical name so save states and SRAM get a stable filename.
-        if (!existsOnDisk && raylib_libretro_vfs_alt_load_file_data != NULL) {
-            int extractedSize = 0;
-            unsigned char* extracted = raylib_libretro_vfs_alt_load_file_data(gameFile, &extractedSize);
-            bool wrote = (extracted != NULL && extractedSize > 0)
-                && LibretroExtractContentToTempFile(gameFile, extracted, extractedSize);
-            UnloadFileData(extracted);
-            if (wrote) {
-                info.path = LIBRETRO.core.tempGamePath;
-                // A core that reads RETRO_ENVIRONMENT_GET_GAME_INFO_EXT must also get
-                // the real path; tempGamePath is persistent so the pointer stays valid.
-                LIBRETRO.core.gameInfoExt.full_path = LIBRETRO.core.tempGamePath;
-                if (LIBRETRO.core.symbols.retro_load_game(&info)) {
-                    TraceLog(LOG_INFO, "LIBRETRO: Loaded archived content via temp file: %s", LIBRETRO.core.tempGamePath);
-                    LIBRETRO.core.loaded = true;
-                    return InitLibretroAudioVideo();
-                }
-                FileRemove(LIBRETRO.core.tempGamePath);
-                LIBRETRO.core.tempGamePath[0] = '\0';
+        // Prefer a persistent extraction cache, which reuses a copy extracted
+        // in an earlier session instead of inflating the content again.
+        if (!existsOnDisk && raylib_libretro_vfs_alt_extract != NULL &&
+                raylib_libretro_vfs_alt_extract(gameFile, LIBRETRO.core.cachedGamePath)) {
+            info.path = LIBRETRO.core.cachedGamePath;
+            LIBRETRO.core.gameInfoExt.full_path = LIBRETRO.core.cachedGamePath;
+            if (LIBRETRO.core.symbols.retro_load_game(&info)) {
+                TraceLog(LOG_INFO, "LIBRETRO: Loaded archived content via extraction cache: %s", LIBRETRO.core.cachedGamePath);
+                LIBRETRO.core.loaded = true;
+                return InitLibretroAudioVideo();
+            }
+            LIBRETRO.core.cachedGamePath[0] = '\0';
+            LIBRETRO.core.gameInfoExt.full_path = LIBRETRO.core.contentPath;
+        }
+
+        if (!existsOnDisk && LibretroExtractContentToTempFile(gameFile)) {
+            info.path = LIBRETRO.core.tempGamePath;
+            // A core that reads RETRO_ENVIRONMENT_GET_GAME_INFO_EXT must also get
+            // the real path; tempGamePath is persistent so the pointer stays valid.
+            LIBRETRO.core.gameInfoExt.full_path = LIBRETRO.core.tempGamePath;
+            if (LIBRETRO.core.symbols.retro_load_game(&info)) {
+                TraceLog(LOG_INFO, "LIBRETRO: Loaded archived content via temp file: %s", LIBRETRO.core.tempGamePath);
+                LIBRETRO.core.loaded = true;
+                return InitLibretroAudioVideo();
             }
+            FileRemove(LIBRETRO.core.tempGamePath);
+            LIBRETRO.core.tempGamePath[0] = '\0';
         }
 
         TraceLog(LOG_ERROR, "LIBRETRO: Failed to load full path: %s", gameFile);
@@ -3368,20 +3893,7 @@ static bool LoadLibretroGame(const char* gameFile) {
         return false;
     }
 
-    int size = 0;
-    unsigned char* gameData = LoadFileData(gameFile, &size);
-    if (gameData == NULL || size == 0) {
-        TraceLog(LOG_ERROR, "LIBRETRO: Failed to load game data with LoadFileData()");
-        LIBRETRO.core.loaded = false;
-        UnloadFileData(gameData);
-        return false;
-    }
-
-    bool ok = LoadLibretroGameFromMemoryEx(gameData, size, gameFile, persistent);
-    if (!ok || !persistent) {
-        UnloadFileData(gameData);
-    }
-    return ok;
+    return LoadLibretroGameFromVFS(gameFile, persistent);
 }
 
 /**
@@ -3418,6 +3930,133 @@ static bool IsLibretroGameRequired(void) {
     return !LIBRETRO.core.supportNoGame;
 }
 
+/**
+ * Whether the whitelist set with SetLibretroCorePool() lists the core.
+ */
+static bool IsLibretroCorePoolable(const char* libraryName) {
+    const char* list = LIBRETRO.corePoolWhitelist;
+    size_t nameLength = strlen(libraryName);
+    if (nameLength == 0) {
+        return false;
+    }
+    while (*list != '\0') {
+        const char* end = strchr(list, '|');
+        size_t length = (end != NULL) ? (size_t)(end - list) : strlen(list);
+        if ((length == 1 && list[0] == '*') || (length == nameLength && strncmp(list, libraryName, length) == 0)) {
+            return true;
+        }
+        if (end == NULL) {
+            break;
+        }
+        list = end + 1;
+    }
+    return false;
+}
+
+// Drop a pool entry without closing its dylib.
+static void RemoveLibretroCorePoolEntry(int index) {
+    LIBRETRO.corePoolCount--;
+    if (index != LIBRETRO.corePoolCount) {
+        LIBRETRO.corePool[index] = LIBRETRO.corePool[LIBRETRO.corePoolCount];
+    }
+    memset(&LIBRETRO.corePool[LIBRETRO.corePoolCount], 0, sizeof(LibretroCorePoolEntry));
+}
+
+// Close a pooled core's dylib and drop it from the pool.
+static void UnloadLibretroCorePoolEntry(int index) {
+    TraceLog(LOG_DEBUG, "LIBRETRO: Unloading %s from the core pool", LIBRETRO.corePool[index].libraryName);
+    dylib_close(LIBRETRO.corePool[index].symbols.handle);
+    RemoveLibretroCorePoolEntry(index);
+}
+
+// Close the least recently used pooled core.
+static void UnloadOldestLibretroCorePoolEntry(void) {
+    int oldest = 0;
+    for (int i = 1; i < LIBRETRO.corePoolCount; i++) {
+        if (LIBRETRO.corePool[i].lastUsed < LIBRETRO.corePool[oldest].lastUsed) {
+            oldest = i;
+        }
+    }
+    UnloadLibretroCorePoolEntry(oldest);
+}
+
+/**
+ * Move a pooled core's symbols into LIBRETRO.core, if the pool holds it.
+ */
+static bool TakeLibretroCoreFromPool(const char* core) {
+    for (int i = 0; i < LIBRETRO.corePoolCount; i++) {
+        if (TextIsEqual(LIBRETRO.corePool[i].corePath, core)) {
+            LIBRETRO.core.symbols = LIBRETRO.corePool[i].symbols;
+            RemoveLibretroCorePoolEntry(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Keep the closing core's dylib open in the pool instead of closing it,
+ * evicting the least recently used core when the pool is full. Only cores
+ * whose symbols were all resolved by InitLibretro() are kept; retro_get_memory_size
+ * is the last one it loads.
+ *
+ * @return true if the pool took ownership of the dylib handle.
+ */
+static bool PutLibretroCoreInPool(void) {
+    if (LIBRETRO.corePoolSize <= 0 || LIBRETRO.core.symbols.retro_get_memory_size == NULL ||
+            LIBRETRO.core.corePath[0] == '\0' || !IsLibretroCorePoolable(LIBRETRO.core.libraryName)) {
+        return false;
+    }
+
+    if (LIBRETRO.corePoolCount >= LIBRETRO.corePoolSize) {
+        UnloadOldestLibretroCorePoolEntry();
+    }
+
+    LibretroCorePoolEntry* entry = &LIBRETRO.corePool[LIBRETRO.corePoolCount++];
+    TextCopy(entry->corePath, LIBRETRO.core.corePath);
+    TextCopy(entry->libraryName, LIBRETRO.core.libraryName);
+    entry->symbols = LIBRETRO.core.symbols;
+    entry->lastUsed = ++LIBRETRO.corePoolClock;
+    TraceLog(LOG_DEBUG, "LIBRETRO: Keeping %s loaded in the core pool (%d of %d)", entry->libraryName,
+        LIBRETRO.corePoolCount, LIBRETRO.corePoolSize);
+    return true;
+}
+
+/**
+ * Keep up to size closed cores loaded so switching back to them skips the
+ * dlopen and symbol lookups; only retro_deinit()/retro_init() run between
+ * uses. Not every core resets its globals in retro_init(), so only cores
+ * named in the whitelist are kept.
+ *
+ * @param size Number of cores to keep loaded, 0 to disable the pool. Clamped to LIBRETRO_CORE_POOL_MAX.
+ * @param whitelist "|"-separated library names (e.g. "Snes9x|Genesis Plus GX"), "*" for any core, or NULL for none.
+ */
+static void SetLibretroCorePool(int size, const char* whitelist) {
+    if (size < 0) size = 0;
+    if (size > LIBRETRO_CORE_POOL_MAX) size = LIBRETRO_CORE_POOL_MAX;
+    LIBRETRO.corePoolSize = size;
+    snprintf(LIBRETRO.corePoolWhitelist, sizeof(LIBRETRO.corePoolWhitelist), "%s", whitelist != NULL ? whitelist : "");
+
+    // Drop the cores that no longer fit or are no longer whitelisted.
+    for (int i = LIBRETRO.corePoolCount - 1; i >= 0; i--) {
+        if (!IsLibretroCorePoolable(LIBRETRO.corePool[i].libraryName)) {
+            UnloadLibretroCorePoolEntry(i);
+        }
+    }
+    while (LIBRETRO.corePoolCount > LIBRETRO.corePoolSize) {
+        UnloadOldestLibretroCorePoolEntry();
+    }
+}
+
+/**
+ * Close every core kept loaded by the core pool. Call after CloseLibretro().
+ */
+static void UnloadLibretroCorePool(void) {
+    while (LIBRETRO.corePoolCount > 0) {
+        UnloadLibretroCorePoolEntry(LIBRETRO.corePoolCount - 1);
+    }
+}
+
 /**
  * Load a libretro core's dylib and populate its identity fields
  * (libraryName, libraryVersion, validExtensions, needFullpath, blockExtract)
@@ -3442,12 +4081,15 @@ static bool PeekLibretroCoreInfo(const char* core) {
         return false;
     }
 
-    // Open the dynamic library.
-    LIBRETRO.core.symbols.handle = dylib_load(core);
+    // Open the dynamic library, unless the core pool still has it open.
+    if (!TakeLibretroCoreFromPool(core)) {
+        LIBRETRO.core.symbols.handle = dylib_load(core);
+    }
     if (!LIBRETRO.core.symbols.handle) {
         TraceLog(LOG_ERROR, "LIBRETRO: Failed to load provided library");
         return false;
     }
+    TextCopy(LIBRETRO.core.corePath, core);
 
     // Find the libretro API version.
     LoadLibretroMethod(retro_api_version);
@@ -3484,6 +4126,7 @@ static bool PeekLibretroCoreInfo(const char* core) {
  * @note Call InitAudioDevice() and InitWindow() before this function.
  */
 static bool InitLibretro(const char* core) {
+    double startTime = GetTime();
     if (!PeekLibretroCoreInfo(core)) {
         return false;
     }
@@ -3491,32 +4134,33 @@ static bool InitLibretro(const char* core) {
     // Remove any temp content files orphaned by a previous session's crash.
     LibretroCleanupTempFiles();
 
-    // Load all other libretro methods.
-    LoadLibretroMethod(retro_init);
-    LoadLibretroMethod(retro_deinit);
-    LoadLibretroMethod(retro_set_environment);
-    LoadLibretroMethod(retro_set_video_refresh);
-    LoadLibretroMethod(retro_set_audio_sample);
-    LoadLibretroMethod(retro_set_audio_sample_batch);
-    LoadLibretroMethod(retro_set_input_poll);
-    LoadLibretroMethod(retro_set_input_state);
-    LoadLibretroMethod(retro_get_system_av_info);
-    LoadLibretroMethod(retro_set_controller_port_device);
-    LoadLibretroMethod(retro_reset);
-    LoadLibretroMethod(retro_run);
-    LoadLibretroMethod(retro_serialize_size);
-    LoadLibretroMethod(retro_serialize);
-    LoadLibretroMethod(retro_unserialize);
-    LoadLibretroMethod(retro_cheat_reset);
-    LoadLibretroMethod(retro_cheat_set);
-    LoadLibretroMethod(retro_load_game);
-    LoadLibretroMethod(retro_load_game_special);
-    LoadLibretroMethod(retro_unload_game);
-    LoadLibretroMethod(retro_get_region);
-    LoadLibretroMethod(retro_get_memory_data);
-    LoadLibretroMethod(retro_get_memory_size);
-
-    TextCopy(LIBRETRO.core.corePath, core);
+    // Load all other libretro methods. A core from the pool has them already.
+    bool pooled = LIBRETRO.core.symbols.retro_init != NULL;
+    if (!pooled) {
+        LoadLibretroMethod(retro_init);
+        LoadLibretroMethod(retro_deinit);
+        LoadLibretroMethod(retro_set_environment);
+        LoadLibretroMethod(retro_set_video_refresh);
+        LoadLibretroMethod(retro_set_audio_sample);
+        LoadLibretroMethod(retro_set_audio_sample_batch);
+        LoadLibretroMethod(retro_set_input_poll);
+        LoadLibretroMethod(retro_set_input_state);
+        LoadLibretroMethod(retro_get_system_av_info);
+        LoadLibretroMethod(retro_set_controller_port_device);
+        LoadLibretroMethod(retro_reset);
+        LoadLibretroMethod(retro_run);
+        LoadLibretroMethod(retro_serialize_size);
+        LoadLibretroMethod(retro_serialize);
+        LoadLibretroMethod(retro_unserialize);
+        LoadLibretroMethod(retro_cheat_reset);
+        LoadLibretroMethod(retro_cheat_set);
+        LoadLibretroMethod(retro_load_game);
+        LoadLibretroMethod(retro_load_game_special);
+        LoadLibretroMethod(retro_unload_game);
+        LoadLibretroMethod(retro_get_region);
+        LoadLibretroMethod(retro_get_memory_data);
+        LoadLibretroMethod(retro_get_memory_size);
+    }
 
     // Set up the callbacks.
     LIBRETRO.core.symbols.retro_set_video_refresh(LibretroVideoRefresh);
@@ -3528,6 +4172,9 @@ static bool InitLibretro(const char* core) {
 
     // Initialize the core.
     LIBRETRO.core.symbols.retro_init();
+    LIBRETRO.core.initialized = true;
+    TraceLog(LOG_INFO, "LIBRETRO: Core initialized in %.1f ms (%s)", (GetTime() - startTime) * 1000.0,
+        pooled ? "from the core pool" : "loaded");
     return true;
 }
 
@@ -4114,33 +4761,80 @@ static Texture2D GetLibretroTexture(void) {
  * @return Essentially a screenshot of the libretro game. Empty image otherwise.
  */
 static Image LoadImageFromLibretro() {
+    int displayWidth = 0;
+    int rotation = 0;
+    Image image = LoadImageFromLibretroEx(&displayWidth, &rotation);
+    FinishLibretroImage(&image, displayWidth, rotation);
+    return image;
+}
+
+/**
+ * The size of a captured frame: the core's height, and the width that gives
+ * it the core's aspect ratio.
+ */
+static void LibretroCaptureSize(int* width, int* height) {
+    *height = (int)LIBRETRO.core.height;
+    float aspect = GetLibretroAspectRatio();
+    *width = (aspect > 0.0f) ? (int)((float)*height * aspect + 0.5f) : (int)LIBRETRO.core.width;
+    if (*width <= 0) *width = (int)LIBRETRO.core.width;
+}
+
+/**
+ * Redraw a hardware frame onto a render texture, to correct the source size
+ * and scale to the aspect-corrected width in one pass.
+ *
+ * @return The render texture, to unload once it's read. Invalid on failure.
+ */
+static RenderTexture2D LibretroRenderHwCapture(int width, int height) {
+    RenderTexture2D rt = LoadRenderTexture(width, height);
+    if (!IsRenderTextureValid(rt)) {
+        return rt;
+    }
+    SetTextureFilter(rt.texture, TEXTURE_FILTER_ANISOTROPIC_4X);
+    Rectangle source = LibretroSourceRect();
+    source.height = -source.height; // FBO renders from bottom-left.
+    BeginTextureMode(rt);
+        ClearBackground(BLANK);
+        DrawTexturePro(LIBRETRO.core.texture, source,
+                       (Rectangle){0, 0, (float)width, (float)height},
+                       (Vector2){0, 0}, 0.0f, WHITE);
+    EndTextureMode();
+    return rt;
+}
+
+/**
+ * Capture the core's current frame as cheaply as possible on the main thread.
+ *
+ * Software frames are a single copy of the framebuffer at the core's native
+ * size. Hardware frames are read back from the GPU here, which waits for it,
+ * and come back already aspect-corrected; BeginLibretroFrameReadback() avoids
+ * the wait where GL allows. Either way, pass the outputs to
+ * FinishLibretroImage(), which only touches CPU memory and so can run on a
+ * worker thread.
+ *
+ * @param displayWidth Receives the aspect-corrected width the image should be scaled to.
+ * @param rotation Receives the core's rotation (0-3, in 90 degree steps) at capture time.
+ *
+ * @return The unscaled, unrotated frame. Empty image otherwise.
+ */
+static Image LoadImageFromLibretroEx(int* displayWidth, int* rotation) {
     Image image = {0};
+    if (displayWidth != NULL) *displayWidth = 0;
+    if (rotation != NULL) *rotation = 0;
     if (!IsLibretroGameReady()) {
         return image;
     }
 
-    // Determine the width/height of the final image.
-    int height = (int)LIBRETRO.core.height;
-    float aspect = GetLibretroAspectRatio();
-    int width = (aspect > 0.0f) ? (int)((float)height * aspect + 0.5f) : (int)LIBRETRO.core.width;
-    if (width <= 0) width = (int)LIBRETRO.core.width;
+    int width = 0;
+    int height = 0;
+    LibretroCaptureSize(&width, &height);
 
     // Hardware Rendering
     if (LIBRETRO.core.hwRender.active) {
-        // Redraw onto a render texture, to correct the source size and scale to the aspect-corrected width in one pass.
-        RenderTexture2D rt = LoadRenderTexture(width, height);
+        RenderTexture2D rt = LibretroRenderHwCapture(width, height);
         if (!IsRenderTextureValid(rt)) {
             return image;
         }
-        SetTextureFilter(rt.texture, TEXTURE_FILTER_ANISOTROPIC_4X);
-        Rectangle source = LibretroSourceRect();
-        source.height = -source.height; // FBO renders from bottom-left.
-        BeginTextureMode(rt);
-            ClearBackground(BLANK);
-            DrawTexturePro(LIBRETRO.core.texture, source,
-                           (Rectangle){0, 0, (float)width, (float)height},
-                           (Vector2){0, 0}, 0.0f, WHITE);
-        EndTextureMode();
         image = LoadImageFromTexture(rt.texture);
         UnloadRenderTexture(rt);
     }
@@ -4159,21 +4853,245 @@ static Image LoadImageFromLibretro() {
         image.mipmaps = 1;
         image.format = LibretroRetroPixelFormatToPixelFormat(LIBRETRO.core.pixelFormat);
         memcpy(image.data, LIBRETRO.core.frameBuffer, LIBRETRO.core.frameBufferSize);
+    }
+
+    if (displayWidth != NULL) *displayWidth = width;
+    if (rotation != NULL) *rotation = (int)LIBRETRO.core.rotation;
+    return image;
+}
+
+// Pixel pack buffers, fences and buffer mapping are core in desktop GL 3.3+
+// and GLES3. WebGL2 can't map buffers, so the web keeps the synchronous readback.
+#if (defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_43) || defined(GRAPHICS_API_OPENGL_ES3)) && \
+    !defined(PLATFORM_WEB) && !defined(__EMSCRIPTEN__)
+#define LIBRETRO_FRAME_READBACK_PBO
+#endif
+
+#ifdef LIBRETRO_FRAME_READBACK_PBO
+#define LIBRETRO_GL_PIXEL_PACK_BUFFER           0x88EBU
+#define LIBRETRO_GL_STREAM_READ                 0x88E1U
+#define LIBRETRO_GL_RGBA                        0x1908U
+#define LIBRETRO_GL_UNSIGNED_BYTE               0x1401U
+#define LIBRETRO_GL_MAP_READ_BIT                0x0001U
+#define LIBRETRO_GL_SYNC_GPU_COMMANDS_COMPLETE  0x9117U
+#define LIBRETRO_GL_SYNC_FLUSH_COMMANDS_BIT     0x00000001U
+#define LIBRETRO_GL_ALREADY_SIGNALED            0x911AU
+#define LIBRETRO_GL_TIMEOUT_EXPIRED             0x911BU
+#define LIBRETRO_GL_CONDITION_SATISFIED         0x911CU
+
+// How long PollLibretroFrameReadback() waits for the GPU when asked to, in nanoseconds.
+#define LIBRETRO_FRAME_READBACK_TIMEOUT 1000000000ULL
+
+typedef void          (*lrgl_GenBuffers)    (int, unsigned int*);
+typedef void          (*lrgl_DeleteBuffers) (int, const unsigned int*);
+typedef void          (*lrgl_BindBuffer)    (unsigned int, unsigned int);
+typedef void          (*lrgl_BufferData)    (unsigned int, intptr_t, const void*, unsigned int);
+typedef void          (*lrgl_ReadPixels)    (int, int, int, int, unsigned int, unsigned int, void*);
+typedef void*         (*lrgl_MapBufferRange)(unsigned int, intptr_t, intptr_t, unsigned int);
+typedef unsigned char (*lrgl_UnmapBuffer)   (unsigned int);
+typedef void*         (*lrgl_FenceSync)     (unsigned int, unsigned int);
+typedef unsigned int  (*lrgl_ClientWaitSync)(void*, unsigned int, uint64_t);
+typedef void          (*lrgl_DeleteSync)    (void*);
+typedef void          (*lrgl_Flush)         (void);
 
-        // Ensure the display aspect ratio is retained.
-        if (width != image.width) {
-            ImageResize(&image, width, height);
+/**
+ * GL entry points of the asynchronous readback, resolved with rlGetProcAddress().
+ */
+typedef struct LibretroReadbackGL {
+    lrgl_GenBuffers GenBuffers;
+    lrgl_DeleteBuffers DeleteBuffers;
+    lrgl_BindBuffer BindBuffer;
+    lrgl_BufferData BufferData;
+    lrgl_ReadPixels ReadPixels;
+    lrgl_MapBufferRange MapBufferRange;
+    lrgl_UnmapBuffer UnmapBuffer;
+    lrgl_FenceSync FenceSync;
+    lrgl_ClientWaitSync ClientWaitSync;
+    lrgl_DeleteSync DeleteSync;
+    lrgl_Flush Flush;
+} LibretroReadbackGL;
+
+/**
+ * Resolve the readback's GL entry points, once.
+ *
+ * @return The entry points, or NULL when the context lacks any of them.
+ */
+static const LibretroReadbackGL* LibretroGetReadbackGL(void) {
+    static LibretroReadbackGL gl;
+    static int loaded = 0; // 0 not tried, 1 available, -1 unavailable
+    if (loaded == 0) {
+        gl.GenBuffers     = (lrgl_GenBuffers)     rlGetProcAddress("glGenBuffers");
+        gl.DeleteBuffers  = (lrgl_DeleteBuffers)  rlGetProcAddress("glDeleteBuffers");
+        gl.BindBuffer     = (lrgl_BindBuffer)     rlGetProcAddress("glBindBuffer");
+        gl.BufferData     = (lrgl_BufferData)     rlGetProcAddress("glBufferData");
+        gl.ReadPixels     = (lrgl_ReadPixels)     rlGetProcAddress("glReadPixels");
+        gl.MapBufferRange = (lrgl_MapBufferRange) rlGetProcAddress("glMapBufferRange");
+        gl.UnmapBuffer    = (lrgl_UnmapBuffer)    rlGetProcAddress("glUnmapBuffer");
+        gl.FenceSync      = (lrgl_FenceSync)      rlGetProcAddress("glFenceSync");
+        gl.ClientWaitSync = (lrgl_ClientWaitSync) rlGetProcAddress("glClientWaitSync");
+        gl.DeleteSync     = (lrgl_DeleteSync)     rlGetProcAddress("glDeleteSync");
+        gl.Flush          = (lrgl_Flush)          rlGetProcAddress("glFlush");
+        bool complete = gl.GenBuffers && gl.DeleteBuffers && gl.BindBuffer && gl.BufferData &&
+            gl.ReadPixels && gl.MapBufferRange && gl.UnmapBuffer && gl.FenceSync &&
+            gl.ClientWaitSync && gl.DeleteSync && gl.Flush;
+        loaded = complete ? 1 : -1;
+        if (!complete) {
+            TraceLog(LOG_INFO, "LIBRETRO: Asynchronous frame readback unavailable, capturing synchronously");
+        }
+    }
+    return (loaded == 1) ? &gl : NULL;
+}
+#endif
+
+/**
+ * Start reading the core's current hardware frame back from the GPU, without
+ * waiting for it. The frame is copied into a pixel pack buffer behind a fence,
+ * and collected a frame or more later with PollLibretroFrameReadback(), by
+ * which time the GPU has usually finished and nothing stalls.
+ *
+ * @param readback Receives the readback in flight.
+ * @return false when the core renders in software, or GL can't read back
+ * asynchronously; use LoadImageFromLibretroEx() then.
+ */
+static bool BeginLibretroFrameReadback(LibretroFrameReadback* readback) {
+    if (readback == NULL) {
+        return false;
+    }
+    memset(readback, 0, sizeof(LibretroFrameReadback));
+#ifdef LIBRETRO_FRAME_READBACK_PBO
+    if (!IsLibretroGameReady() || !LIBRETRO.core.hwRender.active) {
+        return false;
+    }
+    const LibretroReadbackGL* gl = LibretroGetReadbackGL();
+    if (gl == NULL) {
+        return false;
+    }
+
+    int width = 0;
+    int height = 0;
+    LibretroCaptureSize(&width, &height);
+    RenderTexture2D rt = LibretroRenderHwCapture(width, height);
+    if (!IsRenderTextureValid(rt)) {
+        return false;
+    }
+
+    gl->GenBuffers(1, &readback->buffer);
+    gl->BindBuffer(LIBRETRO_GL_PIXEL_PACK_BUFFER, readback->buffer);
+    gl->BufferData(LIBRETRO_GL_PIXEL_PACK_BUFFER, (intptr_t)width * height * 4, NULL, LIBRETRO_GL_STREAM_READ);
+    rlEnableFramebuffer(rt.id);
+    gl->ReadPixels(0, 0, width, height, LIBRETRO_GL_RGBA, LIBRETRO_GL_UNSIGNED_BYTE, NULL);
+    rlDisableFramebuffer();
+    gl->BindBuffer(LIBRETRO_GL_PIXEL_PACK_BUFFER, 0);
+    readback->fence = gl->FenceSync(LIBRETRO_GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl->Flush();
+    UnloadRenderTexture(rt);
+
+    if (readback->fence == NULL) {
+        gl->DeleteBuffers(1, &readback->buffer);
+        readback->buffer = 0;
+        return false;
+    }
+    readback->width = width;
+    readback->height = height;
+    readback->displayWidth = width;
+    readback->rotation = (int)LIBRETRO.core.rotation;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Collect a frame started with BeginLibretroFrameReadback(), once the GPU has
+ * copied it. The outputs are the same as LoadImageFromLibretroEx()'s, to pass
+ * to FinishLibretroImage().
+ *
+ * @param readback The readback in flight. It's idle again once this returns true.
+ * @param wait Block until the frame arrives, e.g. at shutdown, instead of checking.
+ * @param image Receives the frame, or an empty image if the readback failed.
+ * @param displayWidth Receives the aspect-corrected width the image should be scaled to.
+ * @param rotation Receives the core's rotation at capture time.
+ *
+ * @return false while the GPU is still copying the frame.
+ */
+static bool PollLibretroFrameReadback(LibretroFrameReadback* readback, bool wait, Image* image, int* displayWidth, int* rotation) {
+    Image result = {0};
+    if (displayWidth != NULL) *displayWidth = 0;
+    if (rotation != NULL) *rotation = 0;
+#ifdef LIBRETRO_FRAME_READBACK_PBO
+    const LibretroReadbackGL* gl = LibretroGetReadbackGL();
+    if (readback != NULL && readback->buffer != 0 && gl != NULL) {
+        unsigned int status = gl->ClientWaitSync(readback->fence,
+            wait ? LIBRETRO_GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? LIBRETRO_FRAME_READBACK_TIMEOUT : 0);
+        if (status == LIBRETRO_GL_TIMEOUT_EXPIRED && !wait) {
+            return false;
+        }
+
+        if (status == LIBRETRO_GL_ALREADY_SIGNALED || status == LIBRETRO_GL_CONDITION_SATISFIED) {
+            size_t size = (size_t)readback->width * (size_t)readback->height * 4;
+            gl->BindBuffer(LIBRETRO_GL_PIXEL_PACK_BUFFER, readback->buffer);
+            const void* pixels = gl->MapBufferRange(LIBRETRO_GL_PIXEL_PACK_BUFFER, 0, (intptr_t)size, LIBRETRO_GL_MAP_READ_BIT);
+            if (pixels != NULL) {
+                result.data = MemAlloc((unsigned int)size);
+                if (result.data != NULL) {
+                    // Same layout as LoadImageFromTexture() gives for the render texture.
+                    memcpy(result.data, pixels, size);
+                    result.width = readback->width;
+                    result.height = readback->height;
+                    result.mipmaps = 1;
+                    result.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+                    if (displayWidth != NULL) *displayWidth = readback->displayWidth;
+                    if (rotation != NULL) *rotation = readback->rotation;
+                }
+                gl->UnmapBuffer(LIBRETRO_GL_PIXEL_PACK_BUFFER);
+            }
+            gl->BindBuffer(LIBRETRO_GL_PIXEL_PACK_BUFFER, 0);
+        } else {
+            TraceLog(LOG_WARNING, "LIBRETRO: Frame readback failed (0x%04X)", status);
         }
+
+        gl->DeleteSync(readback->fence);
+        gl->DeleteBuffers(1, &readback->buffer);
+    }
+#else
+    (void)wait;
+#endif
+    if (readback != NULL) {
+        memset(readback, 0, sizeof(LibretroFrameReadback));
+    }
+    if (image != NULL) {
+        *image = result;
+    } else if (result.data != NULL) {
+        UnloadImage(result);
+    }
+    return true;
+}
+
+/**
+ * Scale a frame from LoadImageFromLibretroEx() to its display aspect ratio and
+ * apply the core's rotation. Only uses CPU image functions, so it is safe to
+ * call off the main thread.
+ *
+ * @param image The captured frame, modified in place.
+ * @param displayWidth The aspect-corrected width reported by LoadImageFromLibretroEx().
+ * @param rotation The rotation reported by LoadImageFromLibretroEx().
+ */
+static void FinishLibretroImage(Image* image, int displayWidth, int rotation) {
+    if (image == NULL || image->data == NULL) {
+        return;
     }
 
-    switch (LIBRETRO.core.rotation) {
-        case 1: ImageRotateCW(&image);        break;
-        case 2: ImageRotate(&image, 180);     break;
-        case 3: ImageRotateCCW(&image);       break;
-        default: break;
+    // Ensure the display aspect ratio is retained.
+    if (displayWidth > 0 && displayWidth != image->width) {
+        ImageResize(image, displayWidth, image->height);
     }
 
-    return image;
+    switch (rotation) {
+        case 1: ImageRotateCW(image);        break;
+        case 2: ImageRotate(image, 180);     break;
+        case 3: ImageRotateCCW(image);       break;
+        default: break;
+    }
 }
 
 /**
@@ -4262,6 +5180,60 @@ static bool SetLibretroSRAMData(const void* data, size_t size) {
     return true;
 }
 
+/**
+ * Hash a block of memory, such as the core's SRAM region or a frame buffer.
+ *
+ * Not cryptographic: it is only meant to tell cheaply whether a buffer changed.
+ * The bulk of the input is consumed 32 bytes at a time across four independent
+ * 64-bit lanes, which keeps the multiplies pipelined (and lets the compiler
+ * vectorize them) so hashing a 128 KB SRAM takes a few microseconds.
+ *
+ * @param data The bytes to hash.
+ * @param size Number of bytes in @p data.
+ * @return A 64-bit hash of the data, which is stable across runs.
+ */
+static uint64_t GetLibretroDataHash(const void* data, size_t size) {
+    const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const unsigned char* p = (const unsigned char*)data;
+    uint64_t lanes[4] = { prime1 + prime2, prime2, 0, (uint64_t)0 - prime1 };
+    size_t i = 0;
+
+    if (p == NULL) {
+        size = 0;
+    }
+
+    for (; i + 32 <= size; i += 32) {
+        for (int lane = 0; lane < 4; lane++) {
+            uint64_t word;
+            memcpy(&word, p + i + (size_t)lane * 8, sizeof(word));
+            lanes[lane] += word * prime2;
+            lanes[lane] = (lanes[lane] << 31) | (lanes[lane] >> 33);
+            lanes[lane] *= prime1;
+        }
+    }
+
+    uint64_t hash = (uint64_t)size;
+    for (int lane = 0; lane < 4; lane++) {
+        hash ^= lanes[lane];
+        hash = ((hash << 27) | (hash >> 37)) * prime1 + prime2;
+    }
+
+    // Tail, one byte at a time (fewer than 32 bytes remain).
+    for (; i < size; i++) {
+        hash ^= (uint64_t)p[i] * prime1;
+        hash = ((hash << 11) | (hash >> 53)) * prime2;
+    }
+
+    // Final avalanche so nearby inputs land far apart.
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
 /**
  * Unload the currently loaded content without closing the core.
  */
@@ -4288,6 +5260,7 @@ static void UnloadLibretroGame(void) {
         FileRemove(LIBRETRO.core.tempGamePath);
         LIBRETRO.core.tempGamePath[0] = '\0';
     }
+    LIBRETRO.core.cachedGamePath[0] = '\0';
     LIBRETRO.core.gameInfoExtValid = false;
     memset(&LIBRETRO.core.gameInfoExt, 0, sizeof(LIBRETRO.core.gameInfoExt));
 
@@ -4316,6 +5289,10 @@ static void UnloadLibretroGame(void) {
         LIBRETRO.core.persistentGameData = NULL;
         LIBRETRO.core.persistentGameDataSize = 0;
     }
+    if (LIBRETRO.core.persistentGameFile != NULL) {
+        raylib_libretro_vfs_close(LIBRETRO.core.persistentGameFile);
+        LIBRETRO.core.persistentGameFile = NULL;
+    }
 
     // Free memory map descriptors — these are game-specific and must not
     // outlive the game that provided them.
@@ -4338,8 +5315,9 @@ static void CloseLibretro(void) {
         LIBRETRO.core.audio_callback.set_state(false);
     }
 
-    // Call retro_deinit() to deinitialize the core.
-    if (LIBRETRO.core.symbols.retro_deinit != NULL) {
+    // Call retro_deinit() to deinitialize the core. A core only peeked, or
+    // taken from the core pool, was never initialized.
+    if (LIBRETRO.core.initialized && LIBRETRO.core.symbols.retro_deinit != NULL) {
         LIBRETRO.core.symbols.retro_deinit();
     }
 
@@ -4360,8 +5338,8 @@ static void CloseLibretro(void) {
         LIBRETRO.core.subsystemCount = 0;
     }
 
-    // Close the dynamically loaded handle.
-    if (LIBRETRO.core.symbols.handle != NULL) {
+    // Close the dynamically loaded handle, or keep it in the core pool.
+    if (LIBRETRO.core.symbols.handle != NULL && !PutLibretroCoreInPool()) {
         dylib_close(LIBRETRO.core.symbols.handle);
     }
 
@@ -4371,6 +5349,7 @@ static void CloseLibretro(void) {
 
     // Release owned pointers before the memset wipes them.
     UnloadLibretroMemoryMaps();
+    UnloadLibretroCoreVariables();
 
     // Clear the data.
     memset(&LIBRETRO.core, 0, sizeof(LIBRETRO.core));
@@ -4383,6 +5362,125 @@ static void CloseLibretro(void) {
     }
 }
 
+/**
+ * Create a frontend instance, so several cores can run in one process, e.g.
+ * to batch-test content. Make it current with SetLibretroInstance(), or use
+ * the *LibretroInstance() variants, to run the rest of the API on it.
+ *
+ * A dylib is only loaded once per process, so each instance needs a
+ * different core. Instances on other threads must be headless, one per
+ * thread: the window, GL context and audio device belong to the default
+ * instance, as do PhysFS and its /game mount, so they load plain files.
+ * Some raylib helpers, like TextFormat(), share static buffers, so threaded
+ * instances are best effort; separate processes are the safe way to run many.
+ *
+ * @param headless Keep frames in memory (see GetLibretroFrameData()) instead of drawing them, and drop audio.
+ * @return The instance, or NULL when out of memory. Free it with UnloadLibretroInstance().
+ */
+static LibretroInstance* LoadLibretroInstance(bool headless) {
+    static const LibretroData defaults = LIBRETRO_INSTANCE_DEFAULTS;
+    LibretroInstance* instance = (LibretroInstance*)MemAlloc(sizeof(LibretroInstance));
+    if (instance == NULL) {
+        TraceLog(LOG_ERROR, "LIBRETRO: Failed to allocate an instance");
+        return NULL;
+    }
+    memcpy(instance, &defaults, sizeof(LibretroInstance));
+    instance->headless = headless;
+    return instance;
+}
+
+/**
+ * Close an instance's core, and the cores in its core pool, and free it.
+ * The default instance can't be unloaded.
+ */
+static void UnloadLibretroInstance(LibretroInstance* instance) {
+    if (instance == NULL || instance == &LibretroDefaultInstance) {
+        return;
+    }
+    LibretroInstance* previous = SetLibretroInstance(instance);
+    CloseLibretro();
+    UnloadLibretroCorePool();
+    UnloadLibretroStringArena(&LIBRETRO.retiredVariableStrings);
+    SetLibretroInstance(previous == instance ? NULL : previous);
+    MemFree(instance);
+}
+
+/**
+ * Make an instance current on the calling thread. Every API function, and
+ * every callback of a core called from this thread, then acts on it.
+ *
+ * @param instance The instance, or NULL for the default instance.
+ * @return The instance that was current before, to restore it afterwards.
+ */
+static LibretroInstance* SetLibretroInstance(LibretroInstance* instance) {
+    LibretroInstance* previous = LibretroCurrentInstance;
+    LibretroCurrentInstance = (instance != NULL) ? instance : &LibretroDefaultInstance;
+    return previous;
+}
+
+/**
+ * Get the instance that is current on the calling thread.
+ */
+static LibretroInstance* GetLibretroInstance(void) {
+    return LibretroCurrentInstance;
+}
+
+/**
+ * InitLibretro() on the given instance.
+ */
+static bool InitLibretroInstance(LibretroInstance* instance, const char* core) {
+    LibretroInstance* previous = SetLibretroInstance(instance);
+    bool result = InitLibretro(core);
+    SetLibretroInstance(previous);
+    return result;
+}
+
+/**
+ * LoadLibretroGame() on the given instance.
+ */
+static bool LoadLibretroInstanceGame(LibretroInstance* instance, const char* gameFile) {
+    LibretroInstance* previous = SetLibretroInstance(instance);
+    bool result = LoadLibretroGame(gameFile);
+    SetLibretroInstance(previous);
+    return result;
+}
+
+/**
+ * Update the given instance. Headless instances run exactly one frame per
+ * call, as fast as the caller asks; others pace themselves like UpdateLibretro().
+ */
+static void UpdateLibretroInstance(LibretroInstance* instance) {
+    LibretroInstance* previous = SetLibretroInstance(instance);
+    UpdateLibretroEx(LIBRETRO.headless);
+    SetLibretroInstance(previous);
+}
+
+/**
+ * CloseLibretro() on the given instance.
+ */
+static void CloseLibretroInstance(LibretroInstance* instance) {
+    LibretroInstance* previous = SetLibretroInstance(instance);
+    CloseLibretro();
+    SetLibretroInstance(previous);
+}
+
+/**
+ * Get the last frame of a headless instance, in the core's pixel format
+ * (RGB565/0RGB1555 at 2 bytes, XRGB8888 at 4 bytes per pixel) with no padding
+ * between rows.
+ *
+ * @param size Receives the frame size in bytes.
+ * @return The frame, or NULL when the instance isn't headless or has no frame yet.
+ */
+static const void* GetLibretroFrameData(size_t* size) {
+    if (!LIBRETRO.headless || LIBRETRO.core.frameBuffer == NULL) {
+        if (size != NULL) *size = 0;
+        return NULL;
+    }
+    if (size != NULL) *size = LIBRETRO.core.frameBufferSize;
+    return LIBRETRO.core.frameBuffer;
+}
+
 /**
  * Map a libretro retro_log_level to a raylib TraceLogType.
  */
@@ -4840,10 +5938,27 @@ static void LibretroPixelFormatARGB1555ToRGB565(void *output_, const void *input
  * still matches the currently loaded content before restoring it.
  */
 static unsigned int GetLibretroSerializedSize(void) {
+    return GetLibretroSerializedSizeEx(RETRO_SAVESTATE_CONTEXT_NORMAL);
+}
+
+/**
+ * Size in bytes of the loaded core's serialized state for the given context.
+ *
+ * Cores may report a smaller size for run-ahead contexts, since those states
+ * can leave out data that only matters across instances or sessions.
+ *
+ * @param context The RETRO_SAVESTATE_CONTEXT_* reported to the core while it sizes the state.
+ * @return The state size in bytes, or 0 if no game is ready.
+ */
+static unsigned int GetLibretroSerializedSizeEx(enum retro_savestate_context context) {
     if (!IsLibretroGameReady() || LIBRETRO.core.symbols.retro_serialize_size == NULL) {
         return 0;
     }
-    return (unsigned int)LIBRETRO.core.symbols.retro_serialize_size();
+    enum retro_savestate_context previous = LIBRETRO.core.savestateContext;
+    LIBRETRO.core.savestateContext = context;
+    unsigned int size = (unsigned int)LIBRETRO.core.symbols.retro_serialize_size();
+    LIBRETRO.core.savestateContext = previous;
+    return size;
 }
 
 /**
@@ -4852,6 +5967,23 @@ static unsigned int GetLibretroSerializedSize(void) {
  * @return Newly allocated buffer containing the serialized state, or NULL on failure.
  * @note The caller is responsible for freeing the returned buffer with MemFree(). */
 static void* GetLibretroSerializedData(unsigned int* size) {
+    return GetLibretroSerializedDataEx(size, RETRO_SAVESTATE_CONTEXT_NORMAL);
+}
+
+/**
+ * Serialize the current emulator state into a new buffer, telling the core what
+ * the state is for.
+ *
+ * Pass RETRO_SAVESTATE_CONTEXT_RUNAHEAD_SAME_INSTANCE for short-lived snapshots
+ * that are only restored into this same running instance, like rewind. Cores
+ * that query RETRO_ENVIRONMENT_GET_SAVESTATE_CONTEXT can then skip state that
+ * doesn't need to survive (resampler state, large caches), making them cheaper.
+ *
+ * @param size Output parameter filled with the size of the returned buffer in bytes.
+ * @param context The RETRO_SAVESTATE_CONTEXT_* to report while serializing.
+ * @return Newly allocated buffer containing the serialized state, or NULL on failure.
+ * @note The caller is responsible for freeing the returned buffer with MemFree(). */
+static void* GetLibretroSerializedDataEx(unsigned int* size, enum retro_savestate_context context) {
     if (!IsLibretroGameReady()) {
         return NULL;
     }
@@ -4860,8 +5992,12 @@ static void* GetLibretroSerializedData(unsigned int* size) {
         return NULL;
     }
 
+    enum retro_savestate_context previous = LIBRETRO.core.savestateContext;
+    LIBRETRO.core.savestateContext = context;
+
     size_t finalSize = LIBRETRO.core.symbols.retro_serialize_size();
     if (finalSize == 0) {
+        LIBRETRO.core.savestateContext = previous;
         return NULL;
     }
 
@@ -4876,6 +6012,7 @@ static void* GetLibretroSerializedData(unsigned int* size) {
 
     void* saveData = MemAlloc((unsigned int)finalSize);
     if (saveData == NULL) {
+        LIBRETRO.core.savestateContext = previous;
         return NULL;
     }
 
@@ -4884,7 +6021,9 @@ static void* GetLibretroSerializedData(unsigned int* size) {
         memset(saveData, 0, finalSize);
     }
 
-    if (LIBRETRO.core.symbols.retro_serialize(saveData, finalSize)) {
+    bool serialized = LIBRETRO.core.symbols.retro_serialize(saveData, finalSize);
+    LIBRETRO.core.savestateContext = previous;
+    if (serialized) {
         return saveData;
     }
     TraceLog(LOG_ERROR, "LIBRETRO: Failed to get retro_serialize");
@@ -4898,6 +6037,17 @@ static void* GetLibretroSerializedData(unsigned int* size) {
  * @param size Size of the buffer in bytes.
  * @return true on success, false if the core rejected the data. */
 static bool SetLibretroSerializedData(void* data, unsigned int size) {
+    return SetLibretroSerializedDataEx(data, size, RETRO_SAVESTATE_CONTEXT_NORMAL);
+}
+
+/**
+ * Restore a previously serialized emulator state that was captured with the
+ * same @p context through GetLibretroSerializedDataEx().
+ * @param data Pointer to the serialized state buffer.
+ * @param size Size of the buffer in bytes.
+ * @param context The RETRO_SAVESTATE_CONTEXT_* to report while unserializing.
+ * @return true on success, false if the core rejected the data. */
+static bool SetLibretroSerializedDataEx(void* data, unsigned int size, enum retro_savestate_context context) {
     if (!IsLibretroGameReady()) {
         return false;
     }
@@ -4910,7 +6060,11 @@ static bool SetLibretroSerializedData(void* data, unsigned int size) {
     // time accumulator here — doing so would zero it each frame and starve
     // retro_run() of ticks. One-shot loaders (save-state) call
     // ResetLibretroTiming() themselves.
-    return LIBRETRO.core.symbols.retro_unserialize(data, (size_t)size);
+    enum retro_savestate_context previous = LIBRETRO.core.savestateContext;
+    LIBRETRO.core.savestateContext = context;
+    bool result = LIBRETRO.core.symbols.retro_unserialize(data, (size_t)size);
+    LIBRETRO.core.savestateContext = previous;
+    return result;
 }
 
 #endif
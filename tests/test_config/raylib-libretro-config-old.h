@@ -0,0 +1,413 @@
+/**********************************************************************************************
+*
+*   raylib-libretro-config - Config system for raylib-libretro, as it was before it parsed files
+*   in place. Kept for test_config to compare the current parser with; nothing else uses it.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#ifndef RAYLIB_LIBRETRO_CONFIG_OLD_H
+#define RAYLIB_LIBRETRO_CONFIG_OLD_H
+
+#include <string.h>
+#include <stdio.h>
+
+/* Size limits for individual field strings */
+#define RLCONFIG_SECTION_MAX  64
+#define RLCONFIG_KEY_MAX      256
+#define RLCONFIG_VALUE_MAX    512
+#define RLCONFIG_COMPOUND_MAX (RLCONFIG_SECTION_MAX + 1 + RLCONFIG_KEY_MAX + 1)
+#define RLCONFIG_LINE_MAX     (RLCONFIG_KEY_MAX + RLCONFIG_VALUE_MAX + 4)
+
+// Shared config file used by SaveLibretroCoreOptions / LoadLibretroCoreOptions.
+// Keys are prefixed with the core name: "CoreName.key=value"
+// On emscripten the file lives in the IDBFS-backed /userdata mount so it
+// persists across page reloads (see bin/shell.html).
+#ifdef __EMSCRIPTEN__
+    #define RAYLIB_LIBRETRO_CFG_FILE "/userdata/raylib-libretro.cfg"
+#else
+    #define RAYLIB_LIBRETRO_CFG_FILE "raylib-libretro.cfg"
+#endif
+
+#define HASHMAP_REALLOC(p, s) MemRealloc(p, (unsigned int)s)
+#define HASHMAP_FREE(p)       MemFree(p)
+#include "../../vendor/hashmap/hashmap.h"
+
+/* Hashmap type: compound key ("section\nkey") → entry index */
+HASHMAP_DECLARE_STRING(RLibretroConfigLookup, rlconfiglookup, int)
+
+/* Redirect cvector allocations through raylib's memory functions. */
+#define cvector_clib_malloc(sz)    MemAlloc((unsigned int)(sz))
+#define cvector_clib_realloc(p,sz) MemRealloc((p), (unsigned int)(sz))
+#define cvector_clib_free          MemFree
+#define cvector_clib_calloc(n,sz)  memset(MemAlloc((unsigned int)((n)*(sz))), 0, (size_t)((n)*(sz)))
+#include "../../vendor/c-vector/cvector.h"
+
+/* One config key-value pair with its section. Heap-allocated individually so that
+   the compound field address (used as a hashmap key) stays stable across vector growth. */
+typedef struct {
+    char section[RLCONFIG_SECTION_MAX];
+    char key[RLCONFIG_KEY_MAX];
+    char value[RLCONFIG_VALUE_MAX];
+    char compound[RLCONFIG_COMPOUND_MAX]; /* "section\nkey" — used as hashmap key */
+} RLibretroConfigEntry;
+
+/* In-memory config — heap allocated via rlconfig_load() */
+typedef struct {
+    cvector(RLibretroConfigEntry*) entries; /* individually heap-allocated entries */
+    RLibretroConfigLookup lookup;           /* compound_key → index into entries */
+    bool dirty;                             /* changed since it was loaded or saved */
+} RLibretroConfig;
+
+/* --- Public API (all static) --- */
+
+/* Load config from filename. Pass NULL to create an empty config. Caller must call rlconfig_free(). */
+static RLibretroConfig* rlconfig_load(const char *filename);
+
+/* Save config to filename. Returns true on success. */
+static bool rlconfig_save(RLibretroConfig *cfg, const char *filename);
+
+/* Get string value for section+key. Returns NULL if not found. */
+static const char* rlconfig_get(RLibretroConfig *cfg, const char *section, const char *key);
+
+/* Get integer value for section+key. Returns fallback if not found or non-numeric. */
+static int rlconfig_get_int(RLibretroConfig *cfg, const char *section, const char *key, int fallback);
+
+/* Set string value for section+key. Adds entry if new, updates in-place if existing. */
+static void rlconfig_set(RLibretroConfig *cfg, const char *section, const char *key, const char *value);
+
+/* Set integer value (formatted as decimal string). */
+static void rlconfig_set_int(RLibretroConfig *cfg, const char *section, const char *key, int value);
+
+/* Get float value for section+key. Returns fallback if not found or non-numeric. */
+static float rlconfig_get_float(RLibretroConfig *cfg, const char *section, const char *key, float fallback);
+
+/* Set float value (formatted as a decimal string). */
+static void rlconfig_set_float(RLibretroConfig *cfg, const char *section, const char *key, float value);
+
+/* Remove a single key. Returns true if the key existed. */
+static bool rlconfig_delete(RLibretroConfig *cfg, const char *section, const char *key);
+
+/* Remove all keys in a section. */
+static void rlconfig_clear_section(RLibretroConfig *cfg, const char *section);
+
+/* Free config and all associated memory. */
+static void rlconfig_free(RLibretroConfig *cfg);
+
+/* Load a sectionless .info file (key = "value") into the given section of cfg.
+   Strips surrounding double quotes from values. */
+static void rlconfig_load_info(RLibretroConfig *cfg, const char *section, const char *filename);
+
+/* --- Implementation --- */
+
+#ifdef RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION
+#ifndef RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION_ONCE
+#define RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION_ONCE
+
+HASHMAP_DEFINE_STRING(RLibretroConfigLookup, rlconfiglookup, int)
+
+/* Build compound key "section\nkey" into out (size RLCONFIG_COMPOUND_MAX). */
+static void RLibretroConfigCompound(const char *section, const char *key,
+                                    char *out, size_t outSize) {
+    snprintf(out, outSize, "%s\n%s", section, key);
+}
+
+static void rlconfig_free(RLibretroConfig *cfg) {
+    if (!cfg) return;
+    for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
+        MemFree(cfg->entries[i]);
+    }
+    cvector_free(cfg->entries);
+    rlconfiglookup_free(&cfg->lookup);
+    MemFree(cfg);
+}
+
+static bool rlconfig_delete(RLibretroConfig *cfg, const char *section, const char *key) {
+    char compound[RLCONFIG_COMPOUND_MAX];
+    int idx = -1;
+    if (!cfg || !section || !key) return false;
+    RLibretroConfigCompound(section, key, compound, sizeof(compound));
+    if (!rlconfiglookup_get(&cfg->lookup, compound, &idx) || idx < 0) return false;
+
+    cfg->dirty = true;
+    rlconfiglookup_remove(&cfg->lookup, cfg->entries[idx]->compound, NULL);
+    MemFree(cfg->entries[idx]);
+    cvector_erase(cfg->entries, (size_t)idx);
+
+    /* Fix hashmap indices for entries that shifted left after the erase. */
+    for (size_t i = (size_t)idx; i < cvector_size(cfg->entries); i++) {
+        rlconfiglookup_insert(&cfg->lookup, cfg->entries[i]->compound, (int)i);
+    }
+    return true;
+}
+
+static void rlconfig_clear_section(RLibretroConfig *cfg, const char *section) {
+    if (!cfg || !section) return;
+
+    /* Stable partition: keep non-matching entries, free matching ones. */
+    size_t write = 0;
+    for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
+        if (strcmp(cfg->entries[i]->section, section) == 0) {
+            MemFree(cfg->entries[i]);
+        } else {
+            cfg->entries[write++] = cfg->entries[i];
+        }
+    }
+    if (write == cvector_size(cfg->entries)) return;
+    cvector_set_size(cfg->entries, write);
+    cfg->dirty = true;
+
+    /* Rebuild hashmap from scratch since indices changed. */
+    rlconfiglookup_clear(&cfg->lookup);
+    for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
+        rlconfiglookup_insert(&cfg->lookup, cfg->entries[i]->compound, (int)i);
+    }
+}
+
+static void rlconfig_set(RLibretroConfig *cfg, const char *section,
+                          const char *key, const char *value) {
+    char compound[RLCONFIG_COMPOUND_MAX];
+    int idx = -1;
+
+    if (!cfg || !section || !key || !value) return;
+
+    RLibretroConfigCompound(section, key, compound, sizeof(compound));
+
+    if (rlconfiglookup_get(&cfg->lookup, compound, &idx) && idx >= 0) {
+        /* Compare what would be stored, so an over-long value that's
+           unchanged once truncated doesn't dirty the config either. */
+        char stored[RLCONFIG_VALUE_MAX];
+        snprintf(stored, sizeof(stored), "%s", value);
+        if (strcmp(cfg->entries[idx]->value, stored) == 0) return;
+        memcpy(cfg->entries[idx]->value, stored, sizeof(stored));
+        cfg->dirty = true;
+        return;
+    }
+
+    RLibretroConfigEntry *entry = (RLibretroConfigEntry*)MemAlloc(sizeof(RLibretroConfigEntry));
+    if (!entry) return;
+    snprintf(entry->section,  RLCONFIG_SECTION_MAX,  "%s", section);
+    snprintf(entry->key,      RLCONFIG_KEY_MAX,       "%s", key);
+    snprintf(entry->value,    RLCONFIG_VALUE_MAX,     "%s", value);
+    RLibretroConfigCompound(section, key, entry->compound, RLCONFIG_COMPOUND_MAX);
+
+    idx = (int)cvector_size(cfg->entries);
+    cvector_push_back(cfg->entries, entry);
+
+    /* Store pointer into the entry's own compound buffer — stable while the entry is alive. */
+    rlconfiglookup_insert(&cfg->lookup, entry->compound, idx);
+    cfg->dirty = true;
+}
+
+/* True when cfg has changes rlconfig_save() hasn't written yet. */
+static bool rlconfig_is_dirty(const RLibretroConfig *cfg) {
+    return cfg && cfg->dirty;
+}
+
+/* Number of keys in section. */
+static int rlconfig_section_size(const RLibretroConfig *cfg, const char *section) {
+    int count = 0;
+    if (!cfg || !section) return 0;
+    for (size_t i = 0; i < cvector_size(cfg->entries); i++) {
+        if (strcmp(cfg->entries[i]->section, section) == 0) count++;
+    }
+    return count;
+}
+
+static void rlconfig_set_int(RLibretroConfig *cfg, const char *section,
+                              const char *key, int value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%d", value);
+    rlconfig_set(cfg, section, key, buf);
+}
+
+static const char* rlconfig_get(RLibretroConfig *cfg, const char *section,
+                                  const char *key) {
+    char compound[RLCONFIG_COMPOUND_MAX];
+    int idx = -1;
+    if (!cfg || !section || !key) return NULL;
+    RLibretroConfigCompound(section, key, compound, sizeof(compound));
+    if (rlconfiglookup_get(&cfg->lookup, compound, &idx) && idx >= 0)
+        return cfg->entries[idx]->value;
+    return NULL;
+}
+
+static int rlconfig_get_int(RLibretroConfig *cfg, const char *section,
+                             const char *key, int fallback) {
+    const char *v = rlconfig_get(cfg, section, key);
+    if (!v || !v[0]) return fallback;
+    int result = fallback;
+    sscanf(v, "%d", &result);
+    return result;
+}
+
+static void rlconfig_set_float(RLibretroConfig *cfg, const char *section,
+                                const char *key, float value) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%g", value);
+    rlconfig_set(cfg, section, key, buf);
+}
+
+static float rlconfig_get_float(RLibretroConfig *cfg, const char *section,
+                                 const char *key, float fallback) {
+    const char *v = rlconfig_get(cfg, section, key);
+    if (!v || !v[0]) return fallback;
+    float result = fallback;
+    sscanf(v, "%f", &result);
+    return result;
+}
+
+/* Trim leading and trailing ASCII whitespace in-place. */
+static void RLibretroConfigTrim(char *s) {
+    char *start = s;
+    while (*start == ' ' || *start == '\t' || *start == '\r' || *start == '\n')
+        start++;
+    if (start != s) memmove(s, start, strlen(start) + 1);
+    size_t len = strlen(s);
+    while (len > 0 && (s[len-1] == ' ' || s[len-1] == '\t' ||
+                       s[len-1] == '\r' || s[len-1] == '\n')) {
+        s[--len] = '\0';
+    }
+}
+
+/* Parse an INI/.info file into cfg. Lines are "key = value"; [section] headers
+   switch the active section. defaultSection (may be NULL) is the section keys
+   land in before any header — pass the target section for sectionless .info
+   files, NULL for .cfg files where keys must follow a header. Surrounding
+   double quotes are stripped from values (.info style; harmless for .cfg). */
+static void RLibretroConfigParse(RLibretroConfig *cfg, const char *defaultSection, const char *filename) {
+    if (!cfg || !filename) return;
+
+    FILE *f = fopen(filename, "r");
+    if (!f) return;
+
+    char line[RLCONFIG_LINE_MAX];
+    char section[RLCONFIG_SECTION_MAX] = {0};
+    if (defaultSection) snprintf(section, sizeof(section), "%s", defaultSection);
+
+    while (fgets(line, sizeof(line), f)) {
+        RLibretroConfigTrim(line);
+
+        /* Skip blank lines and comments */
+        if (line[0] == '\0' || line[0] == '#' || line[0] == ';') continue;
+
+        /* Section header */
+        if (line[0] == '[') {
+            char *end = strchr(line, ']');
+            if (end) {
+                *end = '\0';
+                size_t secLen = (size_t)(end - (line + 1));
+                if (secLen >= sizeof(section)) secLen = sizeof(section) - 1;
+                memcpy(section, line + 1, secLen);
+                section[secLen] = '\0';
+                RLibretroConfigTrim(section);
+            }
+            continue;
+        }
+
+        /* Key=value */
+        char *eq = strchr(line, '=');
+        if (!eq || section[0] == '\0') continue;
+
+        *eq = '\0';
+        char *k = line;
+        char *v = eq + 1;
+        RLibretroConfigTrim(k);
+        RLibretroConfigTrim(v);
+
+        /* Strip surrounding double quotes from the value */
+        size_t vlen = strlen(v);
+        if (vlen >= 2 && v[0] == '"' && v[vlen - 1] == '"') {
+            v[vlen - 1] = '\0';
+            v++;
+        }
+
+        if (k[0] != '\0') rlconfig_set(cfg, section, k, v);
+    }
+
+    fclose(f);
+}
+
+static RLibretroConfig* rlconfig_load(const char *filename) {
+    RLibretroConfig *cfg = (RLibretroConfig*)MemAlloc(sizeof(RLibretroConfig));
+    if (!cfg) return NULL;
+    memset(cfg, 0, sizeof(RLibretroConfig));
+
+    RLibretroConfigParse(cfg, NULL, filename);
+    cfg->dirty = false;
+    return cfg;
+}
+
+static void rlconfig_load_info(RLibretroConfig *cfg, const char *section, const char *filename) {
+    if (!section) return;
+    RLibretroConfigParse(cfg, section, filename);
+}
+
+/* Write cfg to filename, grouped by section in first-seen order. Does nothing
+   when cfg is unchanged since it was loaded or last saved. Writes a temp file
+   and renames it into place, so a crash mid-write leaves the old file intact. */
+static bool rlconfig_save(RLibretroConfig *cfg, const char *filename) {
+    if (!cfg || !filename) return false;
+    if (!cfg->dirty) return true;
+
+    /* Chain each section's entries in one pass: a section → slot map, with
+       first/last entry per slot and a next-entry link per entry. */
+    size_t count = cvector_size(cfg->entries);
+    int *next = count > 0 ? (int*)MemAlloc((unsigned int)(count * sizeof(int))) : NULL;
+    if (count > 0 && !next) return false;
+    cvector(int) firsts = NULL;
+    cvector(int) lasts = NULL;
+    RLibretroConfigLookup sections;
+    memset(&sections, 0, sizeof(sections));
+    for (size_t i = 0; i < count; i++) {
+        int slot = -1;
+        next[i] = -1;
+        if (rlconfiglookup_get(&sections, cfg->entries[i]->section, &slot) && slot >= 0) {
+            next[lasts[slot]] = (int)i;
+            lasts[slot] = (int)i;
+        } else {
+            /* Keyed by the entry's own section buffer — stable while cfg is. */
+            rlconfiglookup_insert(&sections, cfg->entries[i]->section, (int)cvector_size(firsts));
+            cvector_push_back(firsts, (int)i);
+            cvector_push_back(lasts, (int)i);
+        }
+    }
+
+    char tempPath[4096];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", filename);
+    FILE *f = fopen(tempPath, "w");
+    bool ok = f != NULL;
+    for (size_t s = 0; ok && s < cvector_size(firsts); s++) {
+        fprintf(f, "[%s]\n", cfg->entries[firsts[s]]->section);
+        for (int i = firsts[s]; i >= 0; i = next[i]) {
+            fprintf(f, "%s=%s\n", cfg->entries[i]->key, cfg->entries[i]->value);
+        }
+        fprintf(f, "\n");
+    }
+    if (f) {
+        ok = !ferror(f) && ok;
+        ok = fclose(f) == 0 && ok;
+    }
+
+    rlconfiglookup_free(&sections);
+    cvector_free(firsts);
+    cvector_free(lasts);
+    MemFree(next);
+
+    if (ok) {
+        remove(filename);  /* rename() won't replace an existing file on Windows. */
+        ok = rename(tempPath, filename) == 0;
+    }
+    if (!ok) {
+        remove(tempPath);
+        return false;
+    }
+    cfg->dirty = false;
+    return true;
+}
+
+#endif /* RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION_ONCE */
+#endif /* RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION */
+
+#endif /* RAYLIB_LIBRETRO_CONFIG_OLD_H */
@@ -0,0 +1,356 @@
+/**********************************************************************************************
+*
+*   test_config - Compare raylib-libretro-config's parser with the one it replaced.
+*
+*   rlconfig_load() and rlconfig_load_info() terminate keys and values inside the mapped (or
+*   read) file. This writes fixtures for the cases that treats specially, loads each with both
+*   parsers, and compares every section, key and value, in order: a last value flush with the
+*   end of a mapped file, which is the one that gets copied; a last line with no newline; keys,
+*   values and section names over the size limits; and duplicate keys.
+*
+*   Given a directory of .info files, such as vendor/libretro-core-info, it compares each of
+*   those as well, and times loading them all with both parsers.
+*
+*   Built twice: test_config maps files, test_config_read defines RLCONFIG_NO_MMAP and reads
+*   them. Exits with 0 when the parsers agree.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION
+#include "raylib-libretro-config.h"
+
+#include <stdlib.h>
+#include <features/features_cpu.h> // cpu_features_get_time_usec()
+
+// The parser the current one replaced, implemented in test_config_old.c.
+void* OldConfigLoad(const char* filename);
+void OldConfigLoadInfo(void* cfg, const char* section, const char* filename);
+const char* OldConfigGet(void* cfg, const char* section, const char* key);
+int OldConfigCount(void* cfg);
+void OldConfigEntry(void* cfg, int index, const char** section, const char** key, const char** value);
+void OldConfigFree(void* cfg);
+
+// Passes over the .info files when timing them, unless --passes is given.
+#define TEST_CONFIG_DEFAULT_PASSES 10
+
+// Section .info files are loaded into, as the core scan does.
+#define TEST_CONFIG_INFO_SECTION "core"
+
+// A fixture's contents, built up before it's written.
+typedef struct {
+    char data[8192];
+    size_t length;
+} TestConfigFixture;
+
+static void FixtureAppend(TestConfigFixture* fixture, const char* text) {
+    size_t length = strlen(text);
+    if (fixture->length + length >= sizeof(fixture->data)) return;
+    memcpy(fixture->data + fixture->length, text, length);
+    fixture->length += length;
+}
+
+static void FixtureRepeat(TestConfigFixture* fixture, char c, int count) {
+    for (int i = 0; i < count && fixture->length + 1 < sizeof(fixture->data); i++) {
+        fixture->data[fixture->length++] = c;
+    }
+}
+
+static bool FixtureWrite(const char* fileName, const TestConfigFixture* fixture) {
+    FILE* file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+    bool ok = fwrite(fixture->data, 1, fixture->length, file) == fixture->length;
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * Load the files with both parsers and report every difference. With a
+ * section, each file is added with rlconfig_load_info(); without one, the
+ * first is loaded with rlconfig_load().
+ *
+ * @return True when both parsers gave the same entries in the same order.
+ */
+static bool CompareParsers(const char* name, const char** fileNames, int fileCount, const char* infoSection) {
+    void* old;
+    RLibretroConfig* cfg;
+    if (infoSection != NULL) {
+        old = OldConfigLoad(NULL);
+        cfg = rlconfig_load(NULL);
+        for (int i = 0; i < fileCount; i++) {
+            OldConfigLoadInfo(old, infoSection, fileNames[i]);
+            rlconfig_load_info(cfg, infoSection, fileNames[i]);
+        }
+    } else {
+        old = OldConfigLoad(fileNames[0]);
+        cfg = rlconfig_load(fileNames[0]);
+    }
+    if (old == NULL || cfg == NULL) {
+        printf("FAIL %s: could not load\n", name);
+        OldConfigFree(old);
+        rlconfig_free(cfg);
+        return false;
+    }
+
+    bool same = true;
+    int count = OldConfigCount(old);
+    if (count != (int)cvector_size(cfg->entries)) {
+        printf("FAIL %s: %d entries, expected %d\n", name, (int)cvector_size(cfg->entries), count);
+        same = false;
+    }
+    for (int i = 0; i < count; i++) {
+        const char* section;
+        const char* key;
+        const char* value;
+        OldConfigEntry(old, i, &section, &key, &value);
+
+        const char* got = rlconfig_get(cfg, section, key);
+        if (got == NULL || strcmp(got, value) != 0) {
+            printf("FAIL %s: [%.40s] %.40s = \"%.40s\", expected \"%.40s\"\n", name, section, key,
+                (got != NULL) ? got : "(missing)", value);
+            same = false;
+            continue;
+        }
+        if (i >= (int)cvector_size(cfg->entries)) continue;
+
+        const RLibretroConfigEntry* entry = &cfg->entries[i];
+        const RLibretroConfigSection* entrySection = &cfg->sections[entry->section];
+        if (strcmp(entrySection->name, section) != 0 || strcmp(entry->key, key) != 0) {
+            printf("FAIL %s: entry %d is [%.40s] %.40s, expected [%.40s] %.40s\n", name, i,
+                entrySection->name, entry->key, section, key);
+            same = false;
+        } else if (strlen(entrySection->name) != entrySection->length || strlen(entry->key) != entry->keyLength ||
+                strlen(entry->value) != entry->valueLength) {
+            printf("FAIL %s: [%.40s] %.40s has lengths that don't match its strings\n", name, section, key);
+            same = false;
+        }
+    }
+
+    OldConfigFree(old);
+    rlconfig_free(cfg);
+    return same;
+}
+
+// Write a fixture, compare the parsers on it, and remove it.
+static bool CheckFixture(const char* fileName, const TestConfigFixture* fixture, const char* infoSection) {
+    if (!FixtureWrite(fileName, fixture)) {
+        printf("FAIL %s: could not write the fixture\n", fileName);
+        return false;
+    }
+    bool same = CompareParsers(fileName, &fileName, 1, infoSection);
+    remove(fileName);
+    printf("%s %s\n", same ? "ok  " : "FAIL", fileName);
+    return same;
+}
+
+static bool CheckText(const char* fileName, const char* text, const char* infoSection) {
+    TestConfigFixture fixture = { 0 };
+    FixtureAppend(&fixture, text);
+    return CheckFixture(fileName, &fixture, infoSection);
+}
+
+/**
+ * Keys that are only the same once truncated. The old parser kept both,
+ * under the same truncated name, and read neither back, so this checks the
+ * current one on its own: they're one key, and the last value wins.
+ */
+static bool CheckTruncatedDuplicates(void) {
+    const char* fileName = "truncated-dupes.cfg";
+    TestConfigFixture fixture = { 0 };
+    FixtureAppend(&fixture, "[s]\n");
+    FixtureRepeat(&fixture, 'd', RLCONFIG_KEY_MAX - 1);
+    FixtureAppend(&fixture, "x = first\n");
+    FixtureRepeat(&fixture, 'd', RLCONFIG_KEY_MAX - 1);
+    FixtureAppend(&fixture, "y = second\n");
+    bool same = false;
+    if (FixtureWrite(fileName, &fixture)) {
+        char key[RLCONFIG_KEY_MAX];
+        memset(key, 'd', sizeof(key) - 1);
+        key[sizeof(key) - 1] = '\0';
+        RLibretroConfig* cfg = rlconfig_load(fileName);
+        const char* value = rlconfig_get(cfg, "s", key);
+        same = rlconfig_section_size(cfg, "s") == 1 && value != NULL && strcmp(value, "second") == 0;
+        rlconfig_free(cfg);
+    }
+    remove(fileName);
+    printf("%s %s\n", same ? "ok  " : "FAIL", fileName);
+    return same;
+}
+
+/**
+ * The fixtures. Lines stay under the old parser's line buffer; longer ones
+ * it split in two, which isn't behaviour worth keeping.
+ *
+ * @return The number of fixtures the parsers disagree on.
+ */
+static int CheckFixtures(void) {
+    int failures = 0;
+    TestConfigFixture fixture;
+
+    // Last values flush with the end of the file.
+    failures += !CheckText("eof.cfg", "[core]\nname = \"Test\"\nlast = value at eof", NULL);
+    failures += !CheckText("eof.info", "display_name = \"Core\"\nsupported_extensions = \"bin|cue\"", TEST_CONFIG_INFO_SECTION);
+    failures += !CheckText("eof-space.cfg", "[s]\nk = v \t ", NULL);
+    failures += !CheckText("eof-comment.cfg", "[s]\nk = v\n# no newline", NULL);
+    failures += !CheckText("eof-section.cfg", "[s]\nk = v\n[last]", NULL);
+
+    // A last value that ends on a page boundary, where a mapping has no
+    // byte after it to terminate it with.
+    memset(&fixture, 0, sizeof(fixture));
+    FixtureAppend(&fixture, "[s]\n#");
+    FixtureRepeat(&fixture, 'c', 4096 - 4 - 1 - 1 - 6);
+    FixtureAppend(&fixture, "\nk=vvvv");
+    failures += !CheckFixture("page.cfg", &fixture, NULL);
+
+    // Line endings, comments, blank lines and spacing.
+    failures += !CheckText("crlf.cfg",
+        "[a]\r\nk1 = 1\r\nk2=\"two\"\r\n; comment\r\n# comment\r\n\r\n[ b ]\r\nk = x\r\n  indented = yes  \r\n", NULL);
+
+    // Section names, keys and values over RLCONFIG_SECTION_MAX,
+    // RLCONFIG_KEY_MAX and RLCONFIG_VALUE_MAX, and just under them.
+    memset(&fixture, 0, sizeof(fixture));
+    FixtureAppend(&fixture, "[");
+    FixtureRepeat(&fixture, 'S', RLCONFIG_SECTION_MAX + 16);
+    FixtureAppend(&fixture, "]\n");
+    FixtureRepeat(&fixture, 'k', RLCONFIG_KEY_MAX + 44);
+    FixtureAppend(&fixture, " = long key\n");
+    FixtureRepeat(&fixture, 'j', RLCONFIG_KEY_MAX - 1);
+    FixtureAppend(&fixture, " = longest key\n");
+    FixtureRepeat(&fixture, 'i', RLCONFIG_KEY_MAX);
+    FixtureAppend(&fixture, " = one over\n");
+    FixtureAppend(&fixture, "value = ");
+    FixtureRepeat(&fixture, 'v', RLCONFIG_VALUE_MAX + 88);
+    FixtureAppend(&fixture, "\nquoted = \"");
+    FixtureRepeat(&fixture, 'q', RLCONFIG_VALUE_MAX + 88);
+    FixtureAppend(&fixture, "\"\nlongest = ");
+    FixtureRepeat(&fixture, 'e', RLCONFIG_VALUE_MAX - 1);
+    FixtureAppend(&fixture, "\nover = ");
+    FixtureRepeat(&fixture, 'o', RLCONFIG_VALUE_MAX);
+    FixtureAppend(&fixture, "\neof = ");
+    FixtureRepeat(&fixture, 'z', RLCONFIG_VALUE_MAX + 88);
+    failures += !CheckFixture("long.cfg", &fixture, NULL);
+
+    // Duplicate keys: the last value wins, where the key was first set.
+    failures += !CheckText("dupes.cfg", "[a]\nk = 1\nj = 2\n[b]\nk = 3\n[a]\nk = 4\nk = \"5\"\n[b]\nj = 6", NULL);
+    failures += !CheckTruncatedDuplicates();
+
+    // Lines that aren't keys, or keys outside a section.
+    failures += !CheckText("sections.cfg",
+        "orphan = 1\n[]\nempty = 2\n[unterminated\nstill = 3\n[x] trailing\nk = a=b\n=novalue\nnovalue\n"
+        "quote = \"\nempty_quotes = \"\"\n", NULL);
+    failures += !CheckText("empty.cfg", "", NULL);
+
+    // Two .info files into one section, the second replacing a value the
+    // first left in its mapping.
+    const char* infoFiles[] = { "a.info", "b.info" };
+    memset(&fixture, 0, sizeof(fixture));
+    FixtureAppend(&fixture, "display_name = \"A\"\ncorename = \"a\"");
+    bool written = FixtureWrite(infoFiles[0], &fixture);
+    memset(&fixture, 0, sizeof(fixture));
+    FixtureAppend(&fixture, "corename = \"b\"\nlicense = \"GPLv3\"\n");
+    written = FixtureWrite(infoFiles[1], &fixture) && written;
+    bool same = written && CompareParsers("a.info + b.info", infoFiles, 2, TEST_CONFIG_INFO_SECTION);
+    remove(infoFiles[0]);
+    remove(infoFiles[1]);
+    printf("%s a.info + b.info\n", same ? "ok  " : "FAIL");
+    failures += !same;
+
+    return failures;
+}
+
+/**
+ * Compare the parsers on every .info file in the directory, then time
+ * loading all of them with each, the way the core scan does.
+ *
+ * @return The number of files the parsers disagree on.
+ */
+static int CheckCoreInfo(const char* directory, int passes) {
+    if (!DirectoryExists(directory)) {
+        printf("skip core info: %s not found\n", directory);
+        return 0;
+    }
+    FilePathList files = LoadDirectoryFilesEx(directory, ".info", false);
+    if (files.count == 0) {
+        printf("skip core info: no .info files in %s\n", directory);
+        UnloadDirectoryFiles(files);
+        return 0;
+    }
+
+    int failures = 0;
+    for (unsigned int i = 0; i < files.count; i++) {
+        const char* fileName = files.paths[i];
+        failures += !CompareParsers(GetFileName(fileName), &fileName, 1, TEST_CONFIG_INFO_SECTION);
+    }
+    printf("%s %u core info files\n", (failures == 0) ? "ok  " : "FAIL", files.count);
+
+    retro_time_t start = cpu_features_get_time_usec();
+    for (int pass = 0; pass < passes; pass++) {
+        for (unsigned int i = 0; i < files.count; i++) {
+            void* old = OldConfigLoad(NULL);
+            OldConfigLoadInfo(old, TEST_CONFIG_INFO_SECTION, files.paths[i]);
+            OldConfigGet(old, TEST_CONFIG_INFO_SECTION, "display_name");
+            OldConfigFree(old);
+        }
+    }
+    retro_time_t oldTime = cpu_features_get_time_usec() - start;
+
+    start = cpu_features_get_time_usec();
+    for (int pass = 0; pass < passes; pass++) {
+        for (unsigned int i = 0; i < files.count; i++) {
+            RLibretroConfig* cfg = rlconfig_load(NULL);
+            rlconfig_load_info(cfg, TEST_CONFIG_INFO_SECTION, files.paths[i]);
+            rlconfig_get(cfg, TEST_CONFIG_INFO_SECTION, "display_name");
+            rlconfig_free(cfg);
+        }
+    }
+    retro_time_t newTime = cpu_features_get_time_usec() - start;
+
+    double loads = (double)files.count * passes;
+    printf("Loading %u core info files %d times:\n", files.count, passes);
+    printf("  %-22s %10.3f ms %8.2f us per file\n", "before (fgets)", (double)oldTime / 1000.0, (double)oldTime / loads);
+    printf("  %-22s %10.3f ms %8.2f us per file\n",
+#ifdef RLCONFIG_MMAP
+        "after (mapped)",
+#else
+        "after (read)",
+#endif
+        (double)newTime / 1000.0, (double)newTime / loads);
+
+    UnloadDirectoryFiles(files);
+    return failures;
+}
+
+int main(int argc, char* argv[]) {
+    const char* coreInfo = NULL;
+    int passes = TEST_CONFIG_DEFAULT_PASSES;
+    for (int i = 1; i < argc; i++) {
+        if (TextIsEqual(argv[i], "-h") || TextIsEqual(argv[i], "--help")) {
+            printf("Usage: %s [--passes <count>] [<core info directory>]\n\n", argv[0]);
+            printf("Compares the config parser with the one it replaced on fixtures written to the\n");
+            printf("current directory, and on the .info files in the given directory, which it then\n");
+            printf("times loading with both.\n\n");
+            printf("Options:\n");
+            printf("  --passes <count>  Times to load every .info file (default: %d)\n", TEST_CONFIG_DEFAULT_PASSES);
+            return 0;
+        } else if (TextIsEqual(argv[i], "--passes") && i + 1 < argc) {
+            passes = atoi(argv[++i]);
+        } else {
+            coreInfo = argv[i];
+        }
+    }
+    if (passes < 1) passes = 1;
+    SetTraceLogLevel(LOG_WARNING);
+
+    int failures = CheckFixtures();
+    if (coreInfo != NULL) {
+        failures += CheckCoreInfo(coreInfo, passes);
+    }
+
+    if (failures > 0) {
+        printf("%d failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
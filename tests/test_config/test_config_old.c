@@ -0,0 +1,43 @@
+/**********************************************************************************************
+*
+*   test_config_old - The config parser raylib-libretro-config.h replaced, for test_config.
+*
+*   Its types and functions share names with the current header, so it's compiled on its own
+*   and only reached through the OldConfig* functions below.
+*
+*   LICENSE: GPL-3.0-or-later
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYLIB_LIBRETRO_CONFIG_IMPLEMENTATION
+#include "raylib-libretro-config-old.h"
+
+void* OldConfigLoad(const char* filename) {
+    return rlconfig_load(filename);
+}
+
+void OldConfigLoadInfo(void* cfg, const char* section, const char* filename) {
+    rlconfig_load_info((RLibretroConfig*)cfg, section, filename);
+}
+
+const char* OldConfigGet(void* cfg, const char* section, const char* key) {
+    return rlconfig_get((RLibretroConfig*)cfg, section, key);
+}
+
+int OldConfigCount(void* cfg) {
+    return (int)cvector_size(((RLibretroConfig*)cfg)->entries);
+}
+
+// Entries are in the order their keys were first set.
+void OldConfigEntry(void* cfg, int index, const char** section, const char** key, const char** value) {
+    RLibretroConfigEntry* entry = ((RLibretroConfig*)cfg)->entries[index];
+    *section = entry->section;
+    *key = entry->key;
+    *value = entry->value;
+}
+
+void OldConfigFree(void* cfg) {
+    rlconfig_free((RLibretroConfig*)cfg);
+}